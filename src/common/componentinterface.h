@@ -1,7 +1,9 @@
 #ifndef __COMPONENTINTERFACE_H
 #define __COMPONENTINTERFACE_H
 
+#include <QtCore/QByteArray>
 #include <QtCore/QJsonObject>
+#include <QtCore/QString>
 #include <functional>
 
 class QWidget;
@@ -36,6 +38,43 @@ struct ComponentInterface {
     */
     virtual QJsonObject getConfig() const = 0;
 
+    /**
+    *   @brief  Checks if component has bulk data (e.g. captured frames). Data is stored outside of configuration.
+    *   @return true if component has data to be saved with saveData
+    */
+    virtual bool hasData() const
+    {
+        return false;
+    }
+
+    /**
+    *   @brief  Writes bulk data to a file referenced by the project. Component may only append to a file it has
+    *           written or loaded before, so cost of saving does not need to depend on size of data.
+    *   @param  fileName path to data file
+    *   @return true on success, false on failure
+    */
+    virtual bool saveData(const QString&)
+    {
+        return false;
+    }
+
+    /**
+    *   @brief  Sets data file previously written by saveData. Component reads it only when data is needed.
+    *   @param  fileName path to data file
+    */
+    virtual void setDataFile(const QString&)
+    {
+    }
+
+    /**
+    *   @brief  Sets loader of data embedded in projects saved by older versions. Component calls it only when data
+    *           is needed.
+    *   @param  loader function returning data
+    */
+    virtual void setDataLoader(const std::function<QByteArray()>&)
+    {
+    }
+
     /**
     *   @brief  Gets components's main widget
     *   @return Main widget or nullptr if component doesn't have it
@@ -45,6 +84,15 @@ struct ComponentInterface {
         return nullptr;
     }
 
+    /**
+    *   @brief  Checks if main widget has been already constructed. Main widgets are constructed on first use.
+    *   @return true if main widget exists, false otherwise
+    */
+    virtual bool mainWidgetCreated() const
+    {
+        return false;
+    }
+
     /**
     *   @brief  Callback, called when component requests dock/undock action
     */
@@ -33,17 +33,18 @@ public:
     /**
     *   @brief  Used to get frame
     */
-    QCanBusFrame frame() const
+    const QCanBusFrame& frame() const
     {
         return _frame;
     };
 
 private:
-    QCanBusFrame _frame;
+    const QCanBusFrame _frame;
 };
 
 /**
-*   @brief The class describing data model used as output for CanDevice node
+*   @brief The class describing data model used as output for CanDevice node. Object is immutable, so one instance is
+*          shared by all consumers connected to the port.
 */
 class CanDeviceDataOut : public NodeData {
 public:
@@ -66,7 +67,7 @@ public:
     /**
     *   @brief  Used to get frame
     */
-    QCanBusFrame frame() const
+    const QCanBusFrame& frame() const
     {
         return _frame;
     };
@@ -88,9 +89,9 @@ public:
     };
 
 private:
-    QCanBusFrame _frame;
-    Direction _direction;
-    bool _status; // used only for frameSent, ignored for frameReceived
+    const QCanBusFrame _frame;
+    const Direction _direction{ Direction::RX };
+    const bool _status{ false }; // used only for frameSent, ignored for frameReceived
 };
 
 #endif /* !__CANDEVICEDATA_H */
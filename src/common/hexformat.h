@@ -0,0 +1,138 @@
+#ifndef HEXFORMAT_H
+#define HEXFORMAT_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+#include <cstring>
+
+/**
+*   @brief Hex formatting of IDs and payloads.
+*
+*   Bytes are converted with a 256 entry table of digit pairs and written directly to a buffer provided by caller, so
+*   formatting a payload is a single pass without temporary strings.
+*/
+namespace HexFormat {
+
+// Digit pairs of all byte values, lower and upper case
+inline const char* byteDigits(bool upper = false)
+{
+    static const char lower[] =
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+        "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+        "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+        "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+        "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+        "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+        "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+        "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+    static const char upperCase[] =
+        "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+        "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+        "404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+        "606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+        "808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+        "A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+        "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+        "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+    return upper ? upperCase : lower;
+}
+
+/**
+*   @brief  Gets size of formatted payload
+*   @param  length payload length
+*   @param  separator true if bytes are separated
+*   @return number of characters
+*/
+inline int bytesSize(int length, bool separator)
+{
+    return (length > 0) ? (separator ? 3 * length - 1 : 2 * length) : 0;
+}
+
+/**
+*   @brief  Writes payload as hex digits
+*   @param  out output buffer of at least bytesSize(length, separator != 0) characters
+*   @param  data payload bytes
+*   @param  length payload length
+*   @param  separator character put between bytes, 0 for none
+*   @param  upper true for upper case digits
+*   @return pointer past the last written character
+*/
+inline char* writeBytes(char* out, const char* data, int length, char separator = ' ', bool upper = false)
+{
+    const char* digits = byteDigits(upper);
+
+    for (int i = 0; i < length; ++i) {
+        if (separator && (i > 0)) {
+            *out++ = separator;
+        }
+
+        std::memcpy(out, digits + 2 * static_cast<quint8>(data[i]), 2);
+        out += 2;
+    }
+
+    return out;
+}
+
+/**
+*   @brief  Writes value as fixed number of hex digits
+*   @param  out output buffer of at least digits characters
+*   @param  value value
+*   @param  digits number of digits, higher digits of value are dropped
+*   @param  upper true for upper case digits
+*   @return pointer past the last written character
+*/
+inline char* writeHex(char* out, quint32 value, int digits, bool upper = false)
+{
+    const char* table = byteDigits(upper);
+
+    for (int i = digits - 1; i >= 0; --i) {
+        // Odd entries of the table hold low nibble digits
+        out[i] = table[2 * (value & 0xf) + 1];
+        value >>= 4;
+    }
+
+    return out + digits;
+}
+
+/**
+*   @brief  Formats payload as hex digits separated with spaces, e.g. "00 11 ff"
+*   @param  data payload bytes
+*   @param  length payload length
+*   @return formatted payload
+*/
+inline QString bytesToString(const char* data, int length)
+{
+    // Enough for CAN FD payload
+    char buffer[3 * 64];
+
+    if (length > 64) {
+        QByteArray text(bytesSize(length, true), Qt::Uninitialized);
+        writeBytes(text.data(), data, length);
+        return QString::fromLatin1(text);
+    }
+
+    return QString::fromLatin1(buffer, static_cast<int>(writeBytes(buffer, data, length) - buffer));
+}
+
+/**
+*   @brief  Formats ID as hex number with 0x prefix and no leading zeros, e.g. "0x1ab"
+*   @param  id frame ID
+*   @return formatted ID
+*/
+inline QString idToString(quint32 id)
+{
+    char buffer[10] = { '0', 'x' };
+    int digits = 1;
+
+    while ((digits < 8) && (id >> (4 * digits))) {
+        ++digits;
+    }
+
+    return QString::fromLatin1(buffer, static_cast<int>(writeHex(buffer + 2, id, digits) - buffer));
+}
+
+} // namespace HexFormat
+
+#endif // HEXFORMAT_H
@@ -13,6 +13,11 @@
 class CanRawViewModel;
 class CanRawSenderModel;
 class CanDeviceModel;
+class CanFilterModel;
+class CanGatewayModel;
+class CanRecorderModel;
+class CanExpressionModel;
+class CanMonitorModel;
 
 /**
  * Example usage with @c VisitableWith<CanNodeDataModelVisitor>:
@@ -36,6 +41,11 @@ struct CanNodeDataModelVisitor
       , CanRawViewModel
       , CanRawSenderModel
       , CanDeviceModel
+      , CanFilterModel
+      , CanGatewayModel
+      , CanRecorderModel
+      , CanExpressionModel
+      , CanMonitorModel
 //    , Other
       >
 {
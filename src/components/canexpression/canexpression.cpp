@@ -0,0 +1,70 @@
+#include "canexpression.h"
+#include "canexpression_p.h"
+#include <QtSerialBus/QCanBusFrame>
+#include <algorithm>
+
+CanExpression::CanExpression()
+    : d_ptr(new CanExpressionPrivate(this))
+{
+}
+
+CanExpression::~CanExpression()
+{
+}
+
+bool CanExpression::evaluate(const QCanBusFrame& frame, bool tx)
+{
+    Q_D(CanExpression);
+
+    // Reading the clock costs more than a small program, so only some evaluations are timed
+    if (d->_evaluations++ % CanExpressionPrivate::kSampleInterval != 0) {
+        return d->_expression.evaluate(frame, tx);
+    }
+
+    const qint64 start = d->_clock.nsecsElapsed();
+    const bool result = d->_expression.evaluate(frame, tx);
+
+    d->_costNs += std::max(d->_clock.nsecsElapsed() - start - d->_clockNs, qint64(0));
+    ++d->_samples;
+
+    return result;
+}
+
+quint64 CanExpression::evaluationCount() const
+{
+    Q_D(const CanExpression);
+
+    return d->_evaluations;
+}
+
+qint64 CanExpression::averageCostNs() const
+{
+    Q_D(const CanExpression);
+
+    return (d->_samples > 0) ? d->_costNs / static_cast<qint64>(d->_samples) : 0;
+}
+
+void CanExpression::setConfig(QJsonObject& json)
+{
+    Q_D(CanExpression);
+
+    d->setConfig(json);
+}
+
+QJsonObject CanExpression::getConfig() const
+{
+    Q_D(const CanExpression);
+
+    return d->getConfig();
+}
+
+void CanExpression::stopSimulation()
+{
+}
+
+void CanExpression::startSimulation()
+{
+    Q_D(CanExpression);
+
+    d->resetStats();
+}
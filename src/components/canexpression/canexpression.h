@@ -0,0 +1,62 @@
+#ifndef CANEXPRESSION_H
+#define CANEXPRESSION_H
+
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <componentinterface.h>
+
+class QCanBusFrame;
+class CanExpressionPrivate;
+
+/**
+*   @brief The class provides component passing frames that meet a condition. Condition is compiled once when set.
+*          Component doesn't have main widget, it is configured via node properties.
+*   @see Expression for condition syntax
+*/
+class CanExpression : public QObject, public ComponentInterface {
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(CanExpression)
+
+public:
+    CanExpression();
+    ~CanExpression();
+
+    /**
+    *   @brief  Evaluates condition for a frame
+    *   @param  frame frame to be checked
+    *   @param  tx true if frame was transmitted
+    *   @return true if frame meets the condition
+    */
+    bool evaluate(const QCanBusFrame& frame, bool tx);
+
+    /**
+    *   @brief  Gets number of evaluations since last configuration change
+    *   @return number of evaluations
+    */
+    quint64 evaluationCount() const;
+
+    /**
+    *   @brief  Gets average evaluation time, measured on every 256th evaluation
+    *   @return time in nanoseconds
+    */
+    qint64 averageCostNs() const;
+
+    /**
+    *   @see ComponentInterface
+    */
+    void setConfig(QJsonObject& json) override;
+
+    /**
+    *   @see ComponentInterface
+    */
+    QJsonObject getConfig() const override;
+
+public slots:
+    void stopSimulation();
+    void startSimulation();
+
+private:
+    QScopedPointer<CanExpressionPrivate> d_ptr;
+};
+
+#endif // CANEXPRESSION_H
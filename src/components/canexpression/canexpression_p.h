@@ -0,0 +1,68 @@
+#ifndef CANEXPRESSION_P_H
+#define CANEXPRESSION_P_H
+
+#include "canexpression.h"
+#include "expression.h"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <algorithm>
+#include <limits>
+#include <log.h>
+
+class CanExpressionPrivate {
+    Q_DECLARE_PUBLIC(CanExpression)
+
+public:
+    CanExpressionPrivate(CanExpression* q)
+        : q_ptr(q)
+    {
+        _clock.start();
+        resetStats();
+    }
+
+    void setConfig(const QJsonObject& json)
+    {
+        if (json.contains("expression")) {
+            QString error;
+
+            if (_expression.compile(json["expression"].toString(), &error)) {
+                resetStats();
+            } else {
+                cds_warn("Incorrect expression '{}': {}", json["expression"].toString().toStdString(),
+                    error.toStdString());
+            }
+        }
+    }
+
+    QJsonObject getConfig() const
+    {
+        return { { "expression", _expression.source() } };
+    }
+
+    void resetStats()
+    {
+        _evaluations = 0;
+        _samples = 0;
+        _costNs = 0;
+        _clockNs = std::numeric_limits<qint64>::max();
+
+        // Cost of reading the clock is subtracted from timed evaluations
+        for (int i = 0; i < 16; ++i) {
+            const qint64 start = _clock.nsecsElapsed();
+            _clockNs = std::min(_clockNs, _clock.nsecsElapsed() - start);
+        }
+    }
+
+    static constexpr quint64 kSampleInterval = 256;
+    Expression _expression;
+    QElapsedTimer _clock;
+    quint64 _evaluations{ 0 };
+    quint64 _samples{ 0 }; // timed evaluations
+    qint64 _costNs{ 0 };
+    qint64 _clockNs{ 0 };
+
+private:
+    CanExpression* q_ptr;
+};
+
+#endif // CANEXPRESSION_P_H
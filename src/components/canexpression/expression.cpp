@@ -0,0 +1,475 @@
+#include "expression.h"
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringList>
+#include <QtSerialBus/QCanBusFrame>
+#include <algorithm>
+#include <array>
+
+namespace {
+// Nesting of parentheses and unary operators. Deeper input is rejected instead of overflowing the parser stack.
+const int kMaxNesting = 100;
+
+struct Token {
+    enum class Type { End, Number, Name, Operator };
+
+    Type type;
+    QString text;
+    qint64 value;
+};
+
+/**
+*   Recursive descent parser emitting bytecode while parsing
+*/
+class Compiler {
+public:
+    Compiler(const QString& source)
+        : _source(source)
+    {
+        next();
+    }
+
+    bool compile(std::vector<Expression::Instruction>& program, bool& usesPayload, QString& error)
+    {
+        parseOr();
+
+        if (_error.isEmpty() && (_token.type != Token::Type::End)) {
+            fail("Unexpected '" + _token.text + "'");
+        }
+
+        if (_error.isEmpty() && (_maxDepth > Expression::kMaxStackDepth)) {
+            fail("Expression too complex");
+        }
+
+        error = _error;
+        program = std::move(_program);
+        usesPayload = _usesPayload;
+
+        return _error.isEmpty();
+    }
+
+private:
+    using Op = Expression::Op;
+
+    void next()
+    {
+        static const QStringList operators{ "||", "&&", "==", "!=", "<=", ">=", "<<", ">>", "(", ")", "!", "~", "-",
+            "+", "*", "/", "%", "&", "|", "^", "<", ">" };
+
+        while ((_pos < _source.size()) && _source[_pos].isSpace()) {
+            ++_pos;
+        }
+
+        const int start = _pos;
+
+        if (_pos >= _source.size()) {
+            _token = { Token::Type::End, "end of expression", 0 };
+        } else if (_source[_pos].isDigit()) {
+            while ((_pos < _source.size()) && _source[_pos].isLetterOrNumber()) {
+                ++_pos;
+            }
+
+            bool ok = false;
+            const QString text = _source.mid(start, _pos - start);
+            const qint64 value = text.startsWith("0x", Qt::CaseInsensitive) ? text.mid(2).toLongLong(&ok, 16)
+                                                                           : text.toLongLong(&ok, 10);
+
+            if (!ok) {
+                fail("Incorrect number '" + text + "'");
+            }
+
+            _token = { Token::Type::Number, text, value };
+        } else if (_source[_pos].isLetter() || (_source[_pos] == '_')) {
+            while ((_pos < _source.size()) && (_source[_pos].isLetterOrNumber() || (_source[_pos] == '_'))) {
+                ++_pos;
+            }
+
+            _token = { Token::Type::Name, _source.mid(start, _pos - start).toLower(), 0 };
+        } else {
+            for (const auto& op : operators) {
+                if (_source.midRef(_pos, op.size()) == op) {
+                    _pos += op.size();
+                    _token = { Token::Type::Operator, op, 0 };
+                    return;
+                }
+            }
+
+            fail("Unexpected character '" + QString(_source[_pos]) + "'");
+            _token = { Token::Type::End, _source.mid(_pos, 1), 0 };
+        }
+    }
+
+    bool accept(const QString& op)
+    {
+        if ((_token.type != Token::Type::Number) && (_token.text == op)) {
+            next();
+            return true;
+        }
+
+        return false;
+    }
+
+    void fail(const QString& error)
+    {
+        if (_error.isEmpty()) {
+            _error = error;
+        }
+    }
+
+    // Parses rule one nesting level deeper
+    void parseNested(void (Compiler::*rule)())
+    {
+        if (_nesting >= kMaxNesting) {
+            fail("Expression too complex");
+            return;
+        }
+
+        ++_nesting;
+        (this->*rule)();
+        --_nesting;
+    }
+
+    void emitOp(Op op, qint64 arg = 0)
+    {
+        switch (op) {
+        case Op::Const:
+        case Op::Id:
+        case Op::Len:
+        case Op::Ext:
+        case Op::Rtr:
+        case Op::Tx:
+        case Op::Byte:
+            ++_depth;
+            break;
+        case Op::Not:
+        case Op::Neg:
+        case Op::BitNot:
+        case Op::ToBool:
+            break;
+        default:
+            // Binary operators. Jumps pop the value on fall through path.
+            --_depth;
+        }
+
+        _maxDepth = std::max(_maxDepth, _depth);
+        _program.push_back({ op, arg });
+    }
+
+    // Emits "lhs op rhs" with short circuit evaluation
+    template <typename Operand> void parseLogical(const QString& op, const QString& word, Op jump, Operand operand)
+    {
+        (this->*operand)();
+
+        while (_error.isEmpty() && (accept(op) || accept(word))) {
+            emitOp(Op::ToBool);
+            const std::size_t jumpIdx = _program.size();
+            emitOp(jump);
+            (this->*operand)();
+            emitOp(Op::ToBool);
+            _program[jumpIdx].arg = static_cast<qint64>(_program.size());
+        }
+    }
+
+    void parseOr()
+    {
+        parseLogical("||", "or", Op::JumpIfTrue, &Compiler::parseAnd);
+    }
+
+    void parseAnd()
+    {
+        parseLogical("&&", "and", Op::JumpIfFalse, &Compiler::parseNot);
+    }
+
+    void parseNot()
+    {
+        if (accept("!") || accept("not")) {
+            parseNested(&Compiler::parseNot);
+            emitOp(Op::Not);
+        } else {
+            parseComparison();
+        }
+    }
+
+    void parseComparison()
+    {
+        static const std::array<std::pair<const char*, Op>, 6> comparisons{ { { "==", Op::Eq }, { "!=", Op::Ne },
+            { "<=", Op::Le }, { ">=", Op::Ge }, { "<", Op::Lt }, { ">", Op::Gt } } };
+
+        parseBinary(0);
+
+        for (const auto& cmp : comparisons) {
+            if (accept(cmp.first)) {
+                parseBinary(0);
+                emitOp(cmp.second);
+                return;
+            }
+        }
+    }
+
+    // Binary operators from lowest to highest priority. Operators of the same level are left associative.
+    void parseBinary(std::size_t level)
+    {
+        static const std::vector<std::vector<std::pair<const char*, Op>>> levels{ { { "|", Op::Or } },
+            { { "^", Op::Xor } }, { { "&", Op::And } }, { { "<<", Op::Shl }, { ">>", Op::Shr } },
+            { { "+", Op::Add }, { "-", Op::Sub } }, { { "*", Op::Mul }, { "/", Op::Div }, { "%", Op::Mod } } };
+
+        if (level >= levels.size()) {
+            parseUnary();
+            return;
+        }
+
+        parseBinary(level + 1);
+
+        bool matched = true;
+        while (_error.isEmpty() && matched) {
+            matched = false;
+
+            for (const auto& op : levels[level]) {
+                if (accept(op.first)) {
+                    parseBinary(level + 1);
+                    emitOp(op.second);
+                    matched = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    void parseUnary()
+    {
+        if (accept("-")) {
+            parseNested(&Compiler::parseUnary);
+            emitOp(Op::Neg);
+        } else if (accept("~")) {
+            parseNested(&Compiler::parseUnary);
+            emitOp(Op::BitNot);
+        } else {
+            parsePrimary();
+        }
+    }
+
+    void parsePrimary()
+    {
+        const Token token = _token;
+
+        if (!_error.isEmpty()) {
+            return;
+        }
+
+        if (token.type == Token::Type::Number) {
+            next();
+            emitOp(Op::Const, token.value);
+        } else if (accept("(")) {
+            parseNested(&Compiler::parseOr);
+
+            if (!accept(")")) {
+                fail("Missing ')'");
+            }
+        } else if (token.type == Token::Type::Name) {
+            next();
+            parseField(token.text);
+        } else {
+            fail("Unexpected '" + token.text + "'");
+        }
+    }
+
+    void parseField(const QString& name)
+    {
+        static const QRegularExpression byteRe("^(?:b|byte)(\\d+)$");
+        const auto match = byteRe.match(name);
+
+        if (name == "id") {
+            emitOp(Op::Id);
+        } else if ((name == "len") || (name == "dlc")) {
+            emitOp(Op::Len);
+        } else if (name == "ext") {
+            emitOp(Op::Ext);
+        } else if (name == "rtr") {
+            emitOp(Op::Rtr);
+        } else if (name == "tx") {
+            emitOp(Op::Tx);
+        } else if (name == "rx") {
+            emitOp(Op::Tx);
+            emitOp(Op::Not);
+        } else if (match.hasMatch() && (match.captured(1).toInt() < 64)) {
+            emitOp(Op::Byte, match.captured(1).toInt());
+            _usesPayload = true;
+        } else {
+            fail("Unknown field '" + name + "'");
+        }
+    }
+
+    const QString _source;
+    int _pos{ 0 };
+    Token _token;
+    QString _error;
+    std::vector<Expression::Instruction> _program;
+    bool _usesPayload{ false };
+    int _depth{ 0 };
+    int _maxDepth{ 0 };
+    int _nesting{ 0 };
+};
+}
+
+constexpr int Expression::kMaxStackDepth;
+
+bool Expression::compile(const QString& source, QString* error)
+{
+    std::vector<Instruction> program;
+    bool usesPayload = false;
+    QString compileError;
+
+    if (!source.trimmed().isEmpty() && !Compiler(source).compile(program, usesPayload, compileError)) {
+        if (error) {
+            *error = compileError;
+        }
+
+        return false;
+    }
+
+    _source = source;
+    _program = std::move(program);
+    _usesPayload = usesPayload;
+
+    return true;
+}
+
+QString Expression::source() const
+{
+    return _source;
+}
+
+bool Expression::isEmpty() const
+{
+    return _program.empty();
+}
+
+bool Expression::evaluate(const QCanBusFrame& frame, bool tx) const
+{
+    if (_program.empty()) {
+        return true;
+    }
+
+    std::array<qint64, kMaxStackDepth> stack;
+    int top = -1;
+    const QByteArray payload = _usesPayload ? frame.payload() : QByteArray();
+    const std::size_t size = _program.size();
+
+    for (std::size_t pc = 0; pc < size; ++pc) {
+        const Instruction& ins = _program[pc];
+
+        switch (ins.op) {
+        case Op::Const:
+            stack[++top] = ins.arg;
+            break;
+        case Op::Id:
+            stack[++top] = frame.frameId();
+            break;
+        case Op::Len:
+            stack[++top] = frame.payload().size();
+            break;
+        case Op::Ext:
+            stack[++top] = frame.hasExtendedFrameFormat() ? 1 : 0;
+            break;
+        case Op::Rtr:
+            stack[++top] = (frame.frameType() == QCanBusFrame::RemoteRequestFrame) ? 1 : 0;
+            break;
+        case Op::Tx:
+            stack[++top] = tx ? 1 : 0;
+            break;
+        case Op::Byte:
+            stack[++top] = (ins.arg < payload.size()) ? static_cast<quint8>(payload[static_cast<int>(ins.arg)]) : 0;
+            break;
+        case Op::Not:
+            stack[top] = !stack[top];
+            break;
+        case Op::Neg:
+            stack[top] = static_cast<qint64>(0 - static_cast<quint64>(stack[top]));
+            break;
+        case Op::BitNot:
+            stack[top] = ~stack[top];
+            break;
+        case Op::ToBool:
+            stack[top] = (stack[top] != 0) ? 1 : 0;
+            break;
+        case Op::JumpIfFalse:
+            if (stack[top] == 0) {
+                pc = static_cast<std::size_t>(ins.arg) - 1;
+            } else {
+                --top;
+            }
+            break;
+        case Op::JumpIfTrue:
+            if (stack[top] != 0) {
+                pc = static_cast<std::size_t>(ins.arg) - 1;
+            } else {
+                --top;
+            }
+            break;
+        default: {
+            const qint64 rhs = stack[top--];
+            qint64& lhs = stack[top];
+
+            switch (ins.op) {
+            case Op::Or:
+                lhs |= rhs;
+                break;
+            case Op::Xor:
+                lhs ^= rhs;
+                break;
+            case Op::And:
+                lhs &= rhs;
+                break;
+            case Op::Shl:
+                lhs = ((rhs >= 0) && (rhs < 64)) ? static_cast<qint64>(static_cast<quint64>(lhs) << rhs) : 0;
+                break;
+            case Op::Shr:
+                lhs = ((rhs >= 0) && (rhs < 64)) ? (lhs >> rhs) : 0;
+                break;
+            // Overflow wraps around instead of being undefined
+            case Op::Add:
+                lhs = static_cast<qint64>(static_cast<quint64>(lhs) + static_cast<quint64>(rhs));
+                break;
+            case Op::Sub:
+                lhs = static_cast<qint64>(static_cast<quint64>(lhs) - static_cast<quint64>(rhs));
+                break;
+            case Op::Mul:
+                lhs = static_cast<qint64>(static_cast<quint64>(lhs) * static_cast<quint64>(rhs));
+                break;
+            // Division by zero gives 0, minimum value divided by -1 wraps around instead of trapping
+            case Op::Div:
+                if (rhs == -1) {
+                    lhs = static_cast<qint64>(0 - static_cast<quint64>(lhs));
+                } else {
+                    lhs = (rhs != 0) ? lhs / rhs : 0;
+                }
+                break;
+            case Op::Mod:
+                lhs = ((rhs != 0) && (rhs != -1)) ? lhs % rhs : 0;
+                break;
+            case Op::Eq:
+                lhs = (lhs == rhs);
+                break;
+            case Op::Ne:
+                lhs = (lhs != rhs);
+                break;
+            case Op::Lt:
+                lhs = (lhs < rhs);
+                break;
+            case Op::Le:
+                lhs = (lhs <= rhs);
+                break;
+            case Op::Gt:
+                lhs = (lhs > rhs);
+                break;
+            case Op::Ge:
+                lhs = (lhs >= rhs);
+                break;
+            default:
+                break;
+            }
+        }
+        }
+    }
+
+    return stack[top] != 0;
+}
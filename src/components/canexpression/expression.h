@@ -0,0 +1,97 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <QtCore/QString>
+#include <vector>
+
+class QCanBusFrame;
+
+/**
+*   @brief The class provides condition over frame fields compiled to bytecode.
+*
+*   Expression is parsed once and compiled to a program for a small stack machine, so evaluation doesn't touch
+*   the source text. Values are 64-bit integers, non-zero means true.
+*
+*   Fields:     id, len (alias dlc), ext, rtr, tx, rx, b<N> (alias byte<N>) - payload byte N, 0 if frame is shorter
+*   Literals:   decimal or hexadecimal with 0x prefix
+*   Operators from lowest to highest priority:
+*       or ||,  and &&,  not !,  == != < <= > >=,  |,  ^,  &,  << >>,  + -,  * / %,  unary - ~
+*   Bitwise operators bind tighter than comparisons, so "b2 & 0x0f == 3" means "(b2 & 0x0f) == 3".
+*   Example: "id == 0x123 and b2 & 0x0f == 3"
+*/
+class Expression {
+public:
+    /**
+    *   @brief  Parses and compiles expression
+    *   @param  source expression text
+    *   @param  error receives error description on failure, may be nullptr
+    *   @return true on success. On failure previous program is kept.
+    */
+    bool compile(const QString& source, QString* error = nullptr);
+
+    /**
+    *   @brief  Gets expression text
+    *   @return text passed to compile
+    */
+    QString source() const;
+
+    /**
+    *   @brief  Checks if expression is defined
+    *   @return true if expression is empty
+    */
+    bool isEmpty() const;
+
+    /**
+    *   @brief  Evaluates expression for a frame
+    *   @param  frame frame to be checked
+    *   @param  tx true if frame was transmitted
+    *   @return true if condition is met. Empty expression is always met.
+    */
+    bool evaluate(const QCanBusFrame& frame, bool tx) const;
+
+    enum class Op {
+        Const,
+        Id,
+        Len,
+        Ext,
+        Rtr,
+        Tx,
+        Byte,
+        Not,
+        Neg,
+        BitNot,
+        ToBool,
+        Or,
+        Xor,
+        And,
+        Shl,
+        Shr,
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Mod,
+        Eq,
+        Ne,
+        Lt,
+        Le,
+        Gt,
+        Ge,
+        JumpIfFalse, // jumps keeping value on stack if top is 0, otherwise pops it
+        JumpIfTrue // jumps keeping value on stack if top is not 0, otherwise pops it
+    };
+
+    struct Instruction {
+        Op op;
+        qint64 arg;
+    };
+
+    static constexpr int kMaxStackDepth = 64;
+
+private:
+    QString _source;
+    std::vector<Instruction> _program;
+    bool _usesPayload{ false };
+};
+
+#endif // EXPRESSION_H
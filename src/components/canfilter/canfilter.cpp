@@ -0,0 +1,46 @@
+#include "canfilter.h"
+#include "canfilter_p.h"
+#include <QtSerialBus/QCanBusFrame>
+
+CanFilter::CanFilter()
+    : d_ptr(new CanFilterPrivate(this))
+{
+}
+
+CanFilter::~CanFilter()
+{
+}
+
+bool CanFilter::accepts(const QCanBusFrame& frame) const
+{
+    Q_D(const CanFilter);
+
+    // Filter without rules is transparent
+    if (d->_filter.isEmpty()) {
+        return true;
+    }
+
+    return d->_filter.matches(frame.frameId(), frame.hasExtendedFrameFormat()) != d->_block;
+}
+
+void CanFilter::setConfig(QJsonObject& json)
+{
+    Q_D(CanFilter);
+
+    d->setConfig(json);
+}
+
+QJsonObject CanFilter::getConfig() const
+{
+    Q_D(const CanFilter);
+
+    return d->getConfig();
+}
+
+void CanFilter::stopSimulation()
+{
+}
+
+void CanFilter::startSimulation()
+{
+}
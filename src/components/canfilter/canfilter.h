@@ -0,0 +1,48 @@
+#ifndef CANFILTER_H
+#define CANFILTER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <componentinterface.h>
+
+class QCanBusFrame;
+class CanFilterPrivate;
+
+/**
+*   @brief The class provides component passing or blocking frames by ID. Component doesn't have main widget, it is
+*          configured via node properties.
+*/
+class CanFilter : public QObject, public ComponentInterface {
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(CanFilter)
+
+public:
+    CanFilter();
+    ~CanFilter();
+
+    /**
+    *   @brief  Checks if frame shall be forwarded
+    *   @param  frame frame to be checked
+    *   @return true if frame passes the filter
+    */
+    bool accepts(const QCanBusFrame& frame) const;
+
+    /**
+    *   @see ComponentInterface
+    */
+    void setConfig(QJsonObject& json) override;
+
+    /**
+    *   @see ComponentInterface
+    */
+    QJsonObject getConfig() const override;
+
+public slots:
+    void stopSimulation();
+    void startSimulation();
+
+private:
+    QScopedPointer<CanFilterPrivate> d_ptr;
+};
+
+#endif // CANFILTER_H
@@ -0,0 +1,40 @@
+#ifndef CANFILTER_P_H
+#define CANFILTER_P_H
+
+#include "canfilter.h"
+#include "idfilter.h"
+#include <QtCore/QJsonObject>
+
+class CanFilterPrivate {
+    Q_DECLARE_PUBLIC(CanFilter)
+
+public:
+    CanFilterPrivate(CanFilter* q)
+        : q_ptr(q)
+    {
+    }
+
+    void setConfig(const QJsonObject& json)
+    {
+        if (json.contains("rules")) {
+            _filter.setRules(json["rules"].toString());
+        }
+
+        if (json.contains("mode")) {
+            _block = (json["mode"].toString() == "block");
+        }
+    }
+
+    QJsonObject getConfig() const
+    {
+        return { { "rules", _filter.rules() }, { "mode", _block ? "block" : "pass" } };
+    }
+
+    IdFilter _filter;
+    bool _block{ false };
+
+private:
+    CanFilter* q_ptr;
+};
+
+#endif // CANFILTER_P_H
@@ -0,0 +1,112 @@
+#include "idfilter.h"
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringList>
+#include <algorithm>
+#include <iterator>
+#include <log.h>
+#include <map>
+
+namespace {
+bool parseId(QString str, quint32& value)
+{
+    bool ok = false;
+
+    if (str.startsWith("0x", Qt::CaseInsensitive)) {
+        str.remove(0, 2);
+    }
+
+    value = str.toUInt(&ok, 16);
+
+    return ok && (value <= 0x1fffffff);
+}
+}
+
+bool IdFilter::setRules(const QString& rules)
+{
+    std::map<quint32, std::vector<quint32>> masks;
+    std::vector<std::pair<quint32, quint32>> ranges;
+
+    for (const auto& rule : rules.split(QRegularExpression("[,;\\s]+"), QString::SkipEmptyParts)) {
+        const int maskPos = rule.indexOf('/');
+        const int rangePos = rule.indexOf('-');
+        quint32 first = 0;
+        quint32 second = 0;
+
+        if (maskPos > 0) {
+            if (!parseId(rule.left(maskPos), first) || !parseId(rule.mid(maskPos + 1), second)) {
+                cds_warn("Incorrect filter rule '{}'", rule.toStdString());
+                return false;
+            }
+
+            masks[second].push_back(first & second);
+        } else if (rangePos > 0) {
+            if (!parseId(rule.left(rangePos), first) || !parseId(rule.mid(rangePos + 1), second) || (first > second)) {
+                cds_warn("Incorrect filter rule '{}'", rule.toStdString());
+                return false;
+            }
+
+            ranges.emplace_back(first, second);
+        } else {
+            if (!parseId(rule, first)) {
+                cds_warn("Incorrect filter rule '{}'", rule.toStdString());
+                return false;
+            }
+
+            masks[0x1fffffff].push_back(first);
+        }
+    }
+
+    _maskGroups.clear();
+    for (auto& m : masks) {
+        std::sort(m.second.begin(), m.second.end());
+        m.second.erase(std::unique(m.second.begin(), m.second.end()), m.second.end());
+        _maskGroups.push_back({ m.first, std::move(m.second) });
+    }
+
+    // Merge overlapping and adjacent ranges
+    std::sort(ranges.begin(), ranges.end());
+    _ranges.clear();
+    for (const auto& r : ranges) {
+        if (!_ranges.empty() && (r.first <= _ranges.back().second + 1)) {
+            _ranges.back().second = std::max(_ranges.back().second, r.second);
+        } else {
+            _ranges.push_back(r);
+        }
+    }
+
+    _stdBitmap.fill(0);
+    for (quint32 id = 0; id < kStdIdCount; ++id) {
+        if (matchesRules(id)) {
+            _stdBitmap[id / 64] |= quint64(1) << (id % 64);
+        }
+    }
+
+    _rules = rules;
+
+    return true;
+}
+
+QString IdFilter::rules() const
+{
+    return _rules;
+}
+
+bool IdFilter::isEmpty() const
+{
+    return _maskGroups.empty() && _ranges.empty();
+}
+
+bool IdFilter::matchesRules(quint32 id) const
+{
+    for (const auto& group : _maskGroups) {
+        if (std::binary_search(group.values.begin(), group.values.end(), id & group.mask)) {
+            return true;
+        }
+    }
+
+    // First range starting after id. Only the preceding one may contain it.
+    auto it = std::upper_bound(_ranges.begin(), _ranges.end(), id,
+        [](quint32 value, const std::pair<quint32, quint32>& range) { return value < range.first; });
+
+    return (it != _ranges.begin()) && (id <= std::prev(it)->second);
+}
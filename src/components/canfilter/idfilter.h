@@ -0,0 +1,73 @@
+#ifndef IDFILTER_H
+#define IDFILTER_H
+
+#include <QtCore/QString>
+#include <array>
+#include <utility>
+#include <vector>
+
+/**
+*   @brief The class provides matching of CAN IDs against ID/mask and ID range rules.
+*
+*   Rules are compiled when set. Result for every 11-bit ID is precomputed into a bitmap, so standard frames are
+*   matched with a single lookup. Extended IDs are matched against ID/mask rules grouped by mask and against merged
+*   ranges, both using binary search.
+*
+*   Rules are separated with commas, semicolons or whitespace. All numbers are hexadecimal, 0x prefix is optional:
+*       123         exact ID
+*       100/7f0     ID/mask, matches if (frameId & mask) == (id & mask)
+*       200-2ff     inclusive range
+*/
+class IdFilter {
+public:
+    /**
+    *   @brief  Parses and compiles rules
+    *   @param  rules rules definition
+    *   @return true on success. On failure previous rules are kept.
+    */
+    bool setRules(const QString& rules);
+
+    /**
+    *   @brief  Gets rules definition
+    *   @return rules as set by setRules
+    */
+    QString rules() const;
+
+    /**
+    *   @brief  Checks if any rule is defined
+    *   @return true if there are no rules
+    */
+    bool isEmpty() const;
+
+    /**
+    *   @brief  Checks if ID matches any rule
+    *   @param  id frame ID
+    *   @param  extended true for 29-bit frame format
+    *   @return true if ID matches
+    */
+    bool matches(quint32 id, bool extended) const
+    {
+        if (!extended && (id < kStdIdCount)) {
+            return (_stdBitmap[id / 64] >> (id % 64)) & 1;
+        }
+
+        return matchesRules(id);
+    }
+
+private:
+    static constexpr quint32 kStdIdCount = 0x800;
+
+    struct MaskGroup {
+        quint32 mask;
+        std::vector<quint32> values; // sorted (id & mask) values
+    };
+
+    bool matchesRules(quint32 id) const;
+
+    QString _rules;
+    std::vector<MaskGroup> _maskGroups;
+    std::vector<std::pair<quint32, quint32>> _ranges; // sorted, not overlapping
+    std::array<quint64, kStdIdCount / 64> _stdBitmap{};
+};
+
+#endif // IDFILTER_H
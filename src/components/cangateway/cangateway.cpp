@@ -0,0 +1,56 @@
+#include "cangateway.h"
+#include "cangateway_p.h"
+#include <QtSerialBus/QCanBusFrame>
+
+constexpr int CanGateway::kPortCount;
+
+CanGateway::CanGateway()
+    : d_ptr(new CanGatewayPrivate(this))
+{
+}
+
+CanGateway::~CanGateway()
+{
+}
+
+void CanGateway::setConfig(QJsonObject& json)
+{
+    Q_D(CanGateway);
+
+    d->setConfig(json);
+}
+
+QJsonObject CanGateway::getConfig() const
+{
+    Q_D(const CanGateway);
+
+    return d->getConfig();
+}
+
+void CanGateway::frameReceived(int port, const QCanBusFrame& frame)
+{
+    Q_D(CanGateway);
+
+    if (!d->_simStarted) {
+        return;
+    }
+
+    for (const auto action : d->_table.lookup(port, frame.frameId(), frame.hasExtendedFrameFormat())) {
+        emit frameRouted(action->outPort, RoutingTable::apply(*action, frame));
+    }
+}
+
+void CanGateway::stopSimulation()
+{
+    Q_D(CanGateway);
+
+    d->_simStarted = false;
+}
+
+void CanGateway::startSimulation()
+{
+    Q_D(CanGateway);
+
+    d->_table.compile(d->_rules, kPortCount);
+    d->_simStarted = true;
+}
@@ -0,0 +1,61 @@
+#ifndef CANGATEWAY_H
+#define CANGATEWAY_H
+
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <componentinterface.h>
+
+class QCanBusFrame;
+class CanGatewayPrivate;
+
+/**
+*   @brief The class provides component forwarding frames between buses. Frames may be filtered, get new ID or have
+*          payload modified on the way. Component doesn't have main widget, it is configured via node properties.
+*/
+class CanGateway : public QObject, public ComponentInterface {
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(CanGateway)
+
+public:
+    /**
+    *   @brief  Number of gateway ports. Each port is a pair of input and output.
+    */
+    static constexpr int kPortCount = 2;
+
+    CanGateway();
+    ~CanGateway();
+
+    /**
+    *   @see ComponentInterface
+    */
+    void setConfig(QJsonObject& json) override;
+
+    /**
+    *   @see ComponentInterface
+    */
+    QJsonObject getConfig() const override;
+
+signals:
+    /**
+    *   @brief  Emitted for every frame to be forwarded
+    *   @param  port output port
+    *   @param  frame frame to be sent
+    */
+    void frameRouted(int port, const QCanBusFrame& frame);
+
+public slots:
+    /**
+    *   @brief  Routes frame received on given port. Frames are routed only while simulation is running.
+    *   @param  port input port
+    *   @param  frame received frame
+    */
+    void frameReceived(int port, const QCanBusFrame& frame);
+
+    void stopSimulation();
+    void startSimulation();
+
+private:
+    QScopedPointer<CanGatewayPrivate> d_ptr;
+};
+
+#endif // CANGATEWAY_H
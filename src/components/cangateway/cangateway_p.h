@@ -0,0 +1,43 @@
+#ifndef CANGATEWAY_P_H
+#define CANGATEWAY_P_H
+
+#include "cangateway.h"
+#include "routingtable.h"
+#include <QtCore/QJsonObject>
+
+class CanGatewayPrivate {
+    Q_DECLARE_PUBLIC(CanGateway)
+
+public:
+    CanGatewayPrivate(CanGateway* q)
+        : q_ptr(q)
+    {
+        _table.compile(_rules, CanGateway::kPortCount);
+    }
+
+    void setConfig(const QJsonObject& json)
+    {
+        if (json.contains("rules")) {
+            const QString rules = json["rules"].toString();
+
+            // Rules are validated right away, but compiled for use at simulation start
+            if (RoutingTable().compile(rules, CanGateway::kPortCount)) {
+                _rules = rules;
+            }
+        }
+    }
+
+    QJsonObject getConfig() const
+    {
+        return { { "rules", _rules } };
+    }
+
+    QString _rules;
+    RoutingTable _table;
+    bool _simStarted{ false };
+
+private:
+    CanGateway* q_ptr;
+};
+
+#endif // CANGATEWAY_P_H
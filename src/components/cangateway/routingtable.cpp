@@ -0,0 +1,191 @@
+#include "routingtable.h"
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringList>
+#include <log.h>
+
+namespace {
+bool parseHex(QString str, quint32& value, quint32 max)
+{
+    bool ok = false;
+
+    if (str.startsWith("0x", Qt::CaseInsensitive)) {
+        str.remove(0, 2);
+    }
+
+    value = str.toUInt(&ok, 16);
+
+    return ok && (value <= max);
+}
+}
+
+bool RoutingTable::compile(const QString& rules, int portCount)
+{
+    // e.g. "1:123/7ff > 0:456 b2=0f/0f"
+    static const QRegularExpression ruleRe("^(\\d+):(\\*|[0-9a-fx]+)(?:/([0-9a-fx]+))?" // input port, ID, mask
+                                           "\\s*>\\s*(\\d+)(?::([0-9a-fx]+))?" // output port, new ID
+                                           "((?:\\s+b\\d+=[0-9a-fx]+(?:/[0-9a-fx]+)?)*)$", // payload rewrites
+        QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression rewriteRe("b(\\d+)=([0-9a-fx]+)(?:/([0-9a-fx]+))?",
+        QRegularExpression::CaseInsensitiveOption);
+    RoutingTable table;
+
+    for (auto line : rules.split(QRegularExpression("[;\\n]"), QString::SkipEmptyParts)) {
+        line = line.trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        const auto match = ruleRe.match(line);
+        Rule rule{ 0, 0, 0, { 0, false, 0, {} } };
+        bool ok = match.hasMatch();
+        quint32 value = 0;
+
+        if (ok) {
+            rule.inPort = match.captured(1).toInt();
+            rule.action.outPort = match.captured(4).toInt();
+            ok = (rule.inPort < portCount) && (rule.action.outPort < portCount);
+        }
+
+        if (ok && (match.captured(2) == "*")) {
+            rule.mask = 0;
+        } else if (ok) {
+            ok = parseHex(match.captured(2), rule.id, 0x1fffffff);
+            rule.mask = 0x1fffffff;
+
+            if (ok && !match.captured(3).isEmpty()) {
+                ok = parseHex(match.captured(3), rule.mask, 0x1fffffff);
+            }
+
+            rule.id &= rule.mask;
+        }
+
+        if (ok && !match.captured(5).isEmpty()) {
+            rule.action.remap = true;
+            ok = parseHex(match.captured(5), rule.action.newId, 0x1fffffff);
+        }
+
+        auto it = rewriteRe.globalMatch(match.captured(6));
+        while (ok && it.hasNext()) {
+            const auto rewrite = it.next();
+            ByteRewrite byte{ rewrite.captured(1).toInt(), 0, 0xff };
+
+            ok = (byte.index < 64) && parseHex(rewrite.captured(2), value, 0xff);
+            byte.value = static_cast<quint8>(value);
+
+            if (ok && !rewrite.captured(3).isEmpty()) {
+                ok = parseHex(rewrite.captured(3), value, 0xff);
+                byte.mask = static_cast<quint8>(value);
+            }
+
+            rule.action.rewrites.push_back(byte);
+        }
+
+        if (!ok) {
+            cds_warn("Incorrect routing rule '{}'", line.toStdString());
+            return false;
+        }
+
+        table._ruleList.push_back(std::move(rule));
+    }
+
+    table._rules = rules;
+    table._stdTables.assign(portCount, std::vector<quint32>(kStdIdCount, 0));
+    table._extCache.resize(portCount);
+
+    for (int port = 0; port < portCount; ++port) {
+        for (quint32 id = 0; id < kStdIdCount; ++id) {
+            table._stdTables[port][id] = table.internRoute(table.matchingRules(port, id));
+        }
+    }
+
+    // Routes point to actions owned by _ruleList. Moving vectors keeps the pointers valid.
+    *this = std::move(table);
+
+    return true;
+}
+
+QString RoutingTable::rules() const
+{
+    return _rules;
+}
+
+QCanBusFrame RoutingTable::apply(const Action& action, const QCanBusFrame& frame)
+{
+    QCanBusFrame out(frame);
+
+    if (action.remap) {
+        out.setFrameId(action.newId);
+        out.setExtendedFrameFormat(frame.hasExtendedFrameFormat() || (action.newId >= kStdIdCount));
+    }
+
+    if (!action.rewrites.empty()) {
+        QByteArray payload = frame.payload();
+
+        for (const auto& byte : action.rewrites) {
+            if (byte.index < payload.size()) {
+                payload[byte.index] = static_cast<char>((payload[byte.index] & ~byte.mask) | (byte.value & byte.mask));
+            }
+        }
+
+        out.setPayload(payload);
+    }
+
+    return out;
+}
+
+const RoutingTable::Route& RoutingTable::lookupExtended(int inPort, quint32 id)
+{
+    auto& cache = _extCache[inPort];
+    const auto it = cache.find(id);
+
+    if (it != cache.end()) {
+        return _routes[it->second];
+    }
+
+    // Bound memory used by bus with random IDs. Routes are kept, they are limited by number of rule combinations.
+    if (cache.size() >= kMaxCachedIds) {
+        cache.clear();
+    }
+
+    const quint32 route = internRoute(matchingRules(inPort, id));
+    cache.emplace(id, route);
+
+    return _routes[route];
+}
+
+std::vector<int> RoutingTable::matchingRules(int inPort, quint32 id) const
+{
+    std::vector<int> ruleIdx;
+
+    for (std::size_t i = 0; i < _ruleList.size(); ++i) {
+        const auto& rule = _ruleList[i];
+
+        if ((rule.inPort == inPort) && ((id & rule.mask) == rule.id)) {
+            ruleIdx.push_back(static_cast<int>(i));
+        }
+    }
+
+    return ruleIdx;
+}
+
+quint32 RoutingTable::internRoute(const std::vector<int>& ruleIdx)
+{
+    if (ruleIdx.empty()) {
+        return 0;
+    }
+
+    const auto it = _routeIndex.find(ruleIdx);
+    if (it != _routeIndex.end()) {
+        return it->second;
+    }
+
+    Route route;
+    for (int idx : ruleIdx) {
+        route.push_back(&_ruleList[idx].action);
+    }
+
+    _routes.push_back(std::move(route));
+    _routeIndex.emplace(ruleIdx, static_cast<quint32>(_routes.size() - 1));
+
+    return static_cast<quint32>(_routes.size() - 1);
+}
@@ -0,0 +1,107 @@
+#ifndef ROUTINGTABLE_H
+#define ROUTINGTABLE_H
+
+#include <QtCore/QString>
+#include <QtSerialBus/QCanBusFrame>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+/**
+*   @brief The class provides routing of frames between gateway ports.
+*
+*   Rules are compiled into flat tables. For each input port result for every 11-bit ID is precomputed into
+*   a direct-indexed table. Routes of extended IDs are resolved on first occurrence and cached in a hash table.
+*   All rules matching the frame are applied, so one frame may be forwarded to several ports.
+*
+*   Rules are separated with semicolons or new lines. All numbers are hexadecimal:
+*       0:123 > 1               forward ID 0x123 from port 0 to port 1
+*       0:100/7f0 > 1           forward IDs matching ID/mask
+*       0:* > 1                 forward all frames
+*       1:123 > 0:456           forward with ID remapped to 0x456
+*       1:123 > 0 b2=0f/0f      forward with bits 0x0f of payload byte 2 set to 0x0f. Mask is optional (ff).
+*/
+class RoutingTable {
+public:
+    struct ByteRewrite {
+        int index;
+        quint8 value;
+        quint8 mask;
+    };
+
+    struct Action {
+        int outPort;
+        bool remap;
+        quint32 newId;
+        std::vector<ByteRewrite> rewrites;
+    };
+
+    typedef std::vector<const Action*> Route;
+
+    /**
+    *   @brief  Parses and compiles rules
+    *   @param  rules rules definition
+    *   @param  portCount number of gateway ports
+    *   @return true on success. On failure previous rules are kept.
+    */
+    bool compile(const QString& rules, int portCount);
+
+    /**
+    *   @brief  Gets rules definition
+    *   @return rules as passed to compile
+    */
+    QString rules() const;
+
+    /**
+    *   @brief  Finds actions to be applied to a frame
+    *   @param  inPort port frame was received on
+    *   @param  id frame ID
+    *   @param  extended true for 29-bit frame format
+    *   @return list of actions, empty if frame shall not be forwarded
+    */
+    const Route& lookup(int inPort, quint32 id, bool extended)
+    {
+        if ((inPort < 0) || (inPort >= static_cast<int>(_stdTables.size()))) {
+            return _routes.front();
+        }
+
+        if (!extended && (id < kStdIdCount)) {
+            return _routes[_stdTables[inPort][id]];
+        }
+
+        return lookupExtended(inPort, id);
+    }
+
+    /**
+    *   @brief  Applies action to a frame
+    *   @param  action action returned by lookup
+    *   @param  frame received frame
+    *   @return frame to be forwarded
+    */
+    static QCanBusFrame apply(const Action& action, const QCanBusFrame& frame);
+
+private:
+    static constexpr quint32 kStdIdCount = 0x800;
+    static constexpr std::size_t kMaxCachedIds = 0x10000;
+
+    struct Rule {
+        int inPort;
+        quint32 id;
+        quint32 mask;
+        Action action;
+    };
+
+    const Route& lookupExtended(int inPort, quint32 id);
+    std::vector<int> matchingRules(int inPort, quint32 id) const;
+    quint32 internRoute(const std::vector<int>& ruleIdx);
+
+    QString _rules;
+    std::vector<Rule> _ruleList;
+    std::deque<Route> _routes{ Route() }; // route 0 is empty. Deque keeps references valid when routes are added.
+    std::map<std::vector<int>, quint32> _routeIndex; // matching rules -> route
+    std::vector<std::vector<quint32>> _stdTables;
+    std::vector<std::unordered_map<quint32, quint32>> _extCache;
+};
+
+#endif // ROUTINGTABLE_H
@@ -0,0 +1,79 @@
+#include "canmonitor.h"
+#include "canmonitor_p.h"
+#include <QtSerialBus/QCanBusFrame>
+
+CanMonitor::CanMonitor()
+    : d_ptr(new CanMonitorPrivate(this))
+{
+}
+
+CanMonitor::~CanMonitor()
+{
+}
+
+void CanMonitor::setConfig(QJsonObject& json)
+{
+    Q_D(CanMonitor);
+
+    d->setConfig(json);
+}
+
+QJsonObject CanMonitor::getConfig() const
+{
+    Q_D(const CanMonitor);
+
+    return d->getConfig();
+}
+
+quint64 CanMonitor::timeoutCount() const
+{
+    Q_D(const CanMonitor);
+
+    return d->_monitor.timeoutCount();
+}
+
+quint64 CanMonitor::earlyCount() const
+{
+    Q_D(const CanMonitor);
+
+    return d->_monitor.earlyCount();
+}
+
+int CanMonitor::trackedCount() const
+{
+    Q_D(const CanMonitor);
+
+    return d->_monitor.trackedCount();
+}
+
+bool CanMonitor::isMonitoring() const
+{
+    Q_D(const CanMonitor);
+
+    return d->_tickTimer.isActive();
+}
+
+void CanMonitor::frameReceived(const QCanBusFrame& frame)
+{
+    Q_D(CanMonitor);
+
+    if (d->_tickTimer.isActive()) {
+        d->_monitor.frame(frame.frameId(), frame.hasExtendedFrameFormat(), d->_clock.nsecsElapsed() / 1000);
+    }
+}
+
+void CanMonitor::stopSimulation()
+{
+    Q_D(CanMonitor);
+
+    d->_tickTimer.stop();
+}
+
+void CanMonitor::startSimulation()
+{
+    Q_D(CanMonitor);
+
+    d->_clock.start();
+    d->_monitor.start(0);
+    d->_tickTimer.start();
+}
@@ -0,0 +1,78 @@
+#ifndef CANMONITOR_H
+#define CANMONITOR_H
+
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <componentinterface.h>
+
+class QCanBusFrame;
+class CanMonitorPrivate;
+
+/**
+*   @brief The class provides component watching periods of cyclic frames during simulation. Violations are logged and
+*          signalled, nothing is reported while frames arrive on time. Component doesn't have main widget, it is
+*          configured via node properties.
+*   @see PeriodMonitor
+*/
+class CanMonitor : public QObject, public ComponentInterface {
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(CanMonitor)
+
+public:
+    CanMonitor();
+    ~CanMonitor();
+
+    /**
+    *   @see ComponentInterface
+    */
+    void setConfig(QJsonObject& json) override;
+
+    /**
+    *   @see ComponentInterface
+    */
+    QJsonObject getConfig() const override;
+
+    /**
+    *   @brief  Gets number of timeouts detected since simulation start
+    *   @return number of timeouts
+    */
+    quint64 timeoutCount() const;
+
+    /**
+    *   @brief  Gets number of frames received earlier than expected since simulation start
+    *   @return number of early frames
+    */
+    quint64 earlyCount() const;
+
+    /**
+    *   @brief  Gets number of IDs currently tracked
+    *   @return number of IDs
+    */
+    int trackedCount() const;
+
+    /**
+    *   @brief  Checks if monitoring is in progress
+    *   @return true if simulation is running
+    */
+    bool isMonitoring() const;
+
+signals:
+    /**
+    *   @brief  Emitted when frame didn't arrive in time or arrived too early
+    *   @param  id frame ID
+    *   @param  extended true for 29-bit frame format
+    *   @param  timeout true if frame didn't arrive in time, false if it arrived too early
+    *   @param  intervalUs time since previous frame with the ID in microseconds
+    */
+    void periodViolated(quint32 id, bool extended, bool timeout, qint64 intervalUs);
+
+public slots:
+    void frameReceived(const QCanBusFrame& frame);
+    void stopSimulation();
+    void startSimulation();
+
+private:
+    QScopedPointer<CanMonitorPrivate> d_ptr;
+};
+
+#endif // CANMONITOR_H
@@ -0,0 +1,122 @@
+#ifndef CANMONITOR_P_H
+#define CANMONITOR_P_H
+
+#include "canmonitor.h"
+#include "periodmonitor.h"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTimer>
+#include <log.h>
+
+class CanMonitorPrivate {
+    Q_DECLARE_PUBLIC(CanMonitor)
+
+public:
+    CanMonitorPrivate(CanMonitor* q)
+        : q_ptr(q)
+    {
+        _monitor.setCallback([this](const PeriodMonitor::Entry& entry, PeriodMonitor::Violation violation,
+                                 qint64 intervalUs) { report(entry, violation, intervalUs); });
+
+        _tickTimer.setInterval(static_cast<int>(PeriodMonitor::kTickUs / 1000));
+        QObject::connect(&_tickTimer, &QTimer::timeout, [this] { _monitor.advance(_clock.nsecsElapsed() / 1000); });
+    }
+
+    void setConfig(const QJsonObject& json)
+    {
+        if (json.contains("periods")) {
+            setPeriods(json["periods"].toString());
+        }
+
+        if (json.contains("tolerance")) {
+            const int tolerance = json["tolerance"].toVariant().toInt();
+
+            if ((tolerance >= 0) && (tolerance < 100)) {
+                _tolerance = tolerance;
+                _monitor.setTolerance(tolerance);
+            } else {
+                cds_warn("Incorrect tolerance '{}'", tolerance);
+            }
+        }
+
+        if (json.contains("learn")) {
+            _learn = json["learn"].toVariant().toBool();
+            _monitor.setLearning(_learn);
+        }
+    }
+
+    QJsonObject getConfig() const
+    {
+        return { { "periods", _periods }, { "tolerance", _tolerance }, { "learn", _learn } };
+    }
+
+    /**
+    *   @brief  Parses list of expected periods, e.g. "123:100, 18fe0000:1000". IDs are hex, periods in ms.
+    *           IDs above 0x7ff are treated as extended.
+    *   @param  periods list of expected periods
+    */
+    void setPeriods(const QString& periods)
+    {
+        QList<QPair<quint32, qint64>> parsed;
+
+        for (const auto& item : periods.split(QRegularExpression("[,;\\s]+"), QString::SkipEmptyParts)) {
+            const QStringList parts = item.split(':');
+            bool idOk = false;
+            bool periodOk = false;
+            QString idStr = parts.front();
+
+            if (idStr.startsWith("0x", Qt::CaseInsensitive)) {
+                idStr.remove(0, 2);
+            }
+
+            const quint32 id = idStr.toUInt(&idOk, 16);
+            const qint64 periodMs = (parts.size() == 2) ? parts.back().toLongLong(&periodOk) : 0;
+
+            if (!idOk || !periodOk || (id > 0x1fffffff) || (periodMs <= 0)) {
+                cds_warn("Incorrect period '{}'", item.toStdString());
+                return;
+            }
+
+            parsed.append(qMakePair(id, periodMs));
+        }
+
+        for (const auto& p : _parsedPeriods) {
+            _monitor.setExpected(p.first, p.first > 0x7ff, 0);
+        }
+
+        for (const auto& p : parsed) {
+            _monitor.setExpected(p.first, p.first > 0x7ff, p.second * 1000);
+        }
+
+        _parsedPeriods = parsed;
+        _periods = periods;
+    }
+
+    void report(const PeriodMonitor::Entry& entry, PeriodMonitor::Violation violation, qint64 intervalUs)
+    {
+        Q_Q(CanMonitor);
+
+        const quint32 id = entry.key & 0x1fffffff;
+        const bool extended = (entry.key & 0x80000000) != 0;
+        const bool timeout = violation == PeriodMonitor::Violation::Timeout;
+
+        cds_warn("ID 0x{:x} {}: {} us since previous frame, expected {} us +/- {}%", id,
+            timeout ? "timed out" : "arrived early", intervalUs, entry.periodUs, _tolerance);
+
+        emit q->periodViolated(id, extended, timeout, intervalUs);
+    }
+
+    PeriodMonitor _monitor;
+    QTimer _tickTimer;
+    QElapsedTimer _clock;
+    QString _periods;
+    QList<QPair<quint32, qint64>> _parsedPeriods;
+    int _tolerance{ 20 };
+    bool _learn{ true };
+
+private:
+    CanMonitor* q_ptr;
+};
+
+#endif // CANMONITOR_P_H
@@ -0,0 +1,277 @@
+#include "periodmonitor.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+const quint32 kEmptyKey = 0xffffffff; // not a valid ID, bit 31 is used only with 29-bit IDs
+const qint32 kNone = -1;
+
+// Murmur3 finalizer, every bit of key including format flag affects the low bits used as slot index
+quint32 slotOf(quint32 key, quint32 mask)
+{
+    key ^= key >> 16;
+    key *= 0x85ebca6bu;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35u;
+    key ^= key >> 16;
+
+    return key & mask;
+}
+}
+
+constexpr qint64 PeriodMonitor::kTickUs;
+constexpr int PeriodMonitor::kSlotCount;
+constexpr int PeriodMonitor::kLearnIntervals;
+
+PeriodMonitor::PeriodMonitor(int capacityLog2)
+    : _mask((1u << capacityLog2) - 1)
+    , _maxTracked((1 << capacityLog2) / 4 * 3)
+    , _entries(1u << capacityLog2)
+    , _slots(kSlotCount, kNone)
+{
+    start(0);
+}
+
+void PeriodMonitor::setCallback(const callback_t& callback)
+{
+    _callback = callback;
+}
+
+void PeriodMonitor::setTolerance(int percent)
+{
+    _tolerance = std::max(percent, 0);
+}
+
+void PeriodMonitor::setLearning(bool learn)
+{
+    _learn = learn;
+}
+
+void PeriodMonitor::setExpected(quint32 id, bool ext, qint64 periodUs)
+{
+    if (periodUs > 0) {
+        _expected.insert(makeKey(id, ext), periodUs);
+    } else {
+        _expected.remove(makeKey(id, ext));
+    }
+}
+
+void PeriodMonitor::start(qint64 nowUs)
+{
+    for (auto& entry : _entries) {
+        entry.key = kEmptyKey;
+    }
+
+    std::fill(_slots.begin(), _slots.end(), kNone);
+    _currentTick = nowUs / kTickUs;
+    _tracked = 0;
+    _untracked = 0;
+    _timeouts = 0;
+    _early = 0;
+
+    for (auto it = _expected.cbegin(); it != _expected.cend(); ++it) {
+        const qint32 idx = findOrInsert(it.key());
+
+        if (idx != kNone) {
+            auto& entry = _entries[idx];
+
+            entry.configured = true;
+            entry.periodUs = it.value();
+            entry.lastUs = nowUs;
+            schedule(idx, deadline(entry));
+        }
+    }
+}
+
+void PeriodMonitor::frame(quint32 id, bool ext, qint64 nowUs)
+{
+    const qint32 idx = findOrInsert(makeKey(id, ext));
+
+    if (idx == kNone) {
+        ++_untracked;
+        return;
+    }
+
+    auto& entry = _entries[idx];
+
+    if (entry.count > 0) {
+        const qint64 interval = nowUs - entry.lastUs;
+
+        entry.minUs = std::min(entry.minUs, interval);
+        entry.maxUs = std::max(entry.maxUs, interval);
+        entry.sumUs += interval;
+
+        if ((entry.periodUs > 0) && (interval * 100 < entry.periodUs * (100 - _tolerance))) {
+            ++_early;
+
+            if (_callback) {
+                _callback(entry, Violation::Early, interval);
+            }
+        }
+
+        if ((entry.periodUs == 0) && _learn && (entry.count >= kLearnIntervals)) {
+            entry.periodUs = entry.sumUs / static_cast<qint64>(entry.count);
+        }
+    }
+
+    entry.timedOut = false;
+    entry.lastUs = nowUs;
+    ++entry.count;
+
+    if (entry.periodUs > 0) {
+        schedule(idx, deadline(entry));
+    }
+}
+
+void PeriodMonitor::advance(qint64 nowUs)
+{
+    const qint64 target = nowUs / kTickUs;
+
+    if (target - _currentTick >= kSlotCount) {
+        // Whole wheel has been passed. Visit every slot once.
+        for (int slot = 0; slot < kSlotCount; ++slot) {
+            expireSlot(slot, target);
+        }
+
+        _currentTick = target;
+        return;
+    }
+
+    while (_currentTick < target) {
+        ++_currentTick;
+        expireSlot(static_cast<int>(_currentTick % kSlotCount), _currentTick);
+    }
+}
+
+const PeriodMonitor::Entry* PeriodMonitor::find(quint32 id, bool ext) const
+{
+    const quint32 key = makeKey(id, ext);
+
+    for (quint32 i = slotOf(key, _mask);; i = (i + 1) & _mask) {
+        if (_entries[i].key == key) {
+            return &_entries[i];
+        } else if (_entries[i].key == kEmptyKey) {
+            return nullptr;
+        }
+    }
+}
+
+int PeriodMonitor::trackedCount() const
+{
+    return _tracked;
+}
+
+quint64 PeriodMonitor::untrackedCount() const
+{
+    return _untracked;
+}
+
+quint64 PeriodMonitor::timeoutCount() const
+{
+    return _timeouts;
+}
+
+quint64 PeriodMonitor::earlyCount() const
+{
+    return _early;
+}
+
+quint32 PeriodMonitor::makeKey(quint32 id, bool ext)
+{
+    return ext ? (id | 0x80000000) : id;
+}
+
+qint32 PeriodMonitor::findOrInsert(quint32 key)
+{
+    // Table is never full, so probing always terminates
+    for (quint32 i = slotOf(key, _mask);; i = (i + 1) & _mask) {
+        auto& entry = _entries[i];
+
+        if (entry.key == key) {
+            return static_cast<qint32>(i);
+        }
+
+        if (entry.key == kEmptyKey) {
+            if (_tracked >= _maxTracked) {
+                return kNone;
+            }
+
+            entry = { key, false, false, 0, 0, 0, std::numeric_limits<qint64>::max(), 0, 0, -1, kNone, kNone };
+            ++_tracked;
+
+            return static_cast<qint32>(i);
+        }
+    }
+}
+
+void PeriodMonitor::schedule(qint32 idx, qint64 deadlineUs)
+{
+    auto& entry = _entries[idx];
+
+    unschedule(idx);
+
+    // Round up, so timeout is never reported before deadline
+    entry.deadlineTick = std::max((deadlineUs + kTickUs - 1) / kTickUs, _currentTick + 1);
+
+    const int slot = static_cast<int>(entry.deadlineTick % kSlotCount);
+
+    entry.prev = kNone;
+    entry.next = _slots[slot];
+
+    if (entry.next != kNone) {
+        _entries[entry.next].prev = idx;
+    }
+
+    _slots[slot] = idx;
+}
+
+void PeriodMonitor::unschedule(qint32 idx)
+{
+    auto& entry = _entries[idx];
+
+    if (entry.deadlineTick < 0) {
+        return;
+    }
+
+    if (entry.prev != kNone) {
+        _entries[entry.prev].next = entry.next;
+    } else {
+        _slots[entry.deadlineTick % kSlotCount] = entry.next;
+    }
+
+    if (entry.next != kNone) {
+        _entries[entry.next].prev = entry.prev;
+    }
+
+    entry.deadlineTick = -1;
+    entry.prev = kNone;
+    entry.next = kNone;
+}
+
+void PeriodMonitor::expireSlot(int slot, qint64 tick)
+{
+    qint32 idx = _slots[slot];
+
+    while (idx != kNone) {
+        auto& entry = _entries[idx];
+        const qint32 next = entry.next;
+
+        // Slot holds deadlines of later wheel rounds as well
+        if (entry.deadlineTick <= tick) {
+            unschedule(idx);
+            entry.timedOut = true;
+            ++_timeouts;
+
+            if (_callback) {
+                _callback(entry, Violation::Timeout, tick * kTickUs - entry.lastUs);
+            }
+        }
+
+        idx = next;
+    }
+}
+
+qint64 PeriodMonitor::deadline(const Entry& entry) const
+{
+    return entry.lastUs + entry.periodUs * (100 + _tolerance) / 100;
+}
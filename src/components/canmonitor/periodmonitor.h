@@ -0,0 +1,127 @@
+#ifndef PERIODMONITOR_H
+#define PERIODMONITOR_H
+
+#include <QtCore/QHash>
+#include <functional>
+#include <vector>
+
+/**
+*   @brief The class provides monitoring of cyclic frames.
+*
+*   State of every ID is kept in a fixed size open addressing hash table allocated up front. Deadlines are kept in
+*   a hashed timer wheel with entries linked intrusively by table index. Handling of a frame is O(1) and doesn't
+*   allocate memory. Wheel is advanced periodically and only expired entries are visited.
+*
+*   Period of an ID is either configured or learned from first intervals. Violation is reported when frame doesn't
+*   arrive within period + tolerance (once, until ID comes back) or arrives earlier than period - tolerance.
+*/
+class PeriodMonitor {
+public:
+    enum class Violation { Timeout, Early };
+
+    struct Entry {
+        quint32 key; // ID, bit 31 set for extended format
+        bool configured;
+        bool timedOut;
+        qint64 periodUs; // expected period, 0 if not known yet
+        qint64 lastUs;
+        quint64 count;
+        qint64 minUs;
+        qint64 maxUs;
+        qint64 sumUs;
+        qint64 deadlineTick;
+        qint32 prev; // wheel slot list links
+        qint32 next;
+    };
+
+    typedef std::function<void(const Entry& entry, Violation violation, qint64 intervalUs)> callback_t;
+
+    static constexpr qint64 kTickUs = 10000;
+    static constexpr int kSlotCount = 1024;
+    static constexpr int kLearnIntervals = 4;
+
+    /**
+    *   @brief  Constructor
+    *   @param  capacityLog2 log2 of hash table size. At most 3/4 of the table is used.
+    */
+    explicit PeriodMonitor(int capacityLog2 = 14);
+
+    void setCallback(const callback_t& callback);
+
+    /**
+    *   @brief  Sets allowed deviation from period
+    *   @param  percent tolerance in percent of period
+    */
+    void setTolerance(int percent);
+
+    /**
+    *   @brief  Enables learning of periods of IDs that are not configured
+    *   @param  learn true to enable
+    */
+    void setLearning(bool learn);
+
+    /**
+    *   @brief  Sets expected period of an ID. Takes effect on next start.
+    *   @param  id frame ID
+    *   @param  ext true for extended frame format
+    *   @param  periodUs period in microseconds, 0 removes expectation
+    */
+    void setExpected(quint32 id, bool ext, qint64 periodUs);
+
+    /**
+    *   @brief  Clears state and starts monitoring. Configured IDs are expected to arrive within period from now.
+    *   @param  nowUs current time in microseconds
+    */
+    void start(qint64 nowUs);
+
+    /**
+    *   @brief  Handles received frame
+    *   @param  id frame ID
+    *   @param  ext true for extended frame format
+    *   @param  nowUs current time in microseconds
+    */
+    void frame(quint32 id, bool ext, qint64 nowUs);
+
+    /**
+    *   @brief  Advances timer wheel and reports timeouts
+    *   @param  nowUs current time in microseconds
+    */
+    void advance(qint64 nowUs);
+
+    /**
+    *   @brief  Finds state of an ID
+    *   @param  id frame ID
+    *   @param  ext true for extended frame format
+    *   @return entry or nullptr if ID is not tracked
+    */
+    const Entry* find(quint32 id, bool ext) const;
+
+    int trackedCount() const;
+    quint64 untrackedCount() const;
+    quint64 timeoutCount() const;
+    quint64 earlyCount() const;
+
+private:
+    static quint32 makeKey(quint32 id, bool ext);
+    qint32 findOrInsert(quint32 key);
+    void schedule(qint32 idx, qint64 deadlineUs);
+    void unschedule(qint32 idx);
+    void expireSlot(int slot, qint64 tick);
+    qint64 deadline(const Entry& entry) const;
+
+    const quint32 _mask;
+    const int _maxTracked;
+    std::vector<Entry> _entries;
+    std::vector<qint32> _slots;
+    QHash<quint32, qint64> _expected;
+    callback_t _callback;
+    int _tolerance{ 20 };
+    bool _learn{ true };
+    qint64 _currentTick{ 0 };
+    int _tracked{ 0 };
+    quint64 _untracked{ 0 };
+    quint64 _timeouts{ 0 };
+    quint64 _early{ 0 };
+};
+
+#endif // PERIODMONITOR_H
@@ -61,6 +61,11 @@ void CanRawSender::setDockUndockClbk(const std::function<void()>& cb)
     d->_ui.setDockUndockCbk(cb);
 }
 
+bool CanRawSender::mainWidgetCreated() const
+{
+    return d_ptr->_ui.isCreated();
+}
+
 bool CanRawSender::mainWidgetDocked() const
 {
     return d_ptr->docked;
@@ -25,6 +25,11 @@ public:
     */
     QWidget* getMainWidget() override;
 
+    /**
+    *   @see ComponentInterface
+    */
+    bool mainWidgetCreated() const override;
+
     /**
     *   @see ComponentInterface
     */
@@ -4,58 +4,90 @@
 #include "crsguiinterface.h"
 #include "ui_canrawsender.h"
 #include <memory>
+#include <vector>
 
 namespace Ui {
 class CanRawSenderPrivate;
 }
 
+/**
+*   @brief CanRawSender GUI. Widget is constructed on first getMainWidget() call. All the setup requested before that
+*          is postponed until widget creation.
+*/
 struct CRSGui : public CRSGuiInterface {
     CRSGui()
         : ui(new Ui::CanRawSenderPrivate)
-        , widget(new QWidget)
     {
-        ui->setupUi(widget);
     }
 
     void setAddCbk(const add_t& cb) override
     {
-        QObject::connect(ui->pbAdd, &QPushButton::pressed, cb);
+        whenCreated([this, cb] { QObject::connect(ui->pbAdd, &QPushButton::pressed, cb); });
     }
 
     void setRemoveCbk(const remove_t& cb) override
     {
-        QObject::connect(ui->pbRemove, &QPushButton::pressed, cb);
+        whenCreated([this, cb] { QObject::connect(ui->pbRemove, &QPushButton::pressed, cb); });
     }
 
     void setDockUndockCbk(const dockUndock_t& cb) override
     {
-        QObject::connect(ui->pbDockUndock, &QPushButton::toggled, cb);
+        whenCreated([this, cb] { QObject::connect(ui->pbDockUndock, &QPushButton::toggled, cb); });
     }
 
     QWidget* getMainWidget() override
     {
+        if (!widget) {
+            widget = new QWidget;
+            ui->setupUi(widget);
+
+            for (const auto& action : pending) {
+                action();
+            }
+
+            pending.clear();
+        }
+
         return widget;
     }
 
-    void initTableView(QAbstractItemModel& _tvModel) override
+    bool isCreated() override
     {
+        return widget != nullptr;
+    }
 
-        ui->tv->setModel(&_tvModel);
-        ui->tv->setSelectionBehavior(QAbstractItemView::SelectRows);
+    void initTableView(QAbstractItemModel& _tvModel) override
+    {
+        whenCreated([this, &_tvModel] {
+            ui->tv->setModel(&_tvModel);
+            ui->tv->setSelectionBehavior(QAbstractItemView::SelectRows);
+        });
     }
 
     QModelIndexList getSelectedRows() override
     {
-        return ui->tv->selectionModel()->selectedRows();
+        return widget ? ui->tv->selectionModel()->selectedRows() : QModelIndexList();
     }
 
-    void setIndexWidget(const QModelIndex& index, QWidget* widget) override
+    void setIndexWidget(const QModelIndex& index, QWidget* indexWidget) override
     {
-        ui->tv->setIndexWidget(index, widget);
+        const QPersistentModelIndex pIndex(index);
+
+        whenCreated([this, pIndex, indexWidget] { ui->tv->setIndexWidget(pIndex, indexWidget); });
     }
 
 private:
+    void whenCreated(const std::function<void()>& action)
+    {
+        if (widget) {
+            action();
+        } else {
+            pending.push_back(action);
+        }
+    }
+
     Ui::CanRawSenderPrivate* ui;
-    QWidget* widget;
+    QWidget* widget{ nullptr };
+    std::vector<std::function<void()>> pending;
 };
 #endif // CRSGUI_H
@@ -7,6 +7,11 @@
 #include <QtCore/QStringList>
 #include <QtSerialBus/QCanBusFrame>
 
+constexpr int CanRawViewPrivate::kMinRefreshRate;
+constexpr int CanRawViewPrivate::kMaxRefreshRate;
+constexpr int CanRawViewPrivate::kMinResidentChunks;
+constexpr quint64 CanRawViewPrivate::kExportSliceSize;
+
 CanRawView::CanRawView()
     : d_ptr(new CanRawViewPrivate(this))
 {
@@ -41,7 +46,7 @@ void CanRawView::frameReceived(const QCanBusFrame& frame)
 {
     Q_D(CanRawView);
 
-    d->frameView(frame, "RX");
+    d->frameView(frame, false);
 }
 
 void CanRawView::frameSent(bool status, const QCanBusFrame& frame)
@@ -49,7 +54,7 @@ void CanRawView::frameSent(bool status, const QCanBusFrame& frame)
     Q_D(CanRawView);
 
     if (status) {
-        d->frameView(frame, "TX");
+        d->frameView(frame, true);
     }
 }
 
@@ -60,9 +65,11 @@ QWidget* CanRawView::getMainWidget()
     return d->_ui.getMainWidget();
 }
 
-void CanRawView::setConfig(QJsonObject&)
+void CanRawView::setConfig(QJsonObject& json)
 {
-    // TODO
+    Q_D(CanRawView);
+
+    d->loadSettings(json);
 }
 
 QJsonObject CanRawView::getConfig() const
@@ -75,6 +82,44 @@ QJsonObject CanRawView::getConfig() const
     return config;
 }
 
+bool CanRawView::hasData() const
+{
+    return d_ptr->hasData();
+}
+
+bool CanRawView::saveData(const QString& fileName)
+{
+    Q_D(CanRawView);
+
+    return d->saveData(fileName);
+}
+
+void CanRawView::setDataFile(const QString& fileName)
+{
+    Q_D(CanRawView);
+
+    d->_dataLoader = nullptr;
+    d->_dataFile = fileName;
+
+    // Data is loaded right away only if somebody is looking at the view
+    if (d->_ui.isVisible()) {
+        d->refreshView();
+    }
+}
+
+void CanRawView::setDataLoader(const std::function<QByteArray()>& loader)
+{
+    Q_D(CanRawView);
+
+    d->_dataLoader = loader;
+    d->_dataFile.clear();
+
+    // Data is loaded right away only if somebody is looking at the view
+    if (d->_ui.isVisible()) {
+        d->refreshView();
+    }
+}
+
 void CanRawView::setDockUndockClbk(const std::function<void()>& cb)
 {
     Q_D(CanRawView);
@@ -82,6 +127,11 @@ void CanRawView::setDockUndockClbk(const std::function<void()>& cb)
     d->_ui.setDockUndockCbk(cb);
 }
 
+bool CanRawView::mainWidgetCreated() const
+{
+    return d_ptr->_ui.isCreated();
+}
+
 bool CanRawView::mainWidgetDocked() const
 {
     return d_ptr->docked;
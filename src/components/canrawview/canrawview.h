@@ -25,6 +25,11 @@ public:
     */
     QWidget* getMainWidget() override;
 
+    /**
+    *   @see ComponentInterface
+    */
+    bool mainWidgetCreated() const override;
+
     /**
     *   @see ComponentInterface
     */
@@ -35,6 +40,26 @@ public:
     */
     QJsonObject getConfig() const override;
 
+    /**
+    *   @see ComponentInterface
+    */
+    bool hasData() const override;
+
+    /**
+    *   @see ComponentInterface
+    */
+    bool saveData(const QString& fileName) override;
+
+    /**
+    *   @see ComponentInterface
+    */
+    void setDataFile(const QString& fileName) override;
+
+    /**
+    *   @see ComponentInterface
+    */
+    void setDataLoader(const std::function<QByteArray()>& loader) override;
+
     /**
     *   @see ComponentInterface
     */
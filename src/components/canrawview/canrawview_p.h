@@ -1,13 +1,23 @@
 #ifndef CANRAWVIEW_P_H
 #define CANRAWVIEW_P_H
 
+#include "capturefile.h"
+#include "frameexporter.h"
+#include "framemodel.h"
+#include "framesearch.h"
+#include "framestatsmodel.h"
 #include "gui/crvgui.h"
-#include "uniquefiltermodel.h"
+#include "uniqueframemodel.h"
+#include <QtCore/QDataStream>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
-#include <QtGui/QStandardItemModel>
+#include <QtCore/QTimer>
 #include <QtSerialBus/QCanBusFrame>
+#include <algorithm>
+#include <cmath>
 #include <log.h>
 #include <memory>
 
@@ -23,16 +33,32 @@ public:
         , _columnsOrder({ "rowID", "timeDouble", "time", "idInt", "id", "dir", "dlc", "data" })
         , q_ptr(q)
     {
-        _tvModel.setHorizontalHeaderLabels(_columnsOrder);
-
+        // GUI is constructed lazily
         _ui.initTableView(_tvModel);
-        _uniqueModel.setSourceModel(&_tvModel);
-        _ui.setModel(&_uniqueModel);
+        _ui.initStatsView(_statsModel);
 
         _ui.setClearCbk(std::bind(&CanRawViewPrivate::clear, this));
         _ui.setSectionClikedCbk(std::bind(&CanRawViewPrivate::sort, this, std::placeholders::_1));
         _ui.setFilterCbk(std::bind(&CanRawViewPrivate::setFilter, this));
         _ui.setDockUndockCbk([this] { docked = !docked; });
+        _ui.setShowCbk(std::bind(&CanRawViewPrivate::refreshView, this));
+        _ui.setSearchCbk(
+            std::bind(&CanRawViewPrivate::search, this, std::placeholders::_1, std::placeholders::_2));
+        _ui.setExportCbk(std::bind(&CanRawViewPrivate::startExport, this, std::placeholders::_1));
+        _ui.setCancelExportCbk(std::bind(&CanRawViewPrivate::cancelExport, this));
+        _ui.setStatisticsCbk(std::bind(&CanRawViewPrivate::showStatistics, this, std::placeholders::_1));
+
+        _refreshTimer.setSingleShot(true);
+        connect(&_refreshTimer, &QTimer::timeout, this, &CanRawViewPrivate::refreshTick);
+
+        _exportTimer.setInterval(kExportInterval);
+        connect(&_exportTimer, &QTimer::timeout, this, &CanRawViewPrivate::exportTick);
+
+        _statsTimer.setInterval(kStatsInterval);
+        connect(&_statsTimer, &QTimer::timeout, this, &CanRawViewPrivate::statsTick);
+
+        updateCapacity();
+        updateRefreshInterval();
     }
 
     ~CanRawViewPrivate()
@@ -42,65 +68,280 @@ public:
     void saveSettings(QJsonObject& json)
     {
         QJsonObject jSortingObject;
-        QJsonArray viewModelsArray;
 
         writeColumnsOrder(json);
         writeSortingRules(jSortingObject);
         json["sorting"] = std::move(jSortingObject);
         json["scrolling"] = _ui.isViewFrozen();
-        writeViewModel(viewModelsArray);
-        json["models"] = std::move(viewModelsArray);
+        json["maxRows"] = static_cast<double>(_maxRows);
+        json["maxMemoryMB"] = _maxMemoryMB;
+        json["spillToDisk"] = _spillToDisk;
+        json["refreshRate"] = _refreshRate;
+        json["overloadRate"] = _overloadRate;
+    }
+
+    void loadSettings(const QJsonObject& json)
+    {
+        if (json.contains("maxRows")) {
+            _maxRows = static_cast<quint64>(std::max(json["maxRows"].toVariant().toLongLong(), 0LL));
+        }
+
+        if (json.contains("maxMemoryMB")) {
+            _maxMemoryMB = std::max(json["maxMemoryMB"].toVariant().toInt(), 0);
+        }
+
+        if (json.contains("spillToDisk")) {
+            _spillToDisk = json["spillToDisk"].toBool();
+        }
+
+        if (json.contains("refreshRate")) {
+            const int refreshRate = json["refreshRate"].toVariant().toInt();
+
+            if ((refreshRate >= kMinRefreshRate) && (refreshRate <= kMaxRefreshRate)) {
+                _refreshRate = refreshRate;
+            } else {
+                cds_warn("Refresh rate {} out of range {}-{}", refreshRate, kMinRefreshRate, kMaxRefreshRate);
+            }
+        }
+
+        if (json.contains("overloadRate")) {
+            _overloadRate = std::max(json["overloadRate"].toVariant().toInt(), 0);
+        }
+
+        if (json.contains("scrolling")) {
+            _ui.setViewFrozen(json["scrolling"].toBool());
+        }
+
+        if (json.contains("sorting")) {
+            readSortingRules(json["sorting"].toObject());
+        }
+
+        // Sorting restored above may not be available with spilling enabled
+        updateCapacity();
+        updateRefreshInterval();
+    }
+
+    bool hasData() const
+    {
+        return _dataLoader || !_dataFile.isEmpty() || (_tvModel.store().size() > 0);
+    }
+
+    /**
+     * @brief saveData
+     *
+     * Captured frames are stored in a capture file separate from settings. If the file was saved before, only frames
+     * captured since then are appended, even if older frames were already removed from memory. Data file that was
+     * never loaded is copied unchanged, only if it is saved to another location.
+     *
+     * @param fileName path to capture file
+     * @return true on success
+     */
+    bool saveData(const QString& fileName)
+    {
+        if (!_dataFile.isEmpty()) {
+            // Paths may differ in form only, and the file must not be removed before copying it onto itself
+            if (QFileInfo(fileName) == QFileInfo(_dataFile)) {
+                return true;
+            }
+
+            QFile::remove(fileName);
+
+            if (!QFile::copy(_dataFile, fileName)) {
+                cds_error("Could not copy '{}' to '{}'", _dataFile.toStdString(), fileName.toStdString());
+                return false;
+            }
+
+            _dataFile = fileName;
+            return true;
+        }
+
+        loadPendingData();
+
+        return _captureFile.save(_tvModel.store(), fileName);
+    }
+
+    /**
+     * @brief loadPendingData
+     *
+     * Loads data file set by setDataFile or data set by setDataLoader, if any
+     */
+    void loadPendingData()
+    {
+        if (_dataLoader) {
+            readViewData(_dataLoader());
+            _dataLoader = nullptr;
+        }
+
+        if (!_dataFile.isEmpty()) {
+            const quint64 first = _tvModel.store().size();
+
+            _captureFile.load(_tvModel.store(), _dataFile,
+                [this](qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length) {
+                    return updateUniques(timeUs, id, flags, payload, length);
+                });
+            _dataFile.clear();
+            framesLoaded(first);
+        }
     }
 
-    void frameView(const QCanBusFrame& frame, const QString& direction)
+    void frameView(const QCanBusFrame& frame, bool tx)
     {
         if (!_simStarted) {
             cds_debug("send/received frame while simulation stopped");
             return;
         }
 
-        auto payHex = frame.payload().toHex();
-        // insert space between bytes, skip the end
-        for (int ii = payHex.size() - 2; ii >= 2; ii -= 2) {
-            payHex.insert(ii, ' ');
+        // Only raw frame data is stored. Cells are formatted by the model when displayed.
+        const qint64 timeUs = _timer.nsecsElapsed() / 1000;
+        const quint8 flags = FrameStore::frameFlags(frame, tx);
+        const QByteArray& payload = frame.payload();
+
+        if (isElided(timeUs)) {
+            // Statistics and the newest frame of each ID stay exact, elided frame has no row ID
+            _uniqueModel.update(
+                FrameState::kNotStored, timeUs, frame.frameId(), flags, payload.constData(), payload.size());
+            ++_elidedCount;
+        } else {
+            // Changed payload bytes come from the table of newest frames, so the frame is compared only once
+            _tvModel.append(
+                timeUs, frame, tx, updateUniques(timeUs, frame.frameId(), flags, payload.constData(), payload.size()));
+            _search.add(_tvModel.store(), _tvModel.store().size() - 1);
         }
 
-        QList<QVariant> qvList;
-        QList<QStandardItem*> list;
+        // Frames are committed to the model in batches, at most refreshRate times per second
+        if (!_refreshTimer.isActive()) {
+            _refreshTimer.start();
+        }
+    }
 
-        int frameID = frame.frameId();
-        double time = _timer.elapsed() / 1000.0;
+private:
+    /**
+     * @brief isElided
+     *
+     * Checks if frame is left out of the table of all frames. Frame rate is measured in one second windows. While it
+     * is above overload rate, only every Nth frame is stored, so that the table grows at about overload rate. Elided
+     * frames are not searched, exported nor saved.
+     *
+     * @param timeUs capture time in microseconds
+     * @return true if frame is not stored
+     */
+    bool isElided(qint64 timeUs)
+    {
+        if (_overloadRate <= 0) {
+            return false;
+        }
 
-        qvList.append(_rowID++);
-        qvList.append(std::move(time));
-        qvList.append(QString::number(time, 'f', 2));
-        qvList.append(std::move(frameID));
-        qvList.append(QString("0x" + QString::number(frameID, 16)));
-        qvList.append(direction);
-        qvList.append(QString::number(frame.payload().size()).toInt());
-        qvList.append(QString::fromUtf8(payHex.data(), payHex.size()));
+        const qint64 elapsedUs = timeUs - _rateWindowUs;
 
-        for (QVariant qvitem : qvList) {
-            QStandardItem* item = new QStandardItem();
-            item->setData(qvitem, Qt::DisplayRole);
-            list.append(item);
+        ++_rateWindowCount;
+
+        if (elapsedUs >= kRateWindowUs) {
+            // Measured rate divided by overload rate, rounded up
+            const double ratio = _rateWindowCount * 1000000.0 / elapsedUs / _overloadRate;
+
+            _stride = (ratio > 1) ? static_cast<quint64>(std::ceil(ratio)) : 1;
+            _rateWindowUs = timeUs;
+            _rateWindowCount = 0;
         }
 
-        _tvModel.appendRow(list);
+        if (++_strideCount < _stride) {
+            return true;
+        }
 
-        // Sort after reception of each frame and appending it to _tvModel
-        _currentSortOrder = _ui.getSortOrder();
-        int currentSortIndicator = _ui.getSortSection();
-        _ui.setSorting(_sortIndex, currentSortIndicator, _currentSortOrder);
+        _strideCount = 0;
 
-        _uniqueModel.updateFilter(frameID, time, direction);
+        return false;
+    }
+
+    /**
+     * @brief updatePresentation
+     *
+     * Scrolls the view. Called once per refresh, not per frame. Models keep rows sorted themselves.
+     */
+    void updatePresentation()
+    {
+        _ui.setEvictedCount(_tvModel.evictedCount());
+        _ui.setElidedCount(_elidedCount);
 
         if (!_ui.isViewFrozen()) {
             _ui.scrollToBottom();
         }
     }
 
-private:
+    void updateRefreshInterval()
+    {
+        _refreshTimer.setInterval(1000 / _refreshRate);
+    }
+
+    /**
+     * @brief updateCapacity
+     *
+     * History is limited by number of rows and by memory, whichever is lower. Memory limit assumes classic CAN
+     * payloads. When spilling to disk is enabled, memory limit applies to frames kept in memory only and older frames
+     * go to a temporary file.
+     */
+    void updateCapacity()
+    {
+        quint64 capacity = _maxRows;
+        const quint64 memoryRows = static_cast<quint64>(_maxMemoryMB) * 1024 * 1024 / FrameStore::kFrameSize;
+
+        if (_spillToDisk) {
+            const int chunks = static_cast<int>(memoryRows / FrameStore::kChunkSize);
+            _tvModel.store().setResidentChunks(std::max(chunks, kMinResidentChunks));
+        } else {
+            _tvModel.store().setResidentChunks(0);
+
+            if (_maxMemoryMB > 0) {
+                capacity = (capacity > 0) ? std::min(capacity, memoryRows) : memoryRows;
+            }
+        }
+
+        _tvModel.setCapacity(capacity);
+        restrictSorting();
+    }
+
+    /**
+     * @brief restrictSorting
+     *
+     * Rows sorted by other column than row ID or time are ordered by a sort index that keeps every stored frame in
+     * memory, frames moved to disk included. Such sorting is switched back to row ID while spilling is enabled.
+     *
+     * @return true if sorting was switched
+     */
+    bool restrictSorting()
+    {
+        if (!_spillToDisk || (_sortIndex <= FrameModel::Time)) {
+            return false;
+        }
+
+        _ui.setSorting(0, 0, Qt::AscendingOrder);
+        _ui.setStatus("Sorting by this column is not available while frames are moved to disk");
+        _prevIndex = 0;
+        _sortIndex = 0;
+        _currentSortOrder = Qt::AscendingOrder;
+
+        return true;
+    }
+
+    void readSortingRules(const QJsonObject& json)
+    {
+        const int prevIndex = json["prevIndex"].toInt();
+        const int sortIndex = json["sortIndex"].toInt();
+        const auto order = static_cast<Qt::SortOrder>(json["currentSortOrder"].toInt());
+
+        if ((prevIndex < 0) || (prevIndex >= _columnsOrder.size()) || (sortIndex < 0)
+            || (sortIndex >= FrameModel::ColumnCount)
+            || ((order != Qt::AscendingOrder) && (order != Qt::DescendingOrder))) {
+            cds_warn("Incorrect sorting rules");
+            return;
+        }
+
+        _prevIndex = prevIndex;
+        _sortIndex = sortIndex;
+        _currentSortOrder = order;
+        _ui.setSorting(_sortIndex, _prevIndex, _currentSortOrder);
+    }
+
     void writeSortingRules(QJsonObject& json) const
     {
         json["prevIndex"] = _prevIndex;
@@ -121,30 +362,154 @@ private:
         json["columns"] = std::move(columnList);
     }
 
-    void writeViewModel(QJsonArray& jsonArray) const
+    void readViewData(const QByteArray& data)
     {
-        for (auto row = 0; row < _tvModel.rowCount(); ++row) {
-            QJsonArray lineIter;
-            for (auto column = 0; column < _tvModel.columnCount(); ++column) {
-                if (_ui.isColumnHidden(column) == false) {
-                    auto pp = _tvModel.data(_tvModel.index(row, column));
-                    lineIter.append(std::move(pp.toString()));
+        FrameStore& store = _tvModel.store();
+        const quint64 first = store.size();
+        QDataStream in(data);
+        quint32 version = 0;
+
+        in >> version;
+
+        if (version == kCellViewDataVersion) {
+            readCellViewData(in);
+        } else if (version == kViewDataVersion) {
+            quint64 count = 0;
+            in >> count;
+
+            for (quint64 i = 0; (i < count) && (in.status() == QDataStream::Ok); ++i) {
+                qint64 timeUs = 0;
+                quint32 id = 0;
+                quint8 flags = 0;
+                char* payload = nullptr;
+                uint length = 0;
+
+                in >> timeUs >> id >> flags;
+                in.readBytes(payload, length);
+
+                if (in.status() == QDataStream::Ok) {
+                    const int size = static_cast<int>(length);
+
+                    store.append(timeUs, id, flags, payload, size, updateUniques(timeUs, id, flags, payload, size));
                 }
+
+                delete[] payload;
+            }
+        } else {
+            cds_warn("Unsupported view data (version {})", version);
+            return;
+        }
+
+        if (in.status() != QDataStream::Ok) {
+            cds_warn("View data corrupted");
+        }
+
+        framesLoaded(first);
+    }
+
+    /**
+     * @brief framesLoaded
+     *
+     * Updates models with frames added directly to the store. Table of newest frames is updated while frames are
+     * added, see updateUniques.
+     *
+     * @param first index of the first added frame
+     */
+    void framesLoaded(quint64 first)
+    {
+        const FrameStore& store = _tvModel.store();
+
+        for (quint64 i = first; i < store.size(); ++i) {
+            _search.add(store, i);
+        }
+
+        _tvModel.reset();
+        updateCapacity();
+    }
+
+    /**
+     * @brief readCellViewData
+     *
+     * Reads data saved by versions storing every table cell
+     *
+     * @param in data stream positioned after version
+     */
+    void readCellViewData(QDataStream& in)
+    {
+        FrameStore& store = _tvModel.store();
+        int rows = 0;
+        int columns = 0;
+
+        in >> rows >> columns;
+
+        if (columns != FrameModel::ColumnCount) {
+            cds_warn("Unsupported view data (columns {})", columns);
+            return;
+        }
+
+        for (auto row = 0; (row < rows) && (in.status() == QDataStream::Ok); ++row) {
+            QVariantList cells;
+
+            for (auto column = 0; column < columns; ++column) {
+                QVariant value;
+                in >> value;
+                cells.append(value);
             }
-            jsonArray.append(std::move(lineIter));
+
+            const qint64 timeUs = qRound64(cells[FrameModel::TimeDouble].toDouble() * 1000000);
+            const quint32 id = cells[FrameModel::IdInt].toUInt();
+            const QString direction = cells[FrameModel::Dir].toString();
+            const QByteArray payload = QByteArray::fromHex(cells[FrameModel::Data].toString().toLatin1());
+
+            const quint8 flags = (direction == "TX") ? FrameStore::Tx : 0;
+
+            store.append(timeUs, id, flags, payload.constData(), payload.size(),
+                updateUniques(timeUs, id, flags, payload.constData(), payload.size()));
         }
     }
 
+    /**
+     * @brief updateUniques
+     *
+     * Updates table of newest frames with a frame that is about to be stored
+     *
+     * @return payload bytes that differ from the previous frame of the same ID and direction
+     */
+    quint64 updateUniques(qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length)
+    {
+        const FrameStore& store = _tvModel.store();
+
+        return _uniqueModel.update(store.firstSeq() + store.size(), timeUs, id, flags, payload, length);
+    }
+
 private slots:
     /**
      * @brief clear
      *
-     * This function is used to clear data and filter models
+     * This function is used to clear frame and unique frame models
      */
     void clear()
     {
-        _tvModel.removeRows(0, _tvModel.rowCount());
-        _uniqueModel.clearFilter();
+        if (_exporter) {
+            cds_warn("Export cancelled, frames cleared");
+            cancelExport();
+        }
+
+        _tvModel.clear();
+        _uniqueModel.clear();
+        _statsModel.refresh();
+        _search.clear();
+        _searchResults.clear();
+        _searchShown = false;
+        // Data from previous session will not be needed anymore
+        _dataLoader = nullptr;
+        _dataFile.clear();
+        _captureFile.reset();
+        _elidedCount = 0;
+        _stride = 1;
+        _strideCount = 0;
+        _rateWindowUs = 0;
+        _rateWindowCount = 0;
     }
 
     void sort(const int clickedIndex)
@@ -157,6 +522,12 @@ private slots:
             _sortIndex = _sortIndex - 1;
         }
 
+        if (restrictSorting()) {
+            return;
+        }
+
+        _ui.setStatus({});
+
         if (_prevIndex == clickedIndex) {
             if (_currentSortOrder == Qt::DescendingOrder) {
                 _ui.setSorting(_sortIndex, clickedIndex, Qt::DescendingOrder);
@@ -173,24 +544,271 @@ private slots:
 
     void setFilter()
     {
-        _uniqueModel.toggleFilter();
+        _filterActive = !_filterActive;
+
+        if (_filterActive) {
+            _ui.setModel(&_uniqueModel);
+        } else {
+            _ui.setModel(&_tvModel);
+        }
+
+        // Models keep their own order
+        _ui.setSorting(_sortIndex, _ui.getSortSection(), _ui.getSortOrder());
+        updatePresentation();
+    }
+
+    /**
+     * @brief search
+     *
+     * Shows next or previous frame matching the query, in order of capture. Matches are looked up again only if the
+     * query or captured frames changed since last search.
+     *
+     * @param query query as described in FrameSearch
+     * @param backward true to show previous match
+     */
+    void search(const QString& query, bool backward)
+    {
+        if (_filterActive) {
+            _ui.setSearchStatus("Search is not available in combined view");
+            return;
+        }
+
+        if (query != _search.query()) {
+            if (!_search.setQuery(query)) {
+                _ui.setSearchStatus("Incorrect query");
+                return;
+            }
+
+            _searchResults.clear();
+            _searchShown = false;
+        }
+
+        // Matches are shown in the table, so all captured frames need to be there
+        _tvModel.commit();
+        _search.evict(_tvModel.store());
+        updatePresentation();
+
+        const FrameStore& store = _tvModel.store();
+        const quint64 end = store.firstSeq() + store.size();
+
+        if (!_searchShown || (_searchFirst != store.firstSeq()) || (_searchEnd != end)) {
+            _searchResults = _search.find(store);
+            _searchFirst = store.firstSeq();
+            _searchEnd = end;
+        }
+
+        if (_searchResults.empty()) {
+            _ui.setSearchStatus("No matches");
+            return;
+        }
+
+        auto it = backward ? _searchResults.end() - 1 : _searchResults.begin();
+
+        if (_searchShown && backward) {
+            it = std::lower_bound(_searchResults.begin(), _searchResults.end(), _searchSeq);
+            it = (it == _searchResults.begin()) ? _searchResults.end() - 1 : it - 1;
+        } else if (_searchShown) {
+            it = std::upper_bound(_searchResults.begin(), _searchResults.end(), _searchSeq);
+            it = (it == _searchResults.end()) ? _searchResults.begin() : it;
+        }
+
+        _searchSeq = *it;
+        _searchShown = true;
+        _ui.setSearchStatus(QString("%1 of %2").arg(it - _searchResults.begin() + 1).arg(_searchResults.size()));
+        _ui.showRow(_tvModel.row(_searchSeq));
+    }
+
+    /**
+     * @brief startExport
+     *
+     * Starts export of frames captured so far. Frames are copied to the exporter in slices on export timer ticks, so
+     * capture goes on while the file is written. Frames evicted before their turn are skipped. Failure to write the
+     * file is reported in the status line.
+     *
+     * @param fileName exported file, format is chosen by extension
+     */
+    void startExport(const QString& fileName)
+    {
+        if (_exporter) {
+            return;
+        }
+
+        const FrameStore& store = _tvModel.store();
+
+        _exporter = std::make_unique<FrameExporter>(fileName, FrameExporter::formatFromFileName(fileName));
+        _exportNext = store.firstSeq();
+        _exportEnd = store.firstSeq() + store.size();
+        _exportTotal = std::max<quint64>(store.size(), 1);
+        _exportSlice.clear();
+        _exporter->start();
+        _exportTimer.start();
+        _ui.setExportProgress(0);
+        _ui.setStatus({});
+    }
+
+    void cancelExport()
+    {
+        if (_exporter) {
+            _exportTimer.stop();
+            _exporter->cancel();
+            _exporter.reset();
+            _exportSlice.clear();
+            _ui.setExportProgress(-1);
+        }
+    }
+
+    void exportTick()
+    {
+        const FrameStore& store = _tvModel.store();
+
+        _exportNext = std::max(_exportNext, store.firstSeq());
+
+        if (_exportSlice.empty() && (_exportNext < _exportEnd)) {
+            const quint64 count = std::min(kExportSliceSize, _exportEnd - _exportNext);
+
+            FrameExporter::copy(_exportSlice, store, _exportNext - store.firstSeq(), count);
+            _exportNext += count;
+        }
+
+        if (!_exportSlice.empty() && !_exporter->trySubmit(_exportSlice)) {
+            // Writer is busy, slice is submitted on next tick
+            return;
+        }
+
+        // Remaining frames are not copied once the file could not be written
+        if ((_exportNext < _exportEnd) && !_exporter->hasError()) {
+            _ui.setExportProgress(static_cast<int>(100 * _exporter->framesWritten() / _exportTotal));
+            return;
+        }
+
+        _exportTimer.stop();
+        _exporter->finish();
+
+        if (_exporter->hasError()) {
+            _ui.setStatus("Export failed, file could not be written");
+        } else {
+            cds_info("Exported {} frames", _exporter->framesWritten());
+        }
+
+        _exporter.reset();
+        _ui.setExportProgress(-1);
+    }
+
+    /**
+     * @brief showStatistics
+     *
+     * Statistics are kept up to date with every frame, but the table is refreshed on a slow timer only while it is
+     * shown.
+     *
+     * @param visible true if statistics table is shown
+     */
+    void showStatistics(bool visible)
+    {
+        if (visible) {
+            _statsModel.refresh();
+            _statsTimer.start();
+        } else {
+            _statsTimer.stop();
+        }
+    }
+
+    void statsTick()
+    {
+        if (_ui.isVisible()) {
+            _statsModel.refresh();
+        }
+    }
+
+    /**
+     * @brief refreshView
+     *
+     * This function brings the view up to date with data collected while it was hidden
+     */
+    void refreshView()
+    {
+        loadPendingData();
+        _tvModel.commit();
+        _uniqueModel.commit();
+
+        if (_statsTimer.isActive()) {
+            _statsModel.refresh();
+        }
+
+        updatePresentation();
+    }
+
+    /**
+     * @brief refreshTick
+     *
+     * Commits frames received since last tick. Presentation is skipped while nobody looks at the view, it is
+     * refreshed on show.
+     */
+    void refreshTick()
+    {
+        const bool framesChanged = _tvModel.commit();
+        const bool uniquesChanged = _uniqueModel.commit();
+
+        if (framesChanged) {
+            _search.evict(_tvModel.store());
+        }
+
+        if ((framesChanged || uniquesChanged) && _ui.isVisible()) {
+            updatePresentation();
+        }
     }
 
 public:
     CanRawViewCtx _ctx;
     QElapsedTimer _timer;
-    QStandardItemModel _tvModel;
-    UniqueFilterModel _uniqueModel;
+    FrameModel _tvModel;
+    UniqueFrameModel _uniqueModel;
+    FrameStatsModel _statsModel{ _uniqueModel.states() };
     bool _simStarted;
     CRVGuiInterface& _ui;
     bool docked{ true };
+    std::function<QByteArray()> _dataLoader;
+    QString _dataFile; // capture file that has not been loaded yet
 
 private:
-    int _rowID{ 0 };
+    static constexpr quint32 kCellViewDataVersion = 1;
+    static constexpr quint32 kViewDataVersion = 2;
+    static constexpr int kMinRefreshRate = 1;
+    static constexpr int kMaxRefreshRate = 100;
+    static constexpr int kMinResidentChunks = 2;
+    static constexpr int kExportInterval = 5;
+    static constexpr quint64 kExportSliceSize = 32768;
+    static constexpr int kStatsInterval = 500;
+    static constexpr qint64 kRateWindowUs = 1000000;
+    QTimer _refreshTimer;
+    int _refreshRate{ 30 };
+    quint64 _maxRows{ 0 };
+    int _maxMemoryMB{ 256 };
+    bool _spillToDisk{ false };
+    int _overloadRate{ 0 }; // frames per second, 0 to store all frames
+    quint64 _elidedCount{ 0 };
+    quint64 _stride{ 1 };
+    quint64 _strideCount{ 0 };
+    qint64 _rateWindowUs{ 0 }; // start of rate measurement window
+    quint64 _rateWindowCount{ 0 };
     int _prevIndex{ 0 };
     int _sortIndex{ 0 };
     Qt::SortOrder _currentSortOrder{ Qt::AscendingOrder };
     QStringList _columnsOrder;
+    bool _filterActive{ false };
+    FrameSearch _search;
+    CaptureFile _captureFile;
+    std::vector<quint64> _searchResults;
+    quint64 _searchFirst{ 0 };
+    quint64 _searchEnd{ 0 };
+    quint64 _searchSeq{ 0 }; // last shown match
+    bool _searchShown{ false };
+    std::unique_ptr<FrameExporter> _exporter;
+    FrameExporter::slice_t _exportSlice;
+    QTimer _exportTimer;
+    quint64 _exportNext{ 0 };
+    quint64 _exportEnd{ 0 };
+    quint64 _exportTotal{ 1 };
+    QTimer _statsTimer;
     CanRawView* q_ptr;
 };
 #endif // CANRAWVIEW_P_H
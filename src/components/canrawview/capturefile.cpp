@@ -0,0 +1,192 @@
+#include "capturefile.h"
+#include "framestore.h"
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <log.h>
+
+namespace {
+const int kHeaderSize = 8;
+const int kRecordHeaderSize = 14;
+const int kMaxPayload = 64;
+const int kBlockSize = 1024 * 1024;
+}
+
+constexpr quint32 CaptureFile::kMagic;
+constexpr quint32 CaptureFile::kVersion;
+
+bool CaptureFile::save(const FrameStore& store, const QString& fileName)
+{
+    const quint64 endSeq = store.firstSeq() + store.size();
+
+    // File may still hold frames already removed from the store, but there must be no gap between file and store.
+    // File must not have been modified by anybody else.
+    if (!_fileName.isEmpty() && (QFileInfo(fileName) == QFileInfo(_fileName)) && (_firstSeq <= store.firstSeq())
+        && (store.firstSeq() <= _endSeq) && (_endSeq <= endSeq) && (QFileInfo(fileName).size() == _fileSize)) {
+        return append(store, fileName);
+    }
+
+    return replace(store, fileName);
+}
+
+bool CaptureFile::load(FrameStore& store, const QString& fileName, const ChangedBytes& changedBytes)
+{
+    QFile file(fileName);
+    const bool mirrored = (store.size() == 0);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        cds_error("Could not open file '{}'", fileName.toStdString());
+        return false;
+    }
+
+    const QByteArray header = file.read(kHeaderSize);
+    const uchar* h = reinterpret_cast<const uchar*>(header.constData());
+
+    if ((header.size() != kHeaderSize) || (qFromLittleEndian<quint32>(h) != kMagic)
+        || (qFromLittleEndian<quint32>(h + 4) != kVersion)) {
+        cds_warn("Unsupported capture file '{}'", fileName.toStdString());
+        return false;
+    }
+
+    QByteArray buffer;
+    bool ok = true;
+
+    while (ok) {
+        const QByteArray block = file.read(kBlockSize);
+
+        if (block.isEmpty()) {
+            break;
+        }
+
+        // Record split between blocks stays in buffer
+        buffer.append(block);
+
+        int pos = 0;
+
+        while (buffer.size() - pos >= kRecordHeaderSize) {
+            const uchar* p = reinterpret_cast<const uchar*>(buffer.constData() + pos);
+            const int length = p[13];
+
+            if (length > kMaxPayload) {
+                ok = false;
+                break;
+            }
+
+            if (buffer.size() - pos < kRecordHeaderSize + length) {
+                break;
+            }
+
+            const qint64 timeUs = qFromLittleEndian<qint64>(p);
+            const quint32 id = qFromLittleEndian<quint32>(p + 8);
+            const char* payload = reinterpret_cast<const char*>(p + kRecordHeaderSize);
+
+            store.append(timeUs, id, p[12], payload, length,
+                changedBytes ? changedBytes(timeUs, id, p[12], payload, length) : 0);
+            pos += kRecordHeaderSize + length;
+        }
+
+        buffer.remove(0, pos);
+    }
+
+    if (!ok || !buffer.isEmpty()) {
+        cds_warn("Capture file '{}' corrupted", fileName.toStdString());
+        return false;
+    }
+
+    if (mirrored) {
+        _fileName = fileName;
+        _firstSeq = store.firstSeq();
+        _endSeq = store.firstSeq() + store.size();
+        _fileSize = file.size();
+    }
+
+    return true;
+}
+
+void CaptureFile::reset()
+{
+    _fileName.clear();
+}
+
+bool CaptureFile::append(const FrameStore& store, const QString& fileName)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        cds_error("Could not open file '{}'", fileName.toStdString());
+        reset();
+        return false;
+    }
+
+    if (!write(file, store, _endSeq - store.firstSeq())) {
+        cds_error("Failed to write '{}': {}", fileName.toStdString(), file.errorString().toStdString());
+        reset();
+        return false;
+    }
+
+    _endSeq = store.firstSeq() + store.size();
+    _fileSize = file.size();
+
+    return true;
+}
+
+bool CaptureFile::replace(const FrameStore& store, const QString& fileName)
+{
+    QSaveFile file(fileName);
+    QByteArray header(kHeaderSize, '\0');
+    uchar* h = reinterpret_cast<uchar*>(header.data());
+
+    reset();
+    qToLittleEndian<quint32>(kMagic, h);
+    qToLittleEndian<quint32>(kVersion, h + 4);
+
+    if (!file.open(QIODevice::WriteOnly) || (file.write(header) != header.size()) || !write(file, store, 0)
+        || !file.commit()) {
+        cds_error("Failed to write '{}': {}", fileName.toStdString(), file.errorString().toStdString());
+        return false;
+    }
+
+    _fileName = fileName;
+    _firstSeq = store.firstSeq();
+    _endSeq = store.firstSeq() + store.size();
+    _fileSize = QFileInfo(fileName).size();
+
+    return true;
+}
+
+template <typename File>
+bool CaptureFile::write(File& file, const FrameStore& store, quint64 first)
+{
+    QByteArray buffer;
+
+    // Reserved capacity is kept when buffer is emptied
+    buffer.reserve(kBlockSize + kRecordHeaderSize + kMaxPayload);
+
+    for (quint64 i = first; i < store.size(); ++i) {
+        const int length = std::min(store.length(i), kMaxPayload);
+        const int start = buffer.size();
+
+        buffer.resize(start + kRecordHeaderSize + length);
+
+        uchar* p = reinterpret_cast<uchar*>(buffer.data() + start);
+
+        qToLittleEndian<qint64>(store.timeUs(i), p);
+        qToLittleEndian<quint32>(store.id(i), p + 8);
+        p[12] = store.flags(i);
+        p[13] = static_cast<uchar>(length);
+        std::memcpy(p + kRecordHeaderSize, store.payload(i), static_cast<std::size_t>(length));
+
+        if (buffer.size() >= kBlockSize) {
+            if (file.write(buffer) != buffer.size()) {
+                return false;
+            }
+
+            buffer.resize(0);
+        }
+    }
+
+    return file.write(buffer) == buffer.size();
+}
@@ -0,0 +1,67 @@
+#ifndef CAPTUREFILE_H
+#define CAPTUREFILE_H
+
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+#include <functional>
+
+class FrameStore;
+
+/**
+*   @brief The class provides file holding frames of FrameStore.
+*
+*   File starts with a header (magic "CDSV", version, both 32-bit little endian) followed by records:
+*       qint64  capture time in microseconds
+*       quint32 frame ID
+*       quint8  flags, combination of FrameStore::Flags
+*       quint8  payload length
+*       payload
+*   Number of frames is not stored, so frames can be appended to existing file. The object remembers which frames it
+*   has written. If file is saved again while it still holds all stored frames that were written, only new frames are
+*   appended. Frames removed from the store since then are kept in the file. Otherwise the file is replaced. Frames
+*   are written and read in blocks, so memory use does not depend on number of frames.
+*/
+class CaptureFile {
+public:
+    static constexpr quint32 kMagic = 0x56534443; // "CDSV" in little endian
+    static constexpr quint32 kVersion = 1;
+
+    // Gets payload bytes of a read frame that differ from the previous frame of the same ID and direction
+    using ChangedBytes
+        = std::function<quint64(qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length)>;
+
+    /**
+    *   @brief  Writes stored frames to file
+    *   @param  store frame store
+    *   @param  fileName path to file
+    *   @return true on success, false on failure
+    */
+    bool save(const FrameStore& store, const QString& fileName);
+
+    /**
+    *   @brief  Reads frames from file and appends them to the store
+    *   @param  store frame store
+    *   @param  fileName path to file
+    *   @param  changedBytes called with each frame before it is stored, nothing is marked as changed if not set
+    *   @return true on success, false if file could not be read or is corrupted. Frames read before error are kept.
+    */
+    bool load(FrameStore& store, const QString& fileName, const ChangedBytes& changedBytes = nullptr);
+
+    /**
+    *   @brief  Forgets written frames, so next save replaces the file
+    */
+    void reset();
+
+private:
+    bool append(const FrameStore& store, const QString& fileName);
+    bool replace(const FrameStore& store, const QString& fileName);
+    template <typename File>
+    bool write(File& file, const FrameStore& store, quint64 first);
+
+    QString _fileName; // empty if file does not mirror the store
+    quint64 _firstSeq{ 0 }; // sequence number of the first frame in the file
+    quint64 _endSeq{ 0 }; // sequence number following the last frame in the file
+    qint64 _fileSize{ 0 };
+};
+
+#endif // CAPTUREFILE_H
@@ -0,0 +1,361 @@
+#include "frameexporter.h"
+#include "framestore.h"
+#include <QtCore/QDateTime>
+#include <QtCore/QLocale>
+#include <algorithm>
+#include <cstring>
+#include <hexformat.h>
+#include <log.h>
+
+namespace {
+// Longest line is ASC CAN FD frame with 64 bytes of payload
+const int kMaxLineSize = 512;
+const int kBufferSize = 4 * 1024 * 1024;
+
+char* writeText(char* out, const char* text)
+{
+    const std::size_t length = std::strlen(text);
+
+    std::memcpy(out, text, length);
+
+    return out + length;
+}
+
+char* writeDecimal(char* out, quint64 value, int digits)
+{
+    char buffer[20];
+    int count = 0;
+
+    do {
+        buffer[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    while (count < digits) {
+        buffer[count++] = '0';
+    }
+
+    while (count > 0) {
+        *out++ = buffer[--count];
+    }
+
+    return out;
+}
+
+char* writeTime(char* out, qint64 timeUs, int digits)
+{
+    const quint64 us = static_cast<quint64>(std::max<qint64>(timeUs, 0));
+
+    out = writeDecimal(out, us / 1000000, digits);
+    *out++ = '.';
+
+    return writeDecimal(out, us % 1000000, 6);
+}
+
+char* writeId(char* out, const FrameExporter::Record& record)
+{
+    return HexFormat::writeHex(out, record.id, (record.flags & FrameStore::Extended) ? 8 : 3, true);
+}
+
+char* writePadding(char* out, const char* start, int width)
+{
+    const int count = std::max(width - static_cast<int>(out - start), 1);
+
+    std::memset(out, ' ', static_cast<std::size_t>(count));
+
+    return out + count;
+}
+
+int fdDlc(int length)
+{
+    static const int kLengths[] = { 12, 16, 20, 24, 32, 48, 64 };
+    int dlc = 8;
+
+    if (length <= 8) {
+        return length;
+    }
+
+    for (int size : kLengths) {
+        ++dlc;
+
+        if (length <= size) {
+            break;
+        }
+    }
+
+    return dlc;
+}
+
+char* appendCandump(char* p, const FrameExporter::Record& record)
+{
+    *p++ = '(';
+    p = writeTime(p, record.timeUs, 10);
+    p = writeText(p, ") can0 ");
+    p = writeId(p, record);
+    *p++ = '#';
+
+    if (record.flags & FrameStore::Remote) {
+        *p++ = 'R';
+    } else {
+        if (record.length > 8) {
+            p = writeText(p, "#0");
+        }
+
+        p = HexFormat::writeBytes(p, record.payload.data(), record.length, 0, true);
+    }
+
+    return p;
+}
+
+char* appendAsc(char* p, const FrameExporter::Record& record)
+{
+    const char* direction = (record.flags & FrameStore::Tx) ? "Tx" : "Rx";
+    const char* start = p;
+
+    p = writeTime(p, record.timeUs, 1);
+
+    if (record.length > 8) {
+        p = writeText(p, " CANFD   1 ");
+        p = writeText(p, direction);
+        p = writePadding(p, start, 32);
+        p = writeId(p, record);
+        p = writeText(p, (record.flags & FrameStore::Extended) ? "x" : "");
+        p = writePadding(p, start, 70);
+        p = writeText(p, "1 0 ");
+        p = HexFormat::writeHex(p, static_cast<quint32>(fdDlc(record.length)), 1);
+        *p++ = ' ';
+        p = writeDecimal(p, record.length, 1);
+        *p++ = ' ';
+    } else {
+        p = writeText(p, " 1  ");
+        p = writeId(p, record);
+        p = writeText(p, (record.flags & FrameStore::Extended) ? "x" : "");
+        p = writePadding(p, start, 36);
+        p = writeText(p, direction);
+        p = writeText(p, (record.flags & FrameStore::Remote) ? "   r" : "   d ");
+
+        if (record.flags & FrameStore::Remote) {
+            return p;
+        }
+
+        p = writeDecimal(p, record.length, 1);
+        *p++ = ' ';
+    }
+
+    return HexFormat::writeBytes(p, record.payload.data(), record.length, ' ', true);
+}
+
+char* appendCsv(char* p, const FrameExporter::Record& record)
+{
+    p = writeTime(p, record.timeUs, 1);
+    *p++ = ',';
+    p = writeId(p, record);
+    p = writeText(p, (record.flags & FrameStore::Tx) ? ",TX," : ",RX,");
+    p = writeDecimal(p, record.length, 1);
+    *p++ = ',';
+
+    return HexFormat::writeBytes(p, record.payload.data(), record.length, ' ', true);
+}
+}
+
+FrameExporter::FrameExporter(const QString& fileName, Format format)
+    : _fileName(fileName)
+    , _format(format)
+{
+}
+
+FrameExporter::~FrameExporter()
+{
+    finish();
+}
+
+bool FrameExporter::trySubmit(slice_t& slice)
+{
+    QMutexLocker lock(&_mutex);
+
+    if (_hasPending) {
+        return false;
+    }
+
+    _pending.swap(slice);
+    _hasPending = true;
+    _dataReady.wakeOne();
+
+    return true;
+}
+
+void FrameExporter::finish()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    {
+        QMutexLocker lock(&_mutex);
+        _stop = true;
+        _dataReady.wakeOne();
+    }
+
+    wait();
+}
+
+void FrameExporter::cancel()
+{
+    _cancel = true;
+    finish();
+}
+
+quint64 FrameExporter::framesWritten() const
+{
+    return _framesWritten;
+}
+
+bool FrameExporter::hasError() const
+{
+    return _error;
+}
+
+void FrameExporter::copy(slice_t& slice, const FrameStore& store, quint64 first, quint64 count)
+{
+    const quint64 last = std::min(first + count, store.size());
+
+    slice.resize(static_cast<std::size_t>(std::max(last, first) - first));
+
+    for (quint64 i = first; i < last; ++i) {
+        Record& record = slice[static_cast<std::size_t>(i - first)];
+
+        record.timeUs = store.timeUs(i);
+        record.id = store.id(i);
+        record.flags = store.flags(i);
+        record.length = static_cast<quint8>(std::min(store.length(i), static_cast<int>(record.payload.size())));
+        std::memcpy(record.payload.data(), store.payload(i), record.length);
+    }
+}
+
+QByteArray FrameExporter::fileHeader(Format format)
+{
+    if (format == Format::Csv) {
+        return "time,id,dir,dlc,data\n";
+    }
+
+    if (format == Format::Asc) {
+        const QByteArray date
+            = QLocale::c().toString(QDateTime::currentDateTime(), "ddd MMM dd hh:mm:ss.zzz ap yyyy").toLatin1();
+
+        return "date " + date + "\nbase hex  timestamps absolute\ninternal events logged\nBegin Triggerblock " + date
+            + "\n";
+    }
+
+    return {};
+}
+
+QByteArray FrameExporter::fileFooter(Format format)
+{
+    return (format == Format::Asc) ? "End TriggerBlock\n" : QByteArray();
+}
+
+void FrameExporter::append(QByteArray& out, Format format, const Record& record)
+{
+    const int start = out.size();
+
+    out.resize(start + kMaxLineSize);
+
+    char* p = out.data() + start;
+
+    switch (format) {
+    case Format::Asc:
+        p = appendAsc(p, record);
+        break;
+
+    case Format::Csv:
+        p = appendCsv(p, record);
+        break;
+
+    default:
+        p = appendCandump(p, record);
+        break;
+    }
+
+    *p++ = '\n';
+
+    out.resize(static_cast<int>(p - out.constData()));
+}
+
+FrameExporter::Format FrameExporter::formatFromFileName(const QString& fileName)
+{
+    if (fileName.endsWith(".asc", Qt::CaseInsensitive)) {
+        return Format::Asc;
+    }
+
+    if (fileName.endsWith(".csv", Qt::CaseInsensitive)) {
+        return Format::Csv;
+    }
+
+    return Format::Candump;
+}
+
+void FrameExporter::run()
+{
+    _file.setFileName(_fileName);
+
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        cds_error("Could not open file '{}'", _fileName.toStdString());
+        _error = true;
+    } else {
+        _buffer.reserve(kBufferSize);
+        _buffer.append(fileHeader(_format));
+    }
+
+    forever {
+        slice_t slice;
+
+        {
+            QMutexLocker lock(&_mutex);
+
+            while (!_hasPending && !_stop) {
+                _dataReady.wait(&_mutex);
+            }
+
+            if (!_hasPending || _cancel) {
+                break;
+            }
+
+            slice.swap(_pending);
+            _hasPending = false;
+        }
+
+        write(slice);
+    }
+
+    if (_cancel) {
+        if (_file.isOpen()) {
+            _file.remove();
+        }
+
+        return;
+    }
+
+    _buffer.append(fileFooter(_format));
+    write(slice_t());
+    _file.close();
+}
+
+void FrameExporter::write(const slice_t& slice)
+{
+    if (_error) {
+        return;
+    }
+
+    for (const auto& record : slice) {
+        append(_buffer, _format, record);
+    }
+
+    if (_file.write(_buffer) != _buffer.size()) {
+        cds_error("Failed to write '{}': {}", _fileName.toStdString(), _file.errorString().toStdString());
+        _error = true;
+    }
+
+    // Buffer capacity is kept for next slice
+    _buffer.resize(0);
+    _framesWritten += slice.size();
+}
@@ -0,0 +1,138 @@
+#ifndef FRAMEEXPORTER_H
+#define FRAMEEXPORTER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+#include <array>
+#include <atomic>
+#include <vector>
+
+class FrameStore;
+
+/**
+*   @brief The class provides background thread exporting captured frames to a file.
+*
+*   Frames are passed in slices copied from FrameStore, one slice at a time, so the store is never accessed from the
+*   writer thread and memory use does not depend on number of exported frames. Slices are formatted into a buffer that
+*   is written in one go. Supported formats:
+*       Candump     text format of candump -l, e.g. "(0000000001.500000) can0 123#DEADBEEF"
+*       Asc         Vector ASCII log, CAN FD frames use CANFD lines
+*       Csv         time,id,dir,dlc,data with ID and payload in hexadecimal
+*   Times are written in seconds since capture start.
+*/
+class FrameExporter : public QThread {
+public:
+    enum class Format { Candump, Asc, Csv };
+
+    struct Record {
+        qint64 timeUs;
+        quint32 id;
+        quint8 flags;
+        quint8 length;
+        std::array<char, 64> payload;
+    };
+
+    typedef std::vector<Record> slice_t;
+
+    /**
+    *   @brief  Constructor
+    *   @param  fileName path to exported file
+    *   @param  format file format
+    */
+    FrameExporter(const QString& fileName, Format format);
+    ~FrameExporter();
+
+    /**
+    *   @brief  Passes slice to the writer if previous one has been already taken
+    *   @param  slice frames to be written. On success it is swapped with an empty slice.
+    *   @return true if slice was accepted, false if writer is busy
+    */
+    bool trySubmit(slice_t& slice);
+
+    /**
+    *   @brief  Writes remaining slice and stops the thread
+    */
+    void finish();
+
+    /**
+    *   @brief  Stops the thread as soon as possible and removes the file
+    */
+    void cancel();
+
+    /**
+    *   @brief  Gets number of frames written to the file
+    *   @return number of frames
+    */
+    quint64 framesWritten() const;
+
+    /**
+    *   @brief  Checks if write error occurred
+    *   @return true if file could not be opened or written
+    */
+    bool hasError() const;
+
+    /**
+    *   @brief  Copies stored frames to a slice
+    *   @param  slice output slice, previous content is replaced
+    *   @param  store frame store
+    *   @param  first index of the first copied frame
+    *   @param  count number of frames, limited to the end of the store
+    */
+    static void copy(slice_t& slice, const FrameStore& store, quint64 first, quint64 count);
+
+    /**
+    *   @brief  Gets data to be written at the beginning of the file
+    *   @param  format file format
+    *   @return file header
+    */
+    static QByteArray fileHeader(Format format);
+
+    /**
+    *   @brief  Gets data to be written at the end of the file
+    *   @param  format file format
+    *   @return file footer
+    */
+    static QByteArray fileFooter(Format format);
+
+    /**
+    *   @brief  Formats frame and appends it to buffer
+    *   @param  out buffer
+    *   @param  format file format
+    *   @param  record frame
+    */
+    static void append(QByteArray& out, Format format, const Record& record);
+
+    /**
+    *   @brief  Gets format from file name extension: .asc, .csv or candump for any other
+    *   @param  fileName file name
+    *   @return file format
+    */
+    static Format formatFromFileName(const QString& fileName);
+
+protected:
+    void run() override;
+
+private:
+    void write(const slice_t& slice);
+
+    const QString _fileName;
+    const Format _format;
+
+    QMutex _mutex;
+    QWaitCondition _dataReady;
+    slice_t _pending;
+    bool _hasPending{ false };
+    bool _stop{ false };
+    std::atomic<bool> _cancel{ false };
+
+    QFile _file;
+    QByteArray _buffer;
+    std::atomic<quint64> _framesWritten{ 0 };
+    std::atomic<bool> _error{ false };
+};
+
+#endif // FRAMEEXPORTER_H
@@ -0,0 +1,355 @@
+#include "framemodel.h"
+#include <algorithm>
+#include <functional>
+#include <hexformat.h>
+
+namespace {
+const char* const kColumnNames[] = { "rowID", "timeDouble", "time", "idInt", "id", "dir", "dlc", "data" };
+}
+
+FrameModel::FrameModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void FrameModel::append(qint64 timeUs, const QCanBusFrame& frame, bool tx, quint64 changed)
+{
+    _store.append(timeUs, frame, tx, changed);
+}
+
+bool FrameModel::commit()
+{
+    const quint64 pending = _store.size() - _committed;
+    quint64 excess = ((_capacity > 0) && (_store.size() > _capacity)) ? _store.size() - _capacity : 0;
+
+    if ((pending == 0) && (excess == 0)) {
+        return false;
+    }
+
+    if ((excess > 0) && (_committed > 0)) {
+        const quint64 rows = std::min(excess, _committed);
+
+        if (isIndexed()) {
+            removeIndexed(rows);
+        } else {
+            const int first = (_sortOrder == Qt::AscendingOrder) ? 0 : static_cast<int>(_committed - rows);
+
+            beginRemoveRows(QModelIndex(), first, first + static_cast<int>(rows) - 1);
+            _store.removeFirst(rows);
+            _committed -= rows;
+            endRemoveRows();
+        }
+
+        excess -= rows;
+    }
+
+    // Frames that would be evicted right away are never shown
+    _store.removeFirst(excess);
+
+    if (_store.size() > _committed) {
+        if (isIndexed()) {
+            insertIndexed();
+        } else {
+            const int count = static_cast<int>(_store.size() - _committed);
+            const int first = (_sortOrder == Qt::AscendingOrder) ? static_cast<int>(_committed) : 0;
+
+            beginInsertRows(QModelIndex(), first, first + count - 1);
+            _committed = _store.size();
+            endInsertRows();
+        }
+    }
+
+    return true;
+}
+
+quint64 FrameModel::pendingCount() const
+{
+    return _store.size() - _committed;
+}
+
+int FrameModel::row(quint64 seq) const
+{
+    if ((seq < _store.firstSeq()) || (seq - _store.firstSeq() >= _committed)) {
+        return -1;
+    }
+
+    return rowOf(seq - _store.firstSeq());
+}
+
+void FrameModel::clear()
+{
+    beginResetModel();
+    _store.clear();
+    _committed = 0;
+    rebuildIndex();
+    endResetModel();
+}
+
+void FrameModel::setCapacity(quint64 capacity)
+{
+    _capacity = capacity;
+}
+
+quint64 FrameModel::capacity() const
+{
+    return _capacity;
+}
+
+quint64 FrameModel::evictedCount() const
+{
+    return _store.firstSeq();
+}
+
+FrameStore& FrameModel::store()
+{
+    return _store;
+}
+
+const FrameStore& FrameModel::store() const
+{
+    return _store;
+}
+
+void FrameModel::reset()
+{
+    beginResetModel();
+    _committed = _store.size();
+    rebuildIndex();
+    endResetModel();
+}
+
+void FrameModel::sort(int column, Qt::SortOrder order)
+{
+    if ((column == _sortColumn) && (order == _sortOrder)) {
+        return;
+    }
+
+    emit layoutAboutToBeChanged();
+
+    // Persistent indexes follow their frames
+    const QModelIndexList from = persistentIndexList();
+    std::vector<quint64> indexes;
+
+    for (const auto& index : from) {
+        indexes.push_back(frameIndex(index.row()));
+    }
+
+    _sortColumn = column;
+    _sortOrder = order;
+    rebuildIndex();
+
+    QModelIndexList to;
+
+    for (int i = 0; i < from.size(); ++i) {
+        to.append(this->index(rowOf(indexes[static_cast<std::size_t>(i)]), from[i].column()));
+    }
+
+    changePersistentIndexList(from, to);
+
+    emit layoutChanged();
+}
+
+int FrameModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(_committed);
+}
+
+int FrameModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant FrameModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid()) {
+        return {};
+    }
+
+    if ((role == ChangedRole) && (index.column() == Data)) {
+        return static_cast<qulonglong>(_store.changed(frameIndex(index.row())));
+    }
+
+    if (role != Qt::DisplayRole) {
+        return {};
+    }
+
+    const quint64 row = frameIndex(index.row());
+
+    return cell(index.column(), _store.firstSeq() + row, _store.timeUs(row), _store.id(row), _store.flags(row),
+        _store.payload(row), _store.length(row));
+}
+
+QVariant FrameModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole) && (section >= 0) && (section < ColumnCount)) {
+        return columnName(section);
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+QVariant FrameModel::cell(
+    int column, quint64 seq, qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length)
+{
+    switch (column) {
+    case RowId:
+        return static_cast<qulonglong>(seq);
+
+    case TimeDouble:
+        return timeUs / 1000000.0;
+
+    case Time:
+        return QString::number(timeUs / 1000000.0, 'f', 2);
+
+    case IdInt:
+        return id;
+
+    case Id:
+        return HexFormat::idToString(id);
+
+    case Dir:
+        return QString((flags & FrameStore::Tx) ? "TX" : "RX");
+
+    case Dlc:
+        return length;
+
+    case Data:
+        return HexFormat::bytesToString(payload, length);
+
+    default:
+        return {};
+    }
+}
+
+QString FrameModel::columnName(int column)
+{
+    return kColumnNames[column];
+}
+
+bool FrameModel::isIndexed() const
+{
+    // Row ID and time follow order of arrival
+    return (_sortColumn > Time) && (_sortColumn < ColumnCount);
+}
+
+SortIndex::key_t FrameModel::sortKey(quint64 index) const
+{
+    switch (_sortColumn) {
+    case Dir:
+        return { static_cast<quint64>(_store.flags(index) & FrameStore::Tx), 0 };
+
+    case Dlc:
+        return { static_cast<quint64>(_store.length(index)), 0 };
+
+    case Data: {
+        // Payloads are ordered by first 8 bytes, shorter payload goes first
+        const char* payload = _store.payload(index);
+        const int length = _store.length(index);
+        quint64 bytes = 0;
+
+        for (int i = 0; i < 8; ++i) {
+            bytes = (bytes << 8) | ((i < length) ? static_cast<quint8>(payload[i]) : 0);
+        }
+
+        return { bytes, static_cast<quint64>(length) };
+    }
+
+    default:
+        return { _store.id(index), 0 };
+    }
+}
+
+quint64 FrameModel::frameIndex(int row) const
+{
+    if (isIndexed()) {
+        return _index.seq(static_cast<quint64>(row)) - _store.firstSeq();
+    }
+
+    const quint64 position = static_cast<quint64>(row);
+
+    return (_sortOrder == Qt::AscendingOrder) ? position : _committed - 1 - position;
+}
+
+int FrameModel::rowOf(quint64 index) const
+{
+    if (isIndexed()) {
+        return static_cast<int>(_index.row(sortKey(index), _store.firstSeq() + index));
+    }
+
+    return static_cast<int>((_sortOrder == Qt::AscendingOrder) ? index : _committed - 1 - index);
+}
+
+void FrameModel::rebuildIndex()
+{
+    _index.clear();
+    _index.setDescending(_sortOrder == Qt::DescendingOrder);
+
+    if (isIndexed()) {
+        for (quint64 i = 0; i < _committed; ++i) {
+            _index.push(_index.bucket(sortKey(i)), _store.firstSeq() + i);
+        }
+    }
+}
+
+const FrameModel::batch_t& FrameModel::batch(quint64 first, quint64 last)
+{
+    _batch.clear();
+
+    for (quint64 i = first; i < last; ++i) {
+        _batch.emplace_back(&_index.bucket(sortKey(i)), _store.firstSeq() + i);
+    }
+
+    // Group frames by bucket, frames of a bucket stay in order
+    std::stable_sort(_batch.begin(), _batch.end(), [](const batch_t::value_type& a, const batch_t::value_type& b) {
+        return std::less<SortIndex::Bucket*>()(a.first, b.first);
+    });
+
+    return _batch;
+}
+
+void FrameModel::removeIndexed(quint64 count)
+{
+    const auto& frames = batch(0, count);
+
+    // Evicted frames are the oldest ones of their buckets, so rows of each bucket are contiguous
+    for (auto it = frames.begin(); it != frames.end();) {
+        auto& bucket = *it->first;
+        const auto end = std::find_if(
+            it, frames.end(), [&bucket](const batch_t::value_type& frame) { return frame.first != &bucket; });
+        const quint64 rows = static_cast<quint64>(end - it);
+        const int first = static_cast<int>(_index.row(bucket, 0));
+
+        beginRemoveRows(QModelIndex(), first, first + static_cast<int>(rows) - 1);
+        _index.popFront(bucket, rows);
+        _committed -= rows;
+        endRemoveRows();
+
+        it = end;
+    }
+
+    // Indexed rows refer to frames by sequence number, so frames are dropped once views were notified
+    _store.removeFirst(count);
+}
+
+void FrameModel::insertIndexed()
+{
+    const auto& frames = batch(_committed, _store.size());
+
+    // New frames go to the end of their buckets, so rows of each bucket are contiguous
+    for (auto it = frames.begin(); it != frames.end();) {
+        auto& bucket = *it->first;
+        const auto end = std::find_if(
+            it, frames.end(), [&bucket](const batch_t::value_type& frame) { return frame.first != &bucket; });
+        const quint64 rows = static_cast<quint64>(end - it);
+        const int first = static_cast<int>(_index.row(bucket, bucket.size()));
+
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(rows) - 1);
+        for (auto frame = it; frame != end; ++frame) {
+            _index.push(bucket, frame->second);
+        }
+        _committed += rows;
+        endInsertRows();
+
+        it = end;
+    }
+}
@@ -0,0 +1,145 @@
+#ifndef FRAMEMODEL_H
+#define FRAMEMODEL_H
+
+#include "framestore.h"
+#include "sortindex.h"
+#include <QtCore/QAbstractTableModel>
+#include <utility>
+#include <vector>
+
+class QCanBusFrame;
+
+/**
+*   @brief The class provides table model of captured frames. Frames are kept in FrameStore and cells are formatted
+*          on demand, only for rows that are actually displayed.
+*
+*   Appended frames become rows on commit(), so views are notified once per batch. Number of frames can be limited,
+*   oldest frames are evicted on commit as well. Sort order is maintained incrementally: rows sorted by row ID or time
+*   follow order of arrival, other columns are kept in SortIndex.
+*/
+class FrameModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { RowId, TimeDouble, Time, IdInt, Id, Dir, Dlc, Data, ColumnCount };
+
+    // Data column provides changed payload bytes as qulonglong, see FrameStore::changed()
+    enum Role { ChangedRole = Qt::UserRole };
+
+    explicit FrameModel(QObject* parent = nullptr);
+
+    /**
+    *   @brief  Appends frame at the end of the model. Frame is not visible until commit.
+    *   @param  timeUs capture time in microseconds
+    *   @param  frame captured frame
+    *   @param  tx true if frame was transmitted
+    *   @param  changed payload bytes that differ from the previous frame of the same ID and direction
+    */
+    void append(qint64 timeUs, const QCanBusFrame& frame, bool tx, quint64 changed = 0);
+
+    /**
+    *   @brief  Evicts frames above the limit and turns appended frames into rows. Views are notified with at most one
+    *           removal and one insertion, or one per sort key if rows are sorted by other column than row ID or time.
+    *   @return true if model has changed
+    */
+    bool commit();
+
+    /**
+    *   @brief  Gets number of appended frames waiting for commit
+    *   @return number of frames
+    */
+    quint64 pendingCount() const;
+
+    /**
+    *   @brief  Gets row of a frame in current sort order
+    *   @param  seq frame sequence number
+    *   @return row or -1 if frame was evicted or is not committed yet
+    */
+    int row(quint64 seq) const;
+
+    /**
+    *   @brief  Removes all frames
+    */
+    void clear();
+
+    /**
+    *   @brief  Sets maximum number of frames. Frames above the limit are evicted on next commit.
+    *   @param  capacity number of frames, 0 for no limit
+    */
+    void setCapacity(quint64 capacity);
+    quint64 capacity() const;
+
+    /**
+    *   @brief  Gets number of frames evicted since last clear
+    *   @return number of frames
+    */
+    quint64 evictedCount() const;
+
+    /**
+    *   @brief  Gets storage of frames, e.g. to add frames without model notifications before reset
+    *   @return frame store
+    */
+    FrameStore& store();
+    const FrameStore& store() const;
+
+    /**
+    *   @brief  Notifies views about frames added directly to the store. All frames become visible.
+    */
+    void reset();
+
+    /**
+    *   @brief  Sorts rows. Order is kept while frames are committed and evicted, so it needs to be set only once.
+    *           Frames sharing a value stay in order of arrival.
+    *   @param  column sort column
+    *   @param  order sort order
+    */
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+    *   @brief  Formats table cell of a frame
+    *   @param  column table column
+    *   @param  seq frame sequence number
+    *   @param  timeUs capture time in microseconds
+    *   @param  id frame ID
+    *   @param  flags combination of FrameStore::Flags
+    *   @param  payload payload bytes
+    *   @param  length payload length
+    *   @return cell value
+    */
+    static QVariant cell(
+        int column, quint64 seq, qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length);
+
+    /**
+    *   @brief  Gets name of a column, also used as its header
+    *   @param  column column less than ColumnCount
+    *   @return column name
+    */
+    static QString columnName(int column);
+
+private:
+    typedef std::vector<std::pair<SortIndex::Bucket*, quint64>> batch_t;
+
+    bool isIndexed() const;
+    SortIndex::key_t sortKey(quint64 index) const;
+    quint64 frameIndex(int row) const;
+    int rowOf(quint64 index) const;
+    void rebuildIndex();
+    const batch_t& batch(quint64 first, quint64 last);
+    void removeIndexed(quint64 count);
+    void insertIndexed();
+
+    FrameStore _store;
+    SortIndex _index;
+    batch_t _batch;
+    int _sortColumn{ RowId };
+    Qt::SortOrder _sortOrder{ Qt::AscendingOrder };
+    quint64 _capacity{ 0 };
+    quint64 _committed{ 0 };
+};
+
+#endif // FRAMEMODEL_H
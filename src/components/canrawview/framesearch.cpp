@@ -0,0 +1,281 @@
+#include "framesearch.h"
+#include "framestore.h"
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringList>
+#include <algorithm>
+#include <log.h>
+
+namespace {
+const quint32 kMaxId = std::numeric_limits<quint32>::max();
+const qint64 kMinTime = std::numeric_limits<qint64>::min();
+const qint64 kMaxTime = std::numeric_limits<qint64>::max();
+const int kMaxPattern = 64;
+
+bool parseId(QString str, quint32& value)
+{
+    bool ok = false;
+
+    if (str.startsWith("0x", Qt::CaseInsensitive)) {
+        str.remove(0, 2);
+    }
+
+    value = str.toUInt(&ok, 16);
+
+    return ok && (value <= 0x1fffffff);
+}
+
+bool parseTime(const QString& str, qint64 unbounded, qint64& value)
+{
+    bool ok = true;
+
+    value = str.isEmpty() ? unbounded : qRound64(str.toDouble(&ok) * 1000000);
+
+    return ok;
+}
+
+bool parseNibble(QChar c, quint8& value, quint8& mask)
+{
+    if ((c == 'x') || (c == 'X') || (c == '?')) {
+        value = 0;
+        mask = 0;
+        return true;
+    }
+
+    bool ok = false;
+    value = static_cast<quint8>(QString(c).toUInt(&ok, 16));
+    mask = 0xf;
+
+    return ok;
+}
+}
+
+bool FrameSearch::setQuery(const QString& query)
+{
+    quint32 idFirst = 0;
+    quint32 idLast = kMaxId;
+    qint64 fromUs = kMinTime;
+    qint64 toUs = kMaxTime;
+    std::vector<quint8> value;
+    std::vector<quint8> mask;
+
+    for (const auto& term : query.split(QRegularExpression("\\s+"), QString::SkipEmptyParts)) {
+        const int colon = term.indexOf(':');
+        const QString name = (colon < 0) ? QString("id") : term.left(colon).toLower();
+        const QString arg = term.mid(colon + 1);
+        const int dash = arg.indexOf('-');
+        bool ok = false;
+
+        if (name == "id") {
+            if (dash > 0) {
+                ok = parseId(arg.left(dash), idFirst) && parseId(arg.mid(dash + 1), idLast) && (idFirst <= idLast);
+            } else {
+                ok = parseId(arg, idFirst);
+                idLast = idFirst;
+            }
+        } else if (name == "time") {
+            ok = (dash >= 0) && parseTime(arg.left(dash), kMinTime, fromUs)
+                && parseTime(arg.mid(dash + 1), kMaxTime, toUs) && (fromUs <= toUs);
+        } else if (name == "data") {
+            ok = !arg.isEmpty() && (arg.size() % 2 == 0) && (arg.size() / 2 <= kMaxPattern);
+            value.clear();
+            mask.clear();
+
+            for (int i = 0; ok && (i < arg.size()); i += 2) {
+                quint8 high = 0;
+                quint8 highMask = 0;
+                quint8 low = 0;
+                quint8 lowMask = 0;
+
+                ok = parseNibble(arg[i], high, highMask) && parseNibble(arg[i + 1], low, lowMask);
+                value.push_back(static_cast<quint8>((high << 4) | low));
+                mask.push_back(static_cast<quint8>((highMask << 4) | lowMask));
+            }
+        }
+
+        if (!ok) {
+            cds_warn("Incorrect search term '{}'", term.toStdString());
+            return false;
+        }
+    }
+
+    _query = query;
+    _idFirst = idFirst;
+    _idLast = idLast;
+    _fromUs = fromUs;
+    _toUs = toUs;
+    _value.swap(value);
+    _mask.swap(mask);
+
+    return true;
+}
+
+QString FrameSearch::query() const
+{
+    return _query;
+}
+
+bool FrameSearch::isEmpty() const
+{
+    return (_idFirst == 0) && (_idLast == kMaxId) && (_fromUs == kMinTime) && (_toUs == kMaxTime) && _mask.empty();
+}
+
+void FrameSearch::add(const FrameStore& store, quint64 index)
+{
+    const quint64 seq = store.firstSeq() + index;
+    const quint64 chunk = seq / FrameStore::kChunkSize;
+    const qint64 timeUs = store.timeUs(index);
+    const quint32 id = store.id(index);
+
+    if (_spans.empty()) {
+        _firstChunk = chunk;
+    }
+
+    while (chunk >= _firstChunk + _spans.size()) {
+        _spans.push_back({ kMaxTime, kMinTime, kMaxId, 0 });
+    }
+
+    Span& span = _spans[static_cast<std::size_t>(chunk - _firstChunk)];
+    span.minUs = std::min(span.minUs, timeUs);
+    span.maxUs = std::max(span.maxUs, timeUs);
+    span.minId = std::min(span.minId, id);
+    span.maxId = std::max(span.maxId, id);
+}
+
+void FrameSearch::evict(const FrameStore& store)
+{
+    const quint64 first = store.firstSeq();
+
+    // Costs nothing until the oldest chunk is evicted
+    while (!_spans.empty() && ((_firstChunk + 1) * FrameStore::kChunkSize <= first)) {
+        _spans.pop_front();
+        ++_firstChunk;
+    }
+}
+
+void FrameSearch::clear()
+{
+    _spans.clear();
+    _firstChunk = 0;
+}
+
+std::vector<quint64> FrameSearch::find(const FrameStore& store) const
+{
+    std::vector<quint64> result;
+    const quint64 first = store.firstSeq();
+    const quint64 end = first + store.size();
+    const bool hasIds = (_idFirst > 0) || (_idLast < kMaxId);
+
+    for (quint64 seq = first; seq < end;) {
+        const quint64 chunkEnd = std::min((seq / FrameStore::kChunkSize + 1) * FrameStore::kChunkSize, end);
+        const Span* chunkSpan = span(seq);
+
+        if ((overlap(seq) == None) || (chunkSpan && ((chunkSpan->maxId < _idFirst) || (chunkSpan->minId > _idLast)))) {
+            seq = chunkEnd;
+            continue;
+        }
+
+        if (!hasIds) {
+            for (; seq < chunkEnd; ++seq) {
+                if (matchesCandidate(store, seq)) {
+                    result.push_back(seq);
+                }
+            }
+
+            continue;
+        }
+
+        const std::size_t size = result.size();
+
+        // Indexes of frames with matching ID are replaced with sequence numbers of matching frames
+        store.findIds(seq - first, chunkEnd - first, _idFirst, _idLast, result);
+
+        auto out = result.begin() + static_cast<std::ptrdiff_t>(size);
+
+        for (auto it = out; it != result.end(); ++it) {
+            if (matchesCandidate(store, first + *it)) {
+                *out++ = first + *it;
+            }
+        }
+
+        result.erase(out, result.end());
+        seq = chunkEnd;
+    }
+
+    return result;
+}
+
+bool FrameSearch::matches(const FrameStore& store, quint64 index) const
+{
+    const quint32 id = store.id(index);
+    const qint64 timeUs = store.timeUs(index);
+
+    return (id >= _idFirst) && (id <= _idLast) && (timeUs >= _fromUs) && (timeUs <= _toUs)
+        && matchesPayload(store, index);
+}
+
+const FrameSearch::Span* FrameSearch::span(quint64 seq) const
+{
+    const quint64 chunk = seq / FrameStore::kChunkSize;
+
+    if ((chunk < _firstChunk) || (chunk >= _firstChunk + _spans.size())) {
+        return nullptr;
+    }
+
+    return &_spans[static_cast<std::size_t>(chunk - _firstChunk)];
+}
+
+FrameSearch::Overlap FrameSearch::overlap(quint64 seq) const
+{
+    const Span* chunkSpan = span(seq);
+
+    if (!chunkSpan) {
+        return Partial;
+    }
+
+    if ((chunkSpan->maxUs < _fromUs) || (chunkSpan->minUs > _toUs)) {
+        return None;
+    }
+
+    return ((chunkSpan->minUs >= _fromUs) && (chunkSpan->maxUs <= _toUs)) ? Full : Partial;
+}
+
+bool FrameSearch::matchesPayload(const FrameStore& store, quint64 index) const
+{
+    if (_mask.empty()) {
+        return true;
+    }
+
+    if (store.length(index) < static_cast<int>(_mask.size())) {
+        return false;
+    }
+
+    const char* payload = store.payload(index);
+
+    for (std::size_t i = 0; i < _mask.size(); ++i) {
+        if ((static_cast<quint8>(payload[i]) & _mask[i]) != _value[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FrameSearch::matchesCandidate(const FrameStore& store, quint64 seq) const
+{
+    const quint64 index = seq - store.firstSeq();
+    const Overlap timeOverlap = overlap(seq);
+
+    if (timeOverlap == None) {
+        return false;
+    }
+
+    if (timeOverlap == Partial) {
+        const qint64 timeUs = store.timeUs(index);
+
+        if ((timeUs < _fromUs) || (timeUs > _toUs)) {
+            return false;
+        }
+    }
+
+    return matchesPayload(store, index);
+}
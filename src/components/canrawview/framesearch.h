@@ -0,0 +1,107 @@
+#ifndef FRAMESEARCH_H
+#define FRAMESEARCH_H
+
+#include <QtCore/QString>
+#include <deque>
+#include <limits>
+#include <vector>
+
+class FrameStore;
+
+/**
+*   @brief The class provides search in captured frames.
+*
+*   Time span and ID range of every FrameStore::kChunkSize consecutive frames is recorded while frames are captured.
+*   Queries visit only chunks overlapping the time and ID range. Frames of matching IDs are found in the ID order kept
+*   by FrameStore with each chunk, so cost of queries with ID constraint depends on number of results rather than on
+*   size of the capture. Payload constraint is checked on candidate frames, so query with payload constraint only
+*   scans all frames of the visited chunks.
+*
+*   Query terms are separated with whitespace. Numbers are hexadecimal except for time, 0x prefix is optional:
+*       123                 frame ID, same as id:123
+*       id:100-1ff          inclusive ID range
+*       data:12x4           payload bytes, x or ? matches any nibble, frame must be at least as long as the pattern
+*       time:1.5-3          inclusive time range in seconds, either bound may be omitted
+*/
+class FrameSearch {
+public:
+    /**
+    *   @brief  Parses query
+    *   @param  query query definition
+    *   @return true on success. On failure previous query is kept.
+    */
+    bool setQuery(const QString& query);
+
+    /**
+    *   @brief  Gets query definition
+    *   @return query as set by setQuery
+    */
+    QString query() const;
+
+    /**
+    *   @brief  Checks if query has any constraint
+    *   @return true if query matches all frames
+    */
+    bool isEmpty() const;
+
+    /**
+    *   @brief  Adds stored frame to the index. Frames have to be added in order of storing.
+    *   @param  store frame store
+    *   @param  index index of the frame in the store
+    */
+    void add(const FrameStore& store, quint64 index);
+
+    /**
+    *   @brief  Removes frames older than the oldest stored frame from the index
+    *   @param  store frame store
+    */
+    void evict(const FrameStore& store);
+
+    /**
+    *   @brief  Removes all frames from the index
+    */
+    void clear();
+
+    /**
+    *   @brief  Finds stored frames matching the query
+    *   @param  store frame store
+    *   @return ascending sequence numbers of matching frames
+    */
+    std::vector<quint64> find(const FrameStore& store) const;
+
+    /**
+    *   @brief  Checks if stored frame matches the query
+    *   @param  store frame store
+    *   @param  index index of the frame in the store
+    *   @return true if frame matches
+    */
+    bool matches(const FrameStore& store, quint64 index) const;
+
+private:
+    struct Span {
+        qint64 minUs;
+        qint64 maxUs;
+        quint32 minId;
+        quint32 maxId;
+    };
+
+    enum Overlap { None, Partial, Full };
+
+    const Span* span(quint64 seq) const;
+    Overlap overlap(quint64 seq) const;
+    bool matchesPayload(const FrameStore& store, quint64 index) const;
+    bool matchesCandidate(const FrameStore& store, quint64 seq) const;
+
+    QString _query;
+    quint32 _idFirst{ 0 };
+    quint32 _idLast{ std::numeric_limits<quint32>::max() };
+    qint64 _fromUs{ std::numeric_limits<qint64>::min() };
+    qint64 _toUs{ std::numeric_limits<qint64>::max() };
+    std::vector<quint8> _value; // expected payload bits
+    std::vector<quint8> _mask; // compared payload bits
+
+    std::deque<Span> _spans; // time span and ID range by chunk of sequence numbers
+    quint64 _firstChunk{ 0 }; // chunk of _spans.front()
+};
+
+#endif // FRAMESEARCH_H
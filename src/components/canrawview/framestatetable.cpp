@@ -0,0 +1,197 @@
+#include "framestatetable.h"
+#include "framestore.h"
+#include <QtCore/QtEndian>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+const quint32 kEmptyKey = 0xffffffff; // not a valid key, bit 31 is never set
+const qint32 kNone = -1;
+const std::size_t kInitialSlots = 64;
+
+// Gets bit per byte of little endian word, set if the byte is not zero
+quint8 nonZeroBytes(quint64 word)
+{
+    // High bit of each byte is set if any bit of the byte is set, then high bits are gathered into the top byte
+    word = (((word & Q_UINT64_C(0x7f7f7f7f7f7f7f7f)) + Q_UINT64_C(0x7f7f7f7f7f7f7f7f)) | word)
+        & Q_UINT64_C(0x8080808080808080);
+
+    return static_cast<quint8>(((word >> 7) * Q_UINT64_C(0x0102040810204080)) >> 56);
+}
+
+// Murmur3 finalizer, every bit of key affects the low bits used as slot index
+std::size_t slotOf(quint32 key, std::size_t mask)
+{
+    key ^= key >> 16;
+    key *= 0x85ebca6bu;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35u;
+    key ^= key >> 16;
+
+    return key & mask;
+}
+
+quint64 lowBits(int count)
+{
+    return (count >= 64) ? ~Q_UINT64_C(0) : (Q_UINT64_C(1) << count) - 1;
+}
+}
+
+constexpr quint64 FrameState::kNotStored;
+
+FrameStateTable::FrameStateTable()
+    : _standard(2 * kStandardCount, kNone)
+{
+}
+
+std::size_t FrameStateTable::update(const FrameStore& store, quint64 index)
+{
+    return update(store.firstSeq() + index, store.timeUs(index), store.id(index), store.flags(index),
+        store.payload(index), store.length(index));
+}
+
+std::size_t FrameStateTable::update(
+    quint64 seq, qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length)
+{
+    qint32& stateIndex = insert(id, flags);
+
+    if (stateIndex == kNone) {
+        stateIndex = static_cast<qint32>(_states.size());
+        _states.emplace_back();
+        _states.back().id = id;
+    }
+
+    FrameState& state = _states[static_cast<std::size_t>(stateIndex)];
+    length = std::min(length, static_cast<int>(state.payload.size()));
+
+    if (state.count > 0) {
+        const qint64 period = timeUs - state.timeUs;
+        const double delta = period - state.meanPeriodUs;
+
+        // Number of periods including this one is equal to number of previous frames
+        state.meanPeriodUs += delta / static_cast<double>(state.count);
+        state.periodM2 += delta * (period - state.meanPeriodUs);
+        state.minPeriodUs = (state.count > 1) ? std::min(state.minPeriodUs, period) : period;
+        state.maxPeriodUs = (state.count > 1) ? std::max(state.maxPeriodUs, period) : period;
+    }
+
+    // Nothing is marked in the first frame
+    quint64 changed = 0;
+
+    if (state.count > 0) {
+        const int common = std::min(length, static_cast<int>(state.length));
+
+        // Payloads are compared 8 bytes at a time
+        for (int i = 0; i < common; i += 8) {
+            const std::size_t size = static_cast<std::size_t>(std::min(8, common - i));
+            quint64 word = 0;
+            quint64 previous = 0;
+
+            std::memcpy(&word, payload + i, size);
+            std::memcpy(&previous, state.payload.data() + i, size);
+            changed |= quint64(nonZeroBytes(qFromLittleEndian(word ^ previous))) << i;
+        }
+
+        // Bytes beyond length of the previous frame count as changed
+        changed |= lowBits(length) & ~lowBits(common);
+    }
+
+    state.changed = changed;
+    state.timeUs = timeUs;
+    state.seq = seq;
+    state.flags = flags;
+    state.length = static_cast<quint8>(length);
+    ++state.count;
+
+    if (length > 0) {
+        std::memcpy(state.payload.data(), payload, static_cast<std::size_t>(length));
+    }
+
+    return static_cast<std::size_t>(stateIndex);
+}
+
+const FrameState* FrameStateTable::find(quint32 id, quint8 flags) const
+{
+    qint32 stateIndex = kNone;
+
+    if (isStandard(id, flags)) {
+        stateIndex = _standard[(id << 1) | (flags & FrameStore::Tx)];
+    } else if (!_extended.empty()) {
+        const quint32 key = makeKey(id, flags);
+        const std::size_t mask = _extended.size() - 1;
+
+        for (std::size_t i = slotOf(key, mask); _extended[i].key != kEmptyKey; i = (i + 1) & mask) {
+            if (_extended[i].key == key) {
+                stateIndex = _extended[i].index;
+                break;
+            }
+        }
+    }
+
+    return (stateIndex == kNone) ? nullptr : &_states[static_cast<std::size_t>(stateIndex)];
+}
+
+void FrameStateTable::clear()
+{
+    _states.clear();
+    std::fill(_standard.begin(), _standard.end(), kNone);
+    _extended.clear();
+    _extendedCount = 0;
+}
+
+bool FrameStateTable::isStandard(quint32 id, quint8 flags)
+{
+    return !(flags & FrameStore::Extended) && (id < kStandardCount);
+}
+
+quint32 FrameStateTable::makeKey(quint32 id, quint8 flags)
+{
+    return (id & 0x1fffffff) | ((flags & FrameStore::Tx) ? 0x20000000 : 0)
+        | ((flags & FrameStore::Extended) ? 0x40000000 : 0);
+}
+
+qint32& FrameStateTable::insert(quint32 id, quint8 flags)
+{
+    if (isStandard(id, flags)) {
+        return _standard[(id << 1) | (flags & FrameStore::Tx)];
+    }
+
+    if ((_extendedCount + 1) * 4 > _extended.size() * 3) {
+        grow();
+    }
+
+    const quint32 key = makeKey(id, flags);
+    const std::size_t mask = _extended.size() - 1;
+    std::size_t i = slotOf(key, mask);
+
+    while ((_extended[i].key != key) && (_extended[i].key != kEmptyKey)) {
+        i = (i + 1) & mask;
+    }
+
+    if (_extended[i].key == kEmptyKey) {
+        _extended[i].key = key;
+        ++_extendedCount;
+    }
+
+    return _extended[i].index;
+}
+
+void FrameStateTable::grow()
+{
+    std::vector<Slot> slots(std::max(kInitialSlots, _extended.size() * 2), Slot{ kEmptyKey, kNone });
+    const std::size_t mask = slots.size() - 1;
+
+    for (const auto& slot : _extended) {
+        if (slot.key != kEmptyKey) {
+            std::size_t i = slotOf(slot.key, mask);
+
+            while (slots[i].key != kEmptyKey) {
+                i = (i + 1) & mask;
+            }
+
+            slots[i] = slot;
+        }
+    }
+
+    _extended.swap(slots);
+}
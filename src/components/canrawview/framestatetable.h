@@ -0,0 +1,110 @@
+#ifndef FRAMESTATETABLE_H
+#define FRAMESTATETABLE_H
+
+#include <QtCore/QtGlobal>
+#include <array>
+#include <vector>
+
+class FrameStore;
+
+/**
+*   @brief State of frame ID and direction. Period statistics are updated online with Welford's algorithm.
+*/
+struct FrameState {
+    static constexpr quint64 kNotStored = ~Q_UINT64_C(0);
+
+    qint64 timeUs{ 0 }; // time of the newest frame
+    quint64 seq{ 0 }; // sequence number of the newest frame, kNotStored if it was not stored
+    quint64 count{ 0 };
+    qint64 minPeriodUs{ 0 };
+    qint64 maxPeriodUs{ 0 };
+    double meanPeriodUs{ 0 };
+    double periodM2{ 0 }; // sum of squared differences from mean period
+    quint64 changed{ 0 }; // bit per payload byte of the newest frame that differs from the previous frame
+    quint32 id{ 0 };
+    quint8 flags{ 0 };
+    quint8 length{ 0 };
+    std::array<char, 64> payload; // payload of the newest frame
+    int row{ -1 }; // row in table of newest frames, -1 if not shown yet
+};
+
+/**
+*   @brief The class provides table of states of frame IDs and directions seen in a capture.
+*
+*   States of standard IDs are indexed directly by ID and direction, extended IDs go to an open addressing hash table
+*   that grows when it is 3/4 full. States are kept in order of first reception and addressed by index, so other
+*   tables can refer to them cheaply. Update is O(1) and allocates only when a new ID and direction is seen.
+*/
+class FrameStateTable {
+public:
+    FrameStateTable();
+
+    /**
+    *   @brief  Updates state of ID and direction of a stored frame. State is created if needed.
+    *   @param  store frame store
+    *   @param  index index of the frame in the store
+    *   @return state index
+    */
+    std::size_t update(const FrameStore& store, quint64 index);
+
+    /**
+    *   @brief  Updates state of ID and direction with a frame before it is stored, or with a frame that is not stored
+    *           at all. State is created if needed.
+    *   @param  seq sequence number of the frame, FrameState::kNotStored if it is not stored
+    *   @param  timeUs capture time in microseconds
+    *   @param  id frame ID
+    *   @param  flags combination of FrameStore::Flags
+    *   @param  payload payload bytes
+    *   @param  length payload length
+    *   @return state index
+    */
+    std::size_t update(quint64 seq, qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length);
+
+    /**
+    *   @brief  Finds state of ID and direction
+    *   @param  id frame ID
+    *   @param  flags combination of FrameStore::Flags, only direction and format are used
+    *   @return state or nullptr if no such frame was seen
+    */
+    const FrameState* find(quint32 id, quint8 flags) const;
+
+    FrameState& at(std::size_t index)
+    {
+        return _states[index];
+    }
+
+    const FrameState& at(std::size_t index) const
+    {
+        return _states[index];
+    }
+
+    std::size_t size() const
+    {
+        return _states.size();
+    }
+
+    /**
+    *   @brief  Removes all states
+    */
+    void clear();
+
+private:
+    struct Slot {
+        quint32 key;
+        qint32 index;
+    };
+
+    static constexpr quint32 kStandardCount = 0x800;
+
+    static bool isStandard(quint32 id, quint8 flags);
+    static quint32 makeKey(quint32 id, quint8 flags);
+    qint32& insert(quint32 id, quint8 flags);
+    void grow();
+
+    std::vector<FrameState> _states;
+    std::vector<qint32> _standard; // state index by ID and direction
+    std::vector<Slot> _extended;
+    std::size_t _extendedCount{ 0 };
+};
+
+#endif // FRAMESTATETABLE_H
@@ -0,0 +1,180 @@
+#include "framestatsmodel.h"
+#include "framestatetable.h"
+#include "framestore.h"
+#include <algorithm>
+#include <cmath>
+#include <hexformat.h>
+
+FrameStatsModel::FrameStatsModel(const FrameStateTable& states, QObject* parent)
+    : QAbstractTableModel(parent)
+    , _states(states)
+{
+}
+
+void FrameStatsModel::refresh()
+{
+    // State table has been cleared
+    if (_rows.size() > _states.size()) {
+        beginResetModel();
+        _rows.clear();
+        endResetModel();
+    }
+
+    if (_rows.size() < _states.size()) {
+        beginInsertRows(QModelIndex(), static_cast<int>(_rows.size()), static_cast<int>(_states.size()) - 1);
+        for (auto i = _rows.size(); i < _states.size(); ++i) {
+            _rows.push_back(i);
+        }
+        endInsertRows();
+    }
+
+    restoreOrder();
+
+    if (!_rows.empty()) {
+        emit dataChanged(index(0, 0), index(rowCount() - 1, ColumnCount - 1));
+    }
+}
+
+void FrameStatsModel::sort(int column, Qt::SortOrder order)
+{
+    _sortColumn = column;
+    _sortOrder = order;
+    restoreOrder();
+}
+
+int FrameStatsModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(_rows.size());
+}
+
+int FrameStatsModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant FrameStatsModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || (role != Qt::DisplayRole)) {
+        return {};
+    }
+
+    const std::size_t state = _rows[static_cast<std::size_t>(index.row())];
+    const FrameState& frameState = _states.at(state);
+
+    switch (index.column()) {
+    case Id:
+        return HexFormat::idToString(frameState.id);
+
+    case Dir:
+        return QString((frameState.flags & FrameStore::Tx) ? "TX" : "RX");
+
+    case Count:
+        return static_cast<qulonglong>(frameState.count);
+
+    default:
+        // Periods need at least two frames
+        if (frameState.count < 2) {
+            return {};
+        }
+
+        return QString::number(value(state, index.column()), 'f', (index.column() == Rate) ? 1 : 3);
+    }
+}
+
+QVariant FrameStatsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    static const char* const kNames[ColumnCount]
+        = { "ID", "Dir", "Count", "Rate [Hz]", "Period [ms]", "Min [ms]", "Max [ms]", "Jitter [ms]" };
+
+    if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole) && (section >= 0) && (section < ColumnCount)) {
+        return QString(kNames[section]);
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+double FrameStatsModel::value(std::size_t state, int column) const
+{
+    const FrameState& frameState = _states.at(state);
+    const quint64 periods = (frameState.count > 0) ? frameState.count - 1 : 0;
+
+    switch (column) {
+    case Id:
+        return frameState.id;
+
+    case Dir:
+        return frameState.flags & FrameStore::Tx;
+
+    case Count:
+        return static_cast<double>(frameState.count);
+
+    case Rate:
+        return (frameState.meanPeriodUs > 0) ? 1000000.0 / frameState.meanPeriodUs : 0;
+
+    case MeanPeriod:
+        return frameState.meanPeriodUs / 1000;
+
+    case MinPeriod:
+        return frameState.minPeriodUs / 1000.0;
+
+    case MaxPeriod:
+        return frameState.maxPeriodUs / 1000.0;
+
+    case Jitter:
+        // Standard deviation of period
+        return (periods > 0) ? std::sqrt(frameState.periodM2 / static_cast<double>(periods)) / 1000 : 0;
+
+    default:
+        return 0;
+    }
+}
+
+void FrameStatsModel::restoreOrder()
+{
+    if (_sortColumn < 0) {
+        return;
+    }
+
+    const auto less = [this](std::size_t a, std::size_t b) {
+        const double left = value(a, _sortColumn);
+        const double right = value(b, _sortColumn);
+
+        if (left != right) {
+            return (_sortOrder == Qt::AscendingOrder) ? (left < right) : (left > right);
+        }
+
+        // Rows with equal values stay in order of first reception
+        return a < b;
+    };
+
+    if (std::is_sorted(_rows.begin(), _rows.end(), less)) {
+        return;
+    }
+
+    emit layoutAboutToBeChanged();
+
+    const QModelIndexList from = persistentIndexList();
+    std::vector<std::size_t> states;
+
+    for (const auto& index : from) {
+        states.push_back(_rows[static_cast<std::size_t>(index.row())]);
+    }
+
+    std::sort(_rows.begin(), _rows.end(), less);
+
+    std::vector<int> rowOf(_rows.size());
+
+    for (std::size_t i = 0; i < _rows.size(); ++i) {
+        rowOf[_rows[i]] = static_cast<int>(i);
+    }
+
+    QModelIndexList to;
+
+    for (int i = 0; i < from.size(); ++i) {
+        to.append(index(rowOf[states[static_cast<std::size_t>(i)]], from[i].column()));
+    }
+
+    changePersistentIndexList(from, to);
+
+    emit layoutChanged();
+}
@@ -0,0 +1,62 @@
+#ifndef FRAMESTATSMODEL_H
+#define FRAMESTATSMODEL_H
+
+#include <QtCore/QAbstractTableModel>
+#include <vector>
+
+class FrameStateTable;
+
+/**
+*   @brief The class provides table model of statistics of each frame ID and direction.
+*
+*   Statistics are kept up to date in FrameStateTable with every frame. The model only shows them, so it is refreshed
+*   at a fixed low rate instead: rows of new IDs are inserted and all rows are reported as changed.
+*/
+class FrameStatsModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { Id, Dir, Count, Rate, MeanPeriod, MinPeriod, MaxPeriod, Jitter, ColumnCount };
+
+    /**
+    *   @brief  Constructor
+    *   @param  states state table, must outlive the model
+    *   @param  parent parent object
+    */
+    explicit FrameStatsModel(const FrameStateTable& states, QObject* parent = nullptr);
+
+    /**
+    *   @brief  Brings the model up to date with the state table
+    */
+    void refresh();
+
+    /**
+    *   @brief  Sorts rows. Order is restored on refresh.
+    *   @param  column sort column, -1 for order of first reception
+    *   @param  order sort order
+    */
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+    *   @brief  Gets value of a statistic, also used for sorting
+    *   @param  state state index
+    *   @param  column statistic column
+    *   @return value
+    */
+    double value(std::size_t state, int column) const;
+
+private:
+    void restoreOrder();
+
+    const FrameStateTable& _states;
+    std::vector<std::size_t> _rows; // state index by row
+    int _sortColumn{ -1 };
+    Qt::SortOrder _sortOrder{ Qt::AscendingOrder };
+};
+
+#endif // FRAMESTATSMODEL_H
@@ -0,0 +1,319 @@
+#include "framestore.h"
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryFile>
+#include <QtSerialBus/QCanBusFrame>
+#include <algorithm>
+#include <cstring>
+#include <log.h>
+
+constexpr int FrameStore::kChunkSize;
+constexpr int FrameStore::kFrameSize;
+constexpr int FrameStore::kMappedChunks;
+
+FrameStore::FrameStore() = default;
+
+FrameStore::~FrameStore()
+{
+    clear();
+}
+
+void FrameStore::append(qint64 timeUs, const QCanBusFrame& frame, bool tx, quint64 changed)
+{
+    const QByteArray& payload = frame.payload();
+    append(timeUs, frame.frameId(), frameFlags(frame, tx), payload.constData(), payload.size(), changed);
+}
+
+quint8 FrameStore::frameFlags(const QCanBusFrame& frame, bool tx)
+{
+    quint8 flags = tx ? Tx : 0;
+
+    if (frame.hasExtendedFrameFormat()) {
+        flags |= Extended;
+    }
+
+    if (frame.frameType() == QCanBusFrame::RemoteRequestFrame) {
+        flags |= Remote;
+    }
+
+    return flags;
+}
+
+void FrameStore::append(qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length, quint64 changed)
+{
+    if (_chunks.empty() || (_chunks.back()->count == kChunkSize)) {
+        // Newest chunk is always resident, the oldest resident one goes to the file if there are too many
+        if ((_residentChunks > 0) && (_chunks.size() - _spilled >= static_cast<std::size_t>(_residentChunks))) {
+            spill(*_chunks[_spilled]);
+        }
+
+        auto c = std::make_unique<Chunk>();
+        c->resident = _spare ? std::move(_spare) : std::make_unique<Columns>();
+        c->columns = c->resident.get();
+        _chunks.push_back(std::move(c));
+    }
+
+    Chunk& c = *_chunks.back();
+    Columns& columns = *c.resident;
+    const int i = c.count;
+
+    columns.timeUs[i] = timeUs;
+    columns.id[i] = id;
+    columns.flags[i] = flags;
+    columns.length[i] = static_cast<quint8>(qBound(0, length, 255));
+
+    if (length <= 8) {
+        columns.changed[i] = static_cast<quint8>(changed);
+
+        if (length > 0) {
+            std::memcpy(columns.data[i].data(), payload, length);
+        }
+    } else {
+        const quint32 pos = static_cast<quint32>(c.fdData.size());
+
+        columns.changed[i] = 0;
+        std::memcpy(columns.data[i].data(), &pos, sizeof(pos));
+        c.fdData.append(payload, columns.length[i]);
+        c.fdData.append(reinterpret_cast<const char*>(&changed), sizeof(changed));
+    }
+
+    ++c.count;
+    ++_size;
+
+    if (c.count == kChunkSize) {
+        for (int j = 0; j < kChunkSize; ++j) {
+            columns.byId[j] = static_cast<quint16>(j);
+        }
+
+        std::sort(columns.byId.begin(), columns.byId.end(), [&columns](quint16 a, quint16 b) {
+            return (columns.id[a] < columns.id[b]) || ((columns.id[a] == columns.id[b]) && (a < b));
+        });
+    }
+}
+
+void FrameStore::removeFirst(quint64 count)
+{
+    count = std::min(count, _size);
+    _size -= count;
+    _firstSeq += count;
+
+    quint64 first = _firstOffset + count;
+
+    // All chunks but the last one are full
+    while (first >= kChunkSize) {
+        first -= kChunkSize;
+        release(std::move(_chunks.front()));
+        _chunks.pop_front();
+    }
+
+    _firstOffset = static_cast<int>(first);
+
+    if ((_size == 0) && !_chunks.empty()) {
+        release(std::move(_chunks.front()));
+        _chunks.clear();
+        _firstOffset = 0;
+    }
+}
+
+void FrameStore::clear()
+{
+    for (auto& c : _chunks) {
+        unmap(*c);
+    }
+
+    _chunks.clear();
+    _spare.reset();
+    _file.reset();
+    _spilled = 0;
+    _size = 0;
+    _firstSeq = 0;
+    _firstOffset = 0;
+}
+
+void FrameStore::setResidentChunks(int residentChunks)
+{
+    _residentChunks = std::max(residentChunks, 0);
+}
+
+int FrameStore::residentChunks() const
+{
+    return _residentChunks;
+}
+
+const char* FrameStore::payload(quint64 index) const
+{
+    const Chunk& c = chunk(index);
+    const Columns& cols = columns(index);
+    const int i = offset(index);
+
+    if (cols.length[i] <= 8) {
+        return cols.data[i].data();
+    }
+
+    quint32 pos = 0;
+    std::memcpy(&pos, cols.data[i].data(), sizeof(pos));
+
+    if (c.resident) {
+        return c.fdData.constData() + pos;
+    }
+
+    return reinterpret_cast<const char*>(c.mapping) + sizeof(Columns) + pos;
+}
+
+quint64 FrameStore::changed(quint64 index) const
+{
+    const Columns& cols = columns(index);
+    const int i = offset(index);
+    quint64 changed = cols.changed[i];
+
+    if (cols.length[i] > 8) {
+        std::memcpy(&changed, payload(index) + cols.length[i], sizeof(changed));
+    }
+
+    return changed;
+}
+
+void FrameStore::findIds(
+    quint64 first, quint64 end, quint32 idFirst, quint32 idLast, std::vector<quint64>& result) const
+{
+    while (first < end) {
+        const Chunk& c = chunk(first);
+        const Columns& cols = columns(first);
+        const int begin = offset(first);
+        const int stop = static_cast<int>(std::min(static_cast<quint64>(kChunkSize), begin + (end - first)));
+        const std::size_t size = result.size();
+
+        if (c.count == kChunkSize) {
+            auto it = std::lower_bound(cols.byId.begin(), cols.byId.end(), idFirst,
+                [&cols](quint16 i, quint32 id) { return cols.id[i] < id; });
+
+            for (; (it != cols.byId.end()) && (cols.id[*it] <= idLast); ++it) {
+                if ((*it >= begin) && (*it < stop)) {
+                    result.push_back(first + static_cast<quint64>(*it - begin));
+                }
+            }
+
+            // Frames are ordered by ID first
+            if (idFirst != idLast) {
+                std::sort(result.begin() + static_cast<std::ptrdiff_t>(size), result.end());
+            }
+        } else {
+            // Newest chunk is not ordered yet
+            for (int i = begin; i < stop; ++i) {
+                if ((cols.id[i] >= idFirst) && (cols.id[i] <= idLast)) {
+                    result.push_back(first + static_cast<quint64>(i - begin));
+                }
+            }
+        }
+
+        first += static_cast<quint64>(stop - begin);
+    }
+}
+
+quint64 FrameStore::memoryUsage() const
+{
+    quint64 usage = _spare ? sizeof(Columns) : 0;
+
+    for (const auto& c : _chunks) {
+        if (c->resident) {
+            usage += sizeof(Chunk) + sizeof(Columns) + static_cast<quint64>(c->fdData.capacity());
+        } else {
+            usage += sizeof(Chunk);
+        }
+    }
+
+    return usage;
+}
+
+quint64 FrameStore::diskUsage() const
+{
+    return _file ? static_cast<quint64>(_file->size()) : 0;
+}
+
+void FrameStore::spill(Chunk& c)
+{
+    if (!_file) {
+        auto file = std::make_unique<QTemporaryFile>(QDir::tempPath() + "/cds_capture_XXXXXX.bin");
+
+        if (!file->open()) {
+            cds_warn("Failed to create capture file: {}", file->errorString().toStdString());
+            _residentChunks = 0;
+            return;
+        }
+
+        _file = std::move(file);
+    }
+
+    // Keep columns 8 byte aligned in the file
+    const qint64 offset = _file->size();
+    const int padding = (8 - c.fdData.size() % 8) % 8;
+    const char zeros[8] = {};
+    bool ok = _file->seek(offset);
+
+    ok = ok && (_file->write(reinterpret_cast<const char*>(c.resident.get()), sizeof(Columns)) == sizeof(Columns));
+    ok = ok && (_file->write(c.fdData) == c.fdData.size());
+    ok = ok && (_file->write(zeros, padding) == padding);
+    ok = ok && _file->flush();
+
+    if (!ok) {
+        cds_warn("Failed to write capture file: {}", _file->errorString().toStdString());
+        _file->resize(offset);
+        _residentChunks = 0;
+        return;
+    }
+
+    c.fileOffset = offset;
+    c.fdSize = c.fdData.size();
+    c.fdData = QByteArray();
+    c.columns = nullptr;
+    _spare = std::move(c.resident);
+    ++_spilled;
+}
+
+const FrameStore::Columns& FrameStore::map(Chunk& c) const
+{
+    if (static_cast<int>(_mapped.size()) >= kMappedChunks) {
+        unmap(*_mapped.front());
+    }
+
+    c.mapping = _file->map(c.fileOffset, static_cast<qint64>(sizeof(Columns)) + c.fdSize);
+
+    if (!c.mapping) {
+        cds_warn("Failed to map capture file, reading to memory: {}", _file->errorString().toStdString());
+
+        c.resident = std::make_unique<Columns>();
+        _file->seek(c.fileOffset);
+        _file->read(reinterpret_cast<char*>(c.resident.get()), sizeof(Columns));
+        c.fdData = _file->read(c.fdSize);
+        c.columns = c.resident.get();
+
+        return *c.columns;
+    }
+
+    c.columns = reinterpret_cast<const Columns*>(c.mapping);
+    _mapped.push_back(&c);
+
+    return *c.columns;
+}
+
+void FrameStore::unmap(Chunk& c) const
+{
+    if (c.mapping) {
+        _file->unmap(c.mapping);
+        c.mapping = nullptr;
+        c.columns = nullptr;
+        _mapped.erase(std::find(_mapped.begin(), _mapped.end(), &c));
+    }
+}
+
+void FrameStore::release(std::unique_ptr<Chunk> c)
+{
+    if (c->fileOffset >= 0) {
+        unmap(*c);
+        --_spilled;
+    }
+
+    if (c->resident) {
+        // Keep one buffer to avoid allocation when the store is used as a ring buffer
+        _spare = std::move(c->resident);
+    }
+}
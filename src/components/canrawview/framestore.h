@@ -0,0 +1,221 @@
+#ifndef FRAMESTORE_H
+#define FRAMESTORE_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QtGlobal>
+#include <array>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class QCanBusFrame;
+class QFile;
+
+/**
+*   @brief The class provides compact storage of captured frames.
+*
+*   Frames are kept column by column in fixed size chunks. Payload of classic CAN frame is stored inline in 8 bytes,
+*   longer CAN FD payloads go to a chunk local buffer. A frame takes 25 bytes plus CAN FD payload. Frames are
+*   addressed by index starting from the oldest stored frame. Oldest frames can be removed cheaply, emptied chunk is
+*   reused for new frames, so the store works as a ring buffer once it reaches its size limit. Sequence number of
+*   a frame is its index since last clear.
+*
+*   Payload bytes that differ from the previous frame of the same ID and direction are stored with each frame, so views
+*   can highlight them without comparing frames. They are computed by FrameStateTable that tracks the previous frames
+*   anyway.
+*
+*   Full chunk keeps offsets of its frames ordered by ID, so frames of an ID are found without scanning the chunk. The
+*   order is stored in the chunk, so it takes no memory once the chunk is moved to the file.
+*
+*   Optionally only the newest chunks stay in memory. Older chunks are appended to a temporary file and memory mapped
+*   on access, at most kMappedChunks at a time, so random access stays O(1) while resident memory is bounded. Space of
+*   removed chunks in the file is reclaimed on clear.
+*/
+class FrameStore {
+public:
+    static constexpr int kChunkSize = 4096;
+    // Memory used by a frame with classic CAN payload
+    static constexpr int kFrameSize = sizeof(qint64) + sizeof(quint32) + sizeof(quint16) + 3 * sizeof(quint8) + 8;
+    static constexpr int kMappedChunks = 16;
+
+    enum Flags : quint8 { Tx = 0x01, Extended = 0x02, Remote = 0x04 };
+
+    FrameStore();
+    ~FrameStore();
+
+    /**
+    *   @brief  Appends frame to the store
+    *   @param  timeUs capture time in microseconds
+    *   @param  frame captured frame
+    *   @param  tx true if frame was transmitted
+    *   @param  changed payload bytes that differ from the previous frame of the same ID and direction, see changed()
+    */
+    void append(qint64 timeUs, const QCanBusFrame& frame, bool tx, quint64 changed = 0);
+
+    /**
+    *   @brief  Appends frame to the store
+    *   @param  timeUs capture time in microseconds
+    *   @param  id frame ID
+    *   @param  flags combination of Flags
+    *   @param  payload payload bytes
+    *   @param  length payload length
+    *   @param  changed payload bytes that differ from the previous frame of the same ID and direction, see changed()
+    */
+    void append(qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length, quint64 changed = 0);
+
+    /**
+    *   @brief  Gets flags of a captured frame
+    *   @param  frame captured frame
+    *   @param  tx true if frame was transmitted
+    *   @return combination of Flags
+    */
+    static quint8 frameFlags(const QCanBusFrame& frame, bool tx);
+
+    /**
+    *   @brief  Removes oldest frames
+    *   @param  count number of frames to remove
+    */
+    void removeFirst(quint64 count);
+
+    /**
+    *   @brief  Removes all frames. Sequence numbers start from 0 again.
+    */
+    void clear();
+
+    /**
+    *   @brief  Enables moving of older chunks to a temporary file. Frames already moved stay there.
+    *   @param  residentChunks number of newest chunks kept in memory, 0 disables spilling
+    */
+    void setResidentChunks(int residentChunks);
+    int residentChunks() const;
+
+    quint64 size() const
+    {
+        return _size;
+    }
+
+    /**
+    *   @brief  Gets sequence number of the oldest stored frame, i.e. number of frames removed since last clear
+    *   @return sequence number
+    */
+    quint64 firstSeq() const
+    {
+        return _firstSeq;
+    }
+
+    qint64 timeUs(quint64 index) const
+    {
+        return columns(index).timeUs[offset(index)];
+    }
+
+    quint32 id(quint64 index) const
+    {
+        return columns(index).id[offset(index)];
+    }
+
+    quint8 flags(quint64 index) const
+    {
+        return columns(index).flags[offset(index)];
+    }
+
+    int length(quint64 index) const
+    {
+        return columns(index).length[offset(index)];
+    }
+
+    /**
+    *   @brief  Gets payload of a frame. Pointer is valid until the frame is removed or until another frame is read
+    *           from the file.
+    *   @param  index frame index
+    *   @return pointer to length(index) payload bytes
+    */
+    const char* payload(quint64 index) const;
+
+    /**
+    *   @brief  Gets payload bytes that differ from the previous frame of the same ID and direction
+    *   @param  index frame index
+    *   @return bit per payload byte, bit 0 for the first byte
+    */
+    quint64 changed(quint64 index) const;
+
+    /**
+    *   @brief  Finds frames with ID in range
+    *   @param  first index of the first frame to check
+    *   @param  end index following the last frame to check
+    *   @param  idFirst first ID of the range
+    *   @param  idLast last ID of the range
+    *   @param  result indexes of matching frames are appended to it in ascending order
+    */
+    void findIds(quint64 first, quint64 end, quint32 idFirst, quint32 idLast, std::vector<quint64>& result) const;
+
+    /**
+    *   @brief  Gets memory used by stored frames
+    *   @return size in bytes
+    */
+    quint64 memoryUsage() const;
+
+    /**
+    *   @brief  Gets size of the file holding chunks moved out of memory
+    *   @return size in bytes
+    */
+    quint64 diskUsage() const;
+
+private:
+    // Stored as is in the file, so it must not contain pointers
+    struct Columns {
+        std::array<qint64, kChunkSize> timeUs;
+        std::array<quint32, kChunkSize> id;
+        std::array<quint8, kChunkSize> flags;
+        std::array<quint8, kChunkSize> length;
+        // Changed bytes of classic CAN payload, CAN FD mask follows CAN FD data
+        std::array<quint8, kChunkSize> changed;
+        // Frame offsets ordered by ID and offset, set when chunk gets full
+        std::array<quint16, kChunkSize> byId;
+        // Inline payload, or offset to CAN FD data if length exceeds 8 bytes
+        std::array<std::array<char, 8>, kChunkSize> data;
+    };
+
+    struct Chunk {
+        // Resident or mapped columns, null if chunk is in the file and not mapped
+        const Columns* columns{ nullptr };
+        std::unique_ptr<Columns> resident;
+        QByteArray fdData;
+        qint64 fileOffset{ -1 };
+        int fdSize{ 0 };
+        uchar* mapping{ nullptr };
+        int count{ 0 };
+    };
+
+    Chunk& chunk(quint64 index) const
+    {
+        return *_chunks[static_cast<std::size_t>((index + _firstOffset) / kChunkSize)];
+    }
+
+    const Columns& columns(quint64 index) const
+    {
+        Chunk& c = chunk(index);
+        return c.columns ? *c.columns : map(c);
+    }
+
+    int offset(quint64 index) const
+    {
+        return static_cast<int>((index + _firstOffset) % kChunkSize);
+    }
+
+    void spill(Chunk& c);
+    const Columns& map(Chunk& c) const;
+    void unmap(Chunk& c) const;
+    void release(std::unique_ptr<Chunk> c);
+
+    std::deque<std::unique_ptr<Chunk>> _chunks;
+    std::unique_ptr<Columns> _spare;
+    std::unique_ptr<QFile> _file;
+    mutable std::deque<Chunk*> _mapped; // mapped chunks, least recently mapped first
+    int _residentChunks{ 0 };
+    std::size_t _spilled{ 0 }; // number of oldest chunks moved to the file
+    quint64 _size{ 0 };
+    quint64 _firstSeq{ 0 };
+    int _firstOffset{ 0 }; // index of the oldest frame in the first chunk
+};
+
+#endif // FRAMESTORE_H
@@ -2,76 +2,269 @@
 #define CRVGUI_H
 
 #include "crvguiinterface.h"
+#include "framemodel.h"
 #include "ui_canrawview.h"
+#include <QtCore/QEvent>
+#include <QtCore/QFileInfo>
+#include <QtGui/QPainter>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QStyledItemDelegate>
+#include <algorithm>
 #include <memory>
+#include <vector>
 
+/**
+*   @brief Event filter calling back on widget show
+*/
+struct CRVShowEventFilter : public QObject {
+    CRVShowEventFilter(const std::function<void()>& cb, QObject* parent)
+        : QObject(parent)
+        , _cb(cb)
+    {
+    }
+
+    bool eventFilter(QObject*, QEvent* event) override
+    {
+        if (event->type() == QEvent::Show) {
+            _cb();
+        }
+
+        return false;
+    }
+
+private:
+    std::function<void()> _cb;
+};
+
+/**
+*   @brief Item delegate highlighting payload bytes that changed since previous frame of the same ID. Models provide
+*          mask of changed bytes in FrameModel::ChangedRole of data column, bit per byte. Byte positions are measured
+*          in the displayed hex string, so no strings are created while painting.
+*/
+struct CRVDataDelegate : public QStyledItemDelegate {
+    explicit CRVDataDelegate(QObject* parent)
+        : QStyledItemDelegate(parent)
+    {
+    }
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override
+    {
+        const qulonglong changed = index.data(FrameModel::ChangedRole).toULongLong();
+
+        if (changed == 0) {
+            QStyledItemDelegate::paint(painter, option, index);
+            return;
+        }
+
+        QStyleOptionViewItem opt = option;
+        initStyleOption(&opt, index);
+
+        const QWidget* widget = opt.widget;
+        QStyle* style = widget ? widget->style() : QApplication::style();
+        const int margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, widget) + 1;
+        const QRect textRect
+            = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, widget).adjusted(margin, 0, -margin, 0);
+        const QString text = opt.text;
+        const QPalette::ColorGroup group = (opt.state & QStyle::State_Enabled) ? QPalette::Normal : QPalette::Disabled;
+        const QPalette::ColorRole role
+            = (opt.state & QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Text;
+
+        // Background and selection are drawn by the style, text on top of highlighted bytes
+        opt.text.clear();
+        style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+        painter->save();
+        painter->setClipRect(textRect);
+
+        // Byte i is written in characters 3 * i and 3 * i + 1, e.g. "01 02 03"
+        for (int i = 0; (i < 64) && (3 * i + 2 <= text.size()); ++i) {
+            if (changed & (Q_UINT64_C(1) << i)) {
+                const int left = opt.fontMetrics.width(text, 3 * i);
+                const int right = opt.fontMetrics.width(text, 3 * i + 2);
+
+                painter->fillRect(QRect(textRect.left() + left, textRect.top(), right - left, textRect.height()),
+                    QColor(255, 160, 0, 110));
+            }
+        }
+
+        painter->setFont(opt.font);
+        painter->setPen(opt.palette.color(group, role));
+        painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter, text);
+        painter->restore();
+    }
+};
+
+/**
+*   @brief CanRawView GUI. Widget is constructed on first getMainWidget() call. All the setup requested before that
+*          is postponed until widget creation.
+*/
 struct CRVGui : public CRVGuiInterface {
 
     CRVGui()
         : ui(new Ui::CanRawViewPrivate)
-        , widget(new QWidget)
     {
-        ui->setupUi(widget);
     }
 
     virtual void setClearCbk(const clear_t& cb) override
     {
-        QObject::connect(ui->pbClear, &QPushButton::pressed, cb);
+        whenCreated([this, cb] { QObject::connect(ui->pbClear, &QPushButton::pressed, cb); });
     }
 
     virtual void setDockUndockCbk(const dockUndock_t& cb) override
     {
-        QObject::connect(ui->pbDockUndock, &QPushButton::toggled, cb);
+        whenCreated([this, cb] { QObject::connect(ui->pbDockUndock, &QPushButton::toggled, cb); });
     }
 
     virtual void setSectionClikedCbk(const sectionClicked_t& cb) override
     {
-        QObject::connect(ui->tv->horizontalHeader(), &QHeaderView::sectionClicked, cb);
+        whenCreated([this, cb] { QObject::connect(ui->tv->horizontalHeader(), &QHeaderView::sectionClicked, cb); });
     }
 
     virtual void setFilterCbk(const filter_t& cb) override
     {
-        QObject::connect(ui->pbToggleFilter, &QPushButton::toggled, cb);
+        whenCreated([this, cb] { QObject::connect(ui->pbToggleFilter, &QPushButton::toggled, cb); });
+    }
+
+    virtual void setShowCbk(const show_t& cb) override
+    {
+        whenCreated([this, cb] { widget->installEventFilter(new CRVShowEventFilter(cb, widget)); });
+    }
+
+    virtual void setSearchCbk(const search_t& cb) override
+    {
+        whenCreated([this, cb] {
+            const auto next = [this, cb] { cb(ui->searchEdit->text(), false); };
+            QObject::connect(ui->searchEdit, &QLineEdit::returnPressed, next);
+            QObject::connect(ui->pbSearchNext, &QPushButton::clicked, next);
+            QObject::connect(ui->pbSearchPrev, &QPushButton::clicked, [this, cb] { cb(ui->searchEdit->text(), true); });
+        });
+    }
+
+    virtual void setExportCbk(const export_t& cb) override
+    {
+        whenCreated([this, cb] {
+            QObject::connect(ui->pbExport, &QPushButton::clicked, [this, cb] {
+                QString filter;
+                QString fileName = QFileDialog::getSaveFileName(widget, "Export frames", QDir::homePath(),
+                    "candump log (*.log);;Vector ASC (*.asc);;CSV (*.csv)", &filter);
+
+                if (fileName.isEmpty()) {
+                    return;
+                }
+
+                // Format is chosen by extension
+                if (QFileInfo(fileName).suffix().isEmpty()) {
+                    fileName += "." + filter.section("*.", 1).left(3);
+                }
+
+                cb(fileName);
+            });
+        });
+    }
+
+    virtual void setCancelExportCbk(const cancelExport_t& cb) override
+    {
+        whenCreated([this, cb] { QObject::connect(ui->pbCancelExport, &QPushButton::clicked, cb); });
+    }
+
+    virtual void setStatisticsCbk(const statistics_t& cb) override
+    {
+        whenCreated([this, cb] {
+            QObject::connect(ui->pbStatistics, &QPushButton::toggled, [this, cb](bool checked) {
+                ui->statsTv->setVisible(checked);
+                cb(checked);
+            });
+        });
     }
 
     virtual QWidget* getMainWidget() override
     {
+        if (!widget) {
+            widget = new QWidget;
+            ui->setupUi(widget);
+            ui->exportProgress->hide();
+            ui->pbCancelExport->hide();
+            ui->statsTv->hide();
+
+            for (const auto& action : pending) {
+                action();
+            }
+
+            pending.clear();
+        }
+
         return widget;
     }
 
+    virtual bool isCreated() override
+    {
+        return widget != nullptr;
+    }
+
+    virtual bool isVisible() override
+    {
+        return widget && widget->isVisible();
+    }
+
     virtual void setModel(QAbstractItemModel* model) override
     {
-        ui->tv->setModel(model);
+        whenCreated([this, model] {
+            // Models share columns, keep their order, visibility and sort indicator
+            const QByteArray state = ui->tv->horizontalHeader()->saveState();
+            ui->tv->setModel(model);
+            ui->tv->horizontalHeader()->restoreState(state);
+        });
     }
 
     virtual void initTableView(QAbstractItemModel& tvModel) override
     {
-        ui->tv->setModel(&tvModel);
-        ui->tv->horizontalHeader()->setSectionsMovable(true);
-        ui->tv->horizontalHeader()->setSortIndicator(0, Qt::AscendingOrder);
-        ui->tv->setColumnHidden(0, true);
-        ui->tv->setColumnHidden(1, true);
-        ui->tv->setColumnHidden(3, true);
+        whenCreated([this, &tvModel] {
+            ui->tv->setModel(&tvModel);
+            ui->tv->horizontalHeader()->setSectionsMovable(true);
+            ui->tv->horizontalHeader()->setSortIndicator(0, Qt::AscendingOrder);
+            ui->tv->setItemDelegate(new CRVDataDelegate(ui->tv));
+
+            for (int column : hiddenColumns) {
+                ui->tv->setColumnHidden(column, true);
+            }
+        });
+    }
+
+    virtual void initStatsView(QAbstractItemModel& statsModel) override
+    {
+        whenCreated([this, &statsModel] {
+            ui->statsTv->setModel(&statsModel);
+            ui->statsTv->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+        });
     }
 
     virtual bool isViewFrozen() override
     {
-        return ui->freezeBox->isChecked();
+        return widget ? ui->freezeBox->isChecked() : viewFrozen;
+    }
+
+    virtual void setViewFrozen(bool frozen) override
+    {
+        viewFrozen = frozen;
+        whenCreated([this, frozen] { ui->freezeBox->setChecked(frozen); });
     }
 
     virtual void scrollToBottom() override
     {
-        ui->tv->scrollToBottom();
+        if (widget) {
+            ui->tv->scrollToBottom();
+        }
     }
 
     virtual Qt::SortOrder getSortOrder() override
     {
-        return ui->tv->horizontalHeader()->sortIndicatorOrder();
+        return widget ? ui->tv->horizontalHeader()->sortIndicatorOrder() : Qt::AscendingOrder;
     }
 
     virtual int getSortSection() override
     {
-        return ui->tv->horizontalHeader()->sortIndicatorSection();
+        return widget ? ui->tv->horizontalHeader()->sortIndicatorSection() : 0;
     }
 
     virtual QString getClickedColumn(int ndx) override
@@ -81,23 +274,86 @@ struct CRVGui : public CRVGuiInterface {
 
     virtual void setSorting(int sortNdx, int clickedNdx, Qt::SortOrder order) override
     {
-        ui->tv->sortByColumn(sortNdx, order);
-        ui->tv->horizontalHeader()->setSortIndicator(clickedNdx, order);
+        // Sorting restored from config is applied once the widget is created
+        whenCreated([this, sortNdx, clickedNdx, order] {
+            ui->tv->sortByColumn(sortNdx, order);
+            ui->tv->horizontalHeader()->setSortIndicator(clickedNdx, order);
+        });
+    }
+
+    virtual bool isColumnHidden(int ndx) override
+    {
+        if (widget) {
+            return ui->tv->isColumnHidden(ndx);
+        }
+
+        return std::find(hiddenColumns.begin(), hiddenColumns.end(), ndx) != hiddenColumns.end();
     }
 
-    virtual QString getWindowTitle() override
+    virtual void setEvictedCount(quint64 count) override
     {
-        return widget->windowTitle();
+        if (widget) {
+            ui->evictedLabel->setText(count > 0 ? QString("Evicted: %1").arg(count) : QString());
+        }
     }
 
-    virtual bool isColumnHidden(int ndx) override
+    virtual void setElidedCount(quint64 count) override
+    {
+        if (widget) {
+            ui->elidedLabel->setText(count > 0 ? QString("Elided: %1").arg(count) : QString());
+        }
+    }
+
+    virtual void setSearchStatus(const QString& status) override
+    {
+        if (widget) {
+            ui->searchLabel->setText(status);
+        }
+    }
+
+    virtual void setStatus(const QString& status) override
     {
-        return ui->tv->isColumnHidden(ndx);
+        // Status may be reported before the widget is shown for the first time
+        whenCreated([this, status] { ui->statusLabel->setText(status); });
+    }
+
+    virtual void showRow(int row) override
+    {
+        if (widget) {
+            // Keep the row in view while new frames arrive
+            ui->freezeBox->setChecked(true);
+            ui->tv->selectRow(row);
+            ui->tv->scrollTo(ui->tv->model()->index(row, 0), QAbstractItemView::PositionAtCenter);
+        }
+    }
+
+    virtual void setExportProgress(int percent) override
+    {
+        if (widget) {
+            const bool active = percent >= 0;
+
+            ui->exportProgress->setVisible(active);
+            ui->exportProgress->setValue(std::max(percent, 0));
+            ui->pbCancelExport->setVisible(active);
+            ui->pbExport->setEnabled(!active);
+        }
     }
 
 private:
+    void whenCreated(const std::function<void()>& action)
+    {
+        if (widget) {
+            action();
+        } else {
+            pending.push_back(action);
+        }
+    }
+
     Ui::CanRawViewPrivate* ui;
-    QWidget* widget;
+    QWidget* widget{ nullptr };
+    std::vector<std::function<void()>> pending;
+    bool viewFrozen{ false };
+    const std::vector<int> hiddenColumns{ 0, 1, 3 };
 };
 
 #endif // CRVGUI_H
@@ -12,27 +12,46 @@ struct CRVGuiInterface {
     typedef std::function<void()> dockUndock_t;
     typedef std::function<void(int)> sectionClicked_t;
     typedef std::function<void()> filter_t;
+    typedef std::function<void()> show_t;
+    typedef std::function<void(const QString& query, bool backward)> search_t;
+    typedef std::function<void(const QString& fileName)> export_t;
+    typedef std::function<void()> cancelExport_t;
+    typedef std::function<void(bool visible)> statistics_t;
 
     virtual void setClearCbk(const clear_t& cb) = 0;
     virtual void setDockUndockCbk(const dockUndock_t& cb) = 0;
     virtual void setSectionClikedCbk(const sectionClicked_t& cb) = 0;
     virtual void setFilterCbk(const filter_t& cb) = 0;
+    virtual void setShowCbk(const show_t& cb) = 0;
+    virtual void setSearchCbk(const search_t& cb) = 0;
+    virtual void setExportCbk(const export_t& cb) = 0;
+    virtual void setCancelExportCbk(const cancelExport_t& cb) = 0;
+    virtual void setStatisticsCbk(const statistics_t& cb) = 0;
 
     virtual ~CRVGuiInterface()
     {
     }
 
     virtual QWidget* getMainWidget() = 0;
+    virtual bool isCreated() = 0;
+    virtual bool isVisible() = 0;
     virtual void setModel(QAbstractItemModel* model) = 0;
     virtual void initTableView(QAbstractItemModel& tvModel) = 0;
+    virtual void initStatsView(QAbstractItemModel& statsModel) = 0;
     virtual bool isViewFrozen() = 0;
+    virtual void setViewFrozen(bool frozen) = 0;
     virtual void scrollToBottom() = 0;
     virtual Qt::SortOrder getSortOrder() = 0;
     virtual int getSortSection() = 0;
     virtual QString getClickedColumn(int ndx) = 0;
     virtual void setSorting(int sortNdx, int clickedNdx, Qt::SortOrder order) = 0;
-    virtual QString getWindowTitle() = 0;
     virtual bool isColumnHidden(int ndx) = 0;
+    virtual void setEvictedCount(quint64 count) = 0;
+    virtual void setElidedCount(quint64 count) = 0;
+    virtual void setSearchStatus(const QString& status) = 0;
+    virtual void setStatus(const QString& status) = 0;
+    virtual void showRow(int row) = 0;
+    virtual void setExportProgress(int percent) = 0;
 };
 
 #endif // CRVGUIINTERFACE_H
@@ -0,0 +1,217 @@
+#include "sortindex.h"
+#include <algorithm>
+
+void SortIndex::clear()
+{
+    _root.reset();
+    _keyCount = 0;
+    _size = 0;
+}
+
+void SortIndex::setDescending(bool descending)
+{
+    _descending = descending;
+}
+
+bool SortIndex::isDescending() const
+{
+    return _descending;
+}
+
+SortIndex::Bucket& SortIndex::bucket(const key_t& key)
+{
+    Bucket* const found = find(key);
+
+    if (found) {
+        return *found;
+    }
+
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+
+    auto bucket = std::make_unique<Bucket>();
+    bucket->key = key;
+    bucket->priority = _random;
+    ++_keyCount;
+
+    return insert(_root, bucket);
+}
+
+void SortIndex::push(Bucket& bucket, quint64 seq)
+{
+    bucket.seqs.push_back(seq);
+    ++_size;
+    add(bucket.key, 1);
+}
+
+void SortIndex::popFront(Bucket& bucket, quint64 count)
+{
+    count = std::min(count, bucket.size());
+    bucket.removed += static_cast<std::size_t>(count);
+    _size -= count;
+    add(bucket.key, -static_cast<qint64>(count));
+
+    if (bucket.size() == 0) {
+        const key_t key = bucket.key;
+
+        --_keyCount;
+        erase(_root, key);
+    } else if (bucket.removed * 2 >= bucket.seqs.size()) {
+        // Removed frames are dropped once they take half of the bucket, so removal costs O(1) per frame on average
+        bucket.seqs.erase(bucket.seqs.begin(), bucket.seqs.begin() + static_cast<std::ptrdiff_t>(bucket.removed));
+        bucket.removed = 0;
+    }
+}
+
+quint64 SortIndex::row(const Bucket& bucket, quint64 offset) const
+{
+    // Frames of buckets with lower keys
+    quint64 before = total(bucket.left);
+
+    for (const Bucket* node = _root.get(); node != &bucket;) {
+        if (bucket.key < node->key) {
+            node = node->left.get();
+        } else {
+            before += total(node->left) + node->size();
+            node = node->right.get();
+        }
+    }
+
+    const quint64 start = _descending ? _size - before - bucket.size() : before;
+
+    return start + offset;
+}
+
+quint64 SortIndex::row(const key_t& key, quint64 seq) const
+{
+    const Bucket* const bucket = find(key);
+
+    if (!bucket) {
+        return _size;
+    }
+
+    const auto first = bucket->seqs.begin() + static_cast<std::ptrdiff_t>(bucket->removed);
+    const auto pos = std::lower_bound(first, bucket->seqs.end(), seq);
+
+    if ((pos == bucket->seqs.end()) || (*pos != seq)) {
+        return _size;
+    }
+
+    return row(*bucket, static_cast<quint64>(pos - first));
+}
+
+quint64 SortIndex::seq(quint64 row) const
+{
+    // Ascending position of the row. Frames sharing a key keep ascending order in both directions.
+    quint64 rest = _descending ? _size - 1 - row : row;
+    const Bucket* node = _root.get();
+
+    for (;;) {
+        const quint64 before = total(node->left);
+
+        if (rest < before) {
+            node = node->left.get();
+            continue;
+        }
+
+        rest -= before;
+
+        if (rest < node->size()) {
+            break;
+        }
+
+        rest -= node->size();
+        node = node->right.get();
+    }
+
+    const quint64 offset = _descending ? node->size() - 1 - rest : rest;
+
+    return node->seqs[node->removed + static_cast<std::size_t>(offset)];
+}
+
+SortIndex::Bucket* SortIndex::find(const key_t& key) const
+{
+    Bucket* node = _root.get();
+
+    while (node && (node->key != key)) {
+        node = (key < node->key) ? node->left.get() : node->right.get();
+    }
+
+    return node;
+}
+
+SortIndex::Bucket& SortIndex::insert(std::unique_ptr<Bucket>& node, std::unique_ptr<Bucket>& bucket)
+{
+    if (!node) {
+        node = std::move(bucket);
+        return *node;
+    }
+
+    // New bucket is empty, so counts along the path stay the same
+    const bool toLeft = bucket->key < node->key;
+    Bucket& inserted = insert(toLeft ? node->left : node->right, bucket);
+
+    if (toLeft && (node->left->priority > node->priority)) {
+        rotateRight(node);
+    } else if (!toLeft && (node->right->priority > node->priority)) {
+        rotateLeft(node);
+    }
+
+    return inserted;
+}
+
+void SortIndex::erase(std::unique_ptr<Bucket>& node, const key_t& key)
+{
+    if (key < node->key) {
+        erase(node->left, key);
+    } else if (node->key < key) {
+        erase(node->right, key);
+    } else if (!node->left || !node->right) {
+        // Erased bucket is empty, so counts along the path stay the same
+        node = std::move(node->left ? node->left : node->right);
+    } else if (node->left->priority > node->right->priority) {
+        rotateRight(node);
+        erase(node->right, key);
+    } else {
+        rotateLeft(node);
+        erase(node->left, key);
+    }
+}
+
+void SortIndex::add(const key_t& key, qint64 delta)
+{
+    for (Bucket* node = _root.get(); node;) {
+        node->total += static_cast<quint64>(delta);
+
+        if (key < node->key) {
+            node = node->left.get();
+        } else if (node->key < key) {
+            node = node->right.get();
+        } else {
+            break;
+        }
+    }
+}
+
+void SortIndex::rotateLeft(std::unique_ptr<Bucket>& node)
+{
+    std::unique_ptr<Bucket> pivot = std::move(node->right);
+
+    node->right = std::move(pivot->left);
+    node->total = total(node->left) + total(node->right) + node->size();
+    pivot->total = node->total + total(pivot->right) + pivot->size();
+    pivot->left = std::move(node);
+    node = std::move(pivot);
+}
+
+void SortIndex::rotateRight(std::unique_ptr<Bucket>& node)
+{
+    std::unique_ptr<Bucket> pivot = std::move(node->left);
+
+    node->left = std::move(pivot->right);
+    node->total = total(node->left) + total(node->right) + node->size();
+    pivot->total = total(pivot->left) + node->total + pivot->size();
+    pivot->right = std::move(node);
+    node = std::move(pivot);
+}
@@ -0,0 +1,129 @@
+#ifndef SORTINDEX_H
+#define SORTINDEX_H
+
+#include <QtCore/QtGlobal>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+*   @brief The class keeps sequence numbers of frames ordered by a sort key, e.g. frame ID.
+*
+*   Frames sharing a key form a bucket, ordered by sequence number. Buckets are nodes of a treap ordered by key and
+*   each node counts frames of its subtree, so finding a row, adding a frame or a key and removing the oldest frame of
+*   a bucket costs O(log K) on average, where K is the number of distinct keys. Appended frames go to the end of their
+*   bucket, which keeps the order stable. Emptied buckets are removed, so memory follows the number of indexed frames.
+*/
+class SortIndex {
+public:
+    typedef std::pair<quint64, quint64> key_t;
+
+    struct Bucket {
+        key_t key;
+        // Frames in order of sequence numbers, the first `removed` ones were popped and are dropped lazily
+        std::vector<quint64> seqs;
+        std::size_t removed{ 0 };
+        // Treap links and number of frames in the subtree
+        std::unique_ptr<Bucket> left;
+        std::unique_ptr<Bucket> right;
+        quint32 priority{ 0 };
+        quint64 total{ 0 };
+
+        quint64 size() const
+        {
+            return seqs.size() - removed;
+        }
+    };
+
+    /**
+    *   @brief  Removes all frames and keys
+    */
+    void clear();
+
+    /**
+    *   @brief  Sets order of keys. Frames sharing a key stay in order of sequence numbers.
+    *   @param  descending true for descending order
+    */
+    void setDescending(bool descending);
+    bool isDescending() const;
+
+    /**
+    *   @brief  Gets bucket of a key. Bucket is created if needed, it remains valid until it is emptied by popFront
+    *           or until clear.
+    *   @param  key sort key
+    *   @return bucket
+    */
+    Bucket& bucket(const key_t& key);
+
+    /**
+    *   @brief  Appends frame to a bucket. Sequence number must be greater than any other in the bucket.
+    *   @param  bucket bucket
+    *   @param  seq frame sequence number
+    */
+    void push(Bucket& bucket, quint64 seq);
+
+    /**
+    *   @brief  Removes oldest frames of a bucket. Bucket is destroyed if no frames are left.
+    *   @param  bucket bucket
+    *   @param  count number of frames to remove
+    */
+    void popFront(Bucket& bucket, quint64 count);
+
+    quint64 size() const
+    {
+        return _size;
+    }
+
+    /**
+    *   @brief  Gets number of keys, i.e. buckets
+    *   @return number of keys
+    */
+    std::size_t keyCount() const
+    {
+        return _keyCount;
+    }
+
+    /**
+    *   @brief  Gets row of a frame in a bucket
+    *   @param  bucket bucket
+    *   @param  offset index of the frame in the bucket, may be equal to bucket size to get row of the next frame
+    *   @return row
+    */
+    quint64 row(const Bucket& bucket, quint64 offset) const;
+
+    /**
+    *   @brief  Gets row of a frame
+    *   @param  key sort key of the frame
+    *   @param  seq frame sequence number
+    *   @return row, or size() if frame is not indexed
+    */
+    quint64 row(const key_t& key, quint64 seq) const;
+
+    /**
+    *   @brief  Gets frame shown in a row
+    *   @param  row row less than size()
+    *   @return frame sequence number
+    */
+    quint64 seq(quint64 row) const;
+
+private:
+    static quint64 total(const std::unique_ptr<Bucket>& node)
+    {
+        return node ? node->total : 0;
+    }
+
+    Bucket* find(const key_t& key) const;
+    Bucket& insert(std::unique_ptr<Bucket>& node, std::unique_ptr<Bucket>& bucket);
+    void erase(std::unique_ptr<Bucket>& node, const key_t& key);
+    void add(const key_t& key, qint64 delta);
+    static void rotateLeft(std::unique_ptr<Bucket>& node);
+    static void rotateRight(std::unique_ptr<Bucket>& node);
+
+    std::unique_ptr<Bucket> _root;
+    quint32 _random{ 2463534242u }; // state of xorshift generator of priorities
+    std::size_t _keyCount{ 0 };
+    bool _descending{ false };
+    quint64 _size{ 0 };
+};
+
+#endif // SORTINDEX_H
@@ -0,0 +1,211 @@
+#include "uniqueframemodel.h"
+#include "framemodel.h"
+#include "framestore.h"
+#include <algorithm>
+#include <cstring>
+
+UniqueFrameModel::UniqueFrameModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void UniqueFrameModel::update(const FrameStore& store, quint64 index)
+{
+    markChanged(_states.update(store.firstSeq() + index, store.timeUs(index), store.id(index), store.flags(index),
+        store.payload(index), store.length(index)));
+}
+
+quint64 UniqueFrameModel::update(quint64 seq, qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length)
+{
+    const std::size_t state = _states.update(seq, timeUs, id, flags, payload, length);
+
+    markChanged(state);
+
+    return _states.at(state).changed;
+}
+
+void UniqueFrameModel::markChanged(std::size_t state)
+{
+    if (state >= _isChanged.size()) {
+        _isChanged.resize(state + 1, false);
+    }
+
+    if (!_isChanged[state]) {
+        _isChanged[state] = true;
+        _changed.push_back(state);
+    }
+}
+
+bool UniqueFrameModel::commit()
+{
+    if (_changed.empty()) {
+        return false;
+    }
+
+    if (_rows.size() < _states.size()) {
+        beginInsertRows(QModelIndex(), static_cast<int>(_rows.size()), static_cast<int>(_states.size()) - 1);
+        for (auto i = _rows.size(); i < _states.size(); ++i) {
+            _states.at(i).row = static_cast<int>(i);
+            _rows.push_back(i);
+        }
+        endInsertRows();
+    }
+
+    restoreOrder();
+
+    int first = rowCount();
+    int last = -1;
+
+    for (auto state : _changed) {
+        first = std::min(first, _states.at(state).row);
+        last = std::max(last, _states.at(state).row);
+        _isChanged[state] = false;
+    }
+
+    _changed.clear();
+
+    emit dataChanged(index(first, 0), index(last, FrameModel::ColumnCount - 1));
+
+    return true;
+}
+
+void UniqueFrameModel::clear()
+{
+    beginResetModel();
+    _states.clear();
+    _rows.clear();
+    _changed.clear();
+    _isChanged.clear();
+    endResetModel();
+}
+
+void UniqueFrameModel::sort(int column, Qt::SortOrder order)
+{
+    _sortColumn = column;
+    _sortOrder = order;
+    restoreOrder();
+}
+
+const FrameStateTable& UniqueFrameModel::states() const
+{
+    return _states;
+}
+
+int UniqueFrameModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(_rows.size());
+}
+
+int UniqueFrameModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : FrameModel::ColumnCount;
+}
+
+QVariant UniqueFrameModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || ((role != Qt::DisplayRole) && (role != FrameModel::ChangedRole))) {
+        return {};
+    }
+
+    const FrameState& state = _states.at(_rows[static_cast<std::size_t>(index.row())]);
+
+    if (role == FrameModel::ChangedRole) {
+        return (index.column() == FrameModel::Data) ? QVariant(static_cast<qulonglong>(state.changed)) : QVariant();
+    }
+
+    if ((index.column() == FrameModel::RowId) && (state.seq == FrameState::kNotStored)) {
+        return {};
+    }
+
+    return FrameModel::cell(
+        index.column(), state.seq, state.timeUs, state.id, state.flags, state.payload.data(), state.length);
+}
+
+QVariant UniqueFrameModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole) && (section >= 0)
+        && (section < FrameModel::ColumnCount)) {
+        return FrameModel::columnName(section);
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+bool UniqueFrameModel::lessThan(std::size_t a, std::size_t b) const
+{
+    const FrameState& left = _states.at((_sortOrder == Qt::AscendingOrder) ? a : b);
+    const FrameState& right = _states.at((_sortOrder == Qt::AscendingOrder) ? b : a);
+    int result = 0;
+
+    switch (_sortColumn) {
+    case FrameModel::RowId:
+        // Frames that are not stored are newer than all stored ones
+        result = (left.seq < right.seq) ? -1 : (left.seq > right.seq);
+        break;
+
+    case FrameModel::TimeDouble:
+    case FrameModel::Time:
+        result = (left.timeUs < right.timeUs) ? -1 : (left.timeUs > right.timeUs);
+        break;
+
+    case FrameModel::IdInt:
+    case FrameModel::Id:
+        result = (left.id < right.id) ? -1 : (left.id > right.id);
+        break;
+
+    case FrameModel::Dir:
+        result = (left.flags & FrameStore::Tx) - (right.flags & FrameStore::Tx);
+        break;
+
+    case FrameModel::Dlc:
+        result = left.length - right.length;
+        break;
+
+    case FrameModel::Data:
+        result = std::memcmp(left.payload.data(), right.payload.data(), std::min(left.length, right.length));
+        if (result == 0) {
+            result = left.length - right.length;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    // Rows with equal values stay in order of first reception
+    return (result != 0) ? (result < 0) : (a < b);
+}
+
+void UniqueFrameModel::restoreOrder()
+{
+    const auto less = [this](std::size_t a, std::size_t b) { return lessThan(a, b); };
+
+    if (std::is_sorted(_rows.begin(), _rows.end(), less)) {
+        return;
+    }
+
+    emit layoutAboutToBeChanged();
+
+    const QModelIndexList from = persistentIndexList();
+    std::vector<std::size_t> states;
+
+    for (const auto& index : from) {
+        states.push_back(_rows[static_cast<std::size_t>(index.row())]);
+    }
+
+    std::sort(_rows.begin(), _rows.end(), less);
+
+    for (std::size_t i = 0; i < _rows.size(); ++i) {
+        _states.at(_rows[i]).row = static_cast<int>(i);
+    }
+
+    QModelIndexList to;
+
+    for (int i = 0; i < from.size(); ++i) {
+        to.append(index(_states.at(states[static_cast<std::size_t>(i)]).row, from[i].column()));
+    }
+
+    changePersistentIndexList(from, to);
+
+    emit layoutChanged();
+}
@@ -0,0 +1,88 @@
+#ifndef UNIQUEFRAMEMODEL_H
+#define UNIQUEFRAMEMODEL_H
+
+#include "framestatetable.h"
+#include <QtCore/QAbstractTableModel>
+#include <vector>
+
+class FrameStore;
+
+/**
+*   @brief The class provides table model with the newest frame of each ID and direction. It shares columns with
+*          FrameModel.
+*
+*   Rows are states kept in FrameStateTable. Each frame updates its row in place, so the cost does not depend on
+*   number of captured frames. Like FrameModel, views are notified on commit(): new rows are inserted and changed rows
+*   are covered by a single dataChanged.
+*/
+class UniqueFrameModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit UniqueFrameModel(QObject* parent = nullptr);
+
+    /**
+    *   @brief  Updates row of frame ID and direction with a stored frame. Change is not visible until commit.
+    *   @param  store frame store
+    *   @param  index index of the frame in the store
+    */
+    void update(const FrameStore& store, quint64 index);
+
+    /**
+    *   @brief  Updates row of frame ID and direction with a frame before it is stored, or with a frame that is not
+    *           stored at all, e.g. elided from the table of all frames. Row ID of the row stays empty until a stored
+    *           frame arrives. Change is not visible until commit.
+    *   @param  seq sequence number of the frame, FrameState::kNotStored if it is not stored
+    *   @param  timeUs capture time in microseconds
+    *   @param  id frame ID
+    *   @param  flags combination of FrameStore::Flags
+    *   @param  payload payload bytes
+    *   @param  length payload length
+    *   @return payload bytes that differ from the previous frame of the same ID and direction, to be stored with
+    *           the frame
+    */
+    quint64 update(quint64 seq, qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length);
+
+    /**
+    *   @brief  Inserts rows of new IDs, restores sort order and notifies views about changed rows
+    *   @return true if model has changed
+    */
+    bool commit();
+
+    /**
+    *   @brief  Removes all rows
+    */
+    void clear();
+
+    /**
+    *   @brief  Sorts rows. Order is restored on commit if frames changed sorted values.
+    *   @param  column sort column, -1 for order of first reception
+    *   @param  order sort order
+    */
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    /**
+    *   @brief  Gets states of IDs and directions shown in the model
+    *   @return state table
+    */
+    const FrameStateTable& states() const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    void markChanged(std::size_t state);
+    bool lessThan(std::size_t a, std::size_t b) const;
+    void restoreOrder();
+
+    FrameStateTable _states;
+    std::vector<std::size_t> _rows; // state index by row
+    std::vector<std::size_t> _changed;
+    std::vector<bool> _isChanged;
+    int _sortColumn{ -1 };
+    Qt::SortOrder _sortOrder{ Qt::AscendingOrder };
+};
+
+#endif // UNIQUEFRAMEMODEL_H
@@ -0,0 +1,89 @@
+#include "canrecorder.h"
+#include "canrecorder_p.h"
+#include <QtSerialBus/QCanBusFrame>
+
+constexpr int CanRecorderPrivate::kBufferSize;
+constexpr int CanRecorderPrivate::kMaxBufferSize;
+constexpr int CanRecorderPrivate::kFlushIntervalMs;
+
+CanRecorder::CanRecorder()
+    : d_ptr(new CanRecorderPrivate(this))
+{
+}
+
+CanRecorder::~CanRecorder()
+{
+}
+
+void CanRecorder::setConfig(QJsonObject& json)
+{
+    Q_D(CanRecorder);
+
+    d->setConfig(json);
+}
+
+QJsonObject CanRecorder::getConfig() const
+{
+    Q_D(const CanRecorder);
+
+    return d->getConfig();
+}
+
+quint64 CanRecorder::recordedCount() const
+{
+    Q_D(const CanRecorder);
+
+    return d->recordedCount();
+}
+
+quint64 CanRecorder::droppedCount() const
+{
+    Q_D(const CanRecorder);
+
+    return d->droppedCount();
+}
+
+bool CanRecorder::hasError() const
+{
+    Q_D(const CanRecorder);
+
+    return d->hasError();
+}
+
+bool CanRecorder::isRecording() const
+{
+    Q_D(const CanRecorder);
+
+    return d->_writer != nullptr;
+}
+
+void CanRecorder::frameReceived(const QCanBusFrame& frame)
+{
+    Q_D(CanRecorder);
+
+    d->record(frame, false);
+}
+
+void CanRecorder::frameSent(bool status, const QCanBusFrame& frame)
+{
+    Q_D(CanRecorder);
+
+    // Only frames that made it to the bus are recorded
+    if (status) {
+        d->record(frame, true);
+    }
+}
+
+void CanRecorder::stopSimulation()
+{
+    Q_D(CanRecorder);
+
+    d->stop();
+}
+
+void CanRecorder::startSimulation()
+{
+    Q_D(CanRecorder);
+
+    d->start();
+}
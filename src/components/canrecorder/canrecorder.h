@@ -0,0 +1,68 @@
+#ifndef CANRECORDER_H
+#define CANRECORDER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <componentinterface.h>
+
+class QCanBusFrame;
+class CanRecorderPrivate;
+
+/**
+*   @brief The class provides component recording frames to disk during simulation. Files are written from background
+*          thread. Component doesn't have main widget, it is configured via node properties.
+*/
+class CanRecorder : public QObject, public ComponentInterface {
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(CanRecorder)
+
+public:
+    CanRecorder();
+    ~CanRecorder();
+
+    /**
+    *   @see ComponentInterface
+    */
+    void setConfig(QJsonObject& json) override;
+
+    /**
+    *   @see ComponentInterface
+    */
+    QJsonObject getConfig() const override;
+
+    /**
+    *   @brief  Gets number of frames written to disk since simulation start
+    *   @return number of frames
+    */
+    quint64 recordedCount() const;
+
+    /**
+    *   @brief  Gets number of frames dropped since simulation start because disk could not keep up or because of
+    *           write error
+    *   @return number of frames
+    */
+    quint64 droppedCount() const;
+
+    /**
+    *   @brief  Checks if capture file could not be opened or written
+    *   @return true if recording has failed
+    */
+    bool hasError() const;
+
+    /**
+    *   @brief  Checks if recording is in progress
+    *   @return true if recording
+    */
+    bool isRecording() const;
+
+public slots:
+    void frameReceived(const QCanBusFrame& frame);
+    void frameSent(bool status, const QCanBusFrame& frame);
+    void stopSimulation();
+    void startSimulation();
+
+private:
+    QScopedPointer<CanRecorderPrivate> d_ptr;
+};
+
+#endif // CANRECORDER_H
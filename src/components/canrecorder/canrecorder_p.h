@@ -0,0 +1,173 @@
+#ifndef CANRECORDER_P_H
+#define CANRECORDER_P_H
+
+#include "canrecorder.h"
+#include "recorderwriter.h"
+#include "recordformat.h"
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#include <memory>
+
+class CanRecorderPrivate : public QObject {
+    Q_OBJECT
+    Q_DECLARE_PUBLIC(CanRecorder)
+
+public:
+    CanRecorderPrivate(CanRecorder* q)
+        : _fileName(QDir::homePath() + "/cdsrecord")
+        , q_ptr(q)
+    {
+        connect(&_flushTimer, &QTimer::timeout, this, &CanRecorderPrivate::submit);
+    }
+
+    ~CanRecorderPrivate()
+    {
+        stop();
+    }
+
+    void setConfig(const QJsonObject& json)
+    {
+        if (json.contains("fileName")) {
+            _fileName = json["fileName"].toString();
+        }
+
+        if (json.contains("format")) {
+            _format = RecordFormat::formatFromString(json["format"].toString());
+        }
+
+        if (json.contains("interface")) {
+            _iface = json["interface"].toString().toLatin1();
+        }
+
+        if (json.contains("rotateSizeMB")) {
+            _rotateSizeMB = qMax(json["rotateSizeMB"].toInt(), 0);
+        }
+
+        if (json.contains("rotateMinutes")) {
+            _rotateMinutes = qMax(json["rotateMinutes"].toInt(), 0);
+        }
+    }
+
+    QJsonObject getConfig() const
+    {
+        return { { "fileName", _fileName }, { "format", RecordFormat::formatToString(_format) },
+            { "interface", QString::fromLatin1(_iface) }, { "rotateSizeMB", _rotateSizeMB },
+            { "rotateMinutes", _rotateMinutes } };
+    }
+
+    void start()
+    {
+        stop();
+
+        _recorded = 0;
+        _dropped = 0;
+        _buffered = 0;
+        _error = false;
+        _buffer.reserve(kBufferSize);
+        _startUs = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
+        _clock.start();
+
+        _writer = std::make_unique<RecorderWriter>(_fileName + "." + RecordFormat::extension(_format),
+            RecordFormat::fileHeader(_format), static_cast<qint64>(_rotateSizeMB) * 1024 * 1024,
+            static_cast<qint64>(_rotateMinutes) * 60 * 1000);
+        _writer->start();
+        _flushTimer.start(kFlushIntervalMs);
+    }
+
+    void stop()
+    {
+        if (_writer) {
+            _flushTimer.stop();
+            _writer->finish(_buffer, _buffered);
+            _recorded = _writer->framesWritten();
+            _dropped += _writer->framesLost();
+            _error = _writer->hasError();
+            _writer.reset();
+            _buffer.clear();
+            _buffered = 0;
+        }
+    }
+
+    void record(const QCanBusFrame& frame, bool tx)
+    {
+        if (!_writer) {
+            return;
+        }
+
+        // Memory is bounded. If disk can't keep up with the bus frames are dropped. Nothing is written after error.
+        if (_writer->hasError() || ((_buffer.size() >= kMaxBufferSize) && !trySubmit())) {
+            ++_dropped;
+            return;
+        }
+
+        RecordFormat::append(_buffer, _format, _startUs + _clock.nsecsElapsed() / 1000, _iface, frame, tx);
+        ++_buffered;
+
+        if (_buffer.size() >= kBufferSize) {
+            submit();
+        }
+    }
+
+    void submit()
+    {
+        if (_writer && !_buffer.isEmpty()) {
+            trySubmit();
+        }
+    }
+
+    bool trySubmit()
+    {
+        if (!_writer->trySubmit(_buffer, _buffered)) {
+            return false;
+        }
+
+        // Buffer handed back by the writer keeps its capacity, so this allocates only for the first two buffers
+        _buffer.reserve(kBufferSize);
+        _buffered = 0;
+
+        return true;
+    }
+
+    quint64 recordedCount() const
+    {
+        return _writer ? _writer->framesWritten() : _recorded;
+    }
+
+    quint64 droppedCount() const
+    {
+        return _writer ? _dropped + _writer->framesLost() : _dropped;
+    }
+
+    bool hasError() const
+    {
+        return _writer ? _writer->hasError() : _error;
+    }
+
+    static constexpr int kBufferSize = 1024 * 1024;
+    static constexpr int kMaxBufferSize = 16 * 1024 * 1024;
+    static constexpr int kFlushIntervalMs = 200;
+
+    QString _fileName;
+    RecordFormat::Format _format{ RecordFormat::Format::Candump };
+    QByteArray _iface{ "can0" };
+    int _rotateSizeMB{ 0 };
+    int _rotateMinutes{ 0 };
+
+    std::unique_ptr<RecorderWriter> _writer;
+    QByteArray _buffer;
+    QTimer _flushTimer;
+    QElapsedTimer _clock;
+    quint64 _startUs{ 0 };
+    quint64 _buffered{ 0 }; // frames in buffer
+    quint64 _recorded{ 0 }; // frames written by writer that has been stopped
+    quint64 _dropped{ 0 };
+    bool _error{ false };
+
+private:
+    CanRecorder* q_ptr;
+};
+
+#endif // CANRECORDER_P_H
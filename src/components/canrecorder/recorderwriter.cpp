@@ -0,0 +1,169 @@
+#include "recorderwriter.h"
+#include <QtCore/QFileInfo>
+#include <log.h>
+
+RecorderWriter::RecorderWriter(
+    const QString& fileName, const QByteArray& header, qint64 rotateSize, qint64 rotateIntervalMs)
+    : _fileName(fileName)
+    , _header(header)
+    , _rotateSize(rotateSize)
+    , _rotateIntervalMs(rotateIntervalMs)
+{
+}
+
+RecorderWriter::~RecorderWriter()
+{
+    QByteArray empty;
+
+    finish(empty, 0);
+}
+
+bool RecorderWriter::trySubmit(QByteArray& buffer, quint64 frames)
+{
+    QMutexLocker lock(&_mutex);
+
+    if (_hasPending) {
+        return false;
+    }
+
+    // Buffer written before is handed back
+    _pending.swap(buffer);
+    _pendingFrames = frames;
+    _hasPending = true;
+    _dataReady.wakeOne();
+
+    return true;
+}
+
+void RecorderWriter::finish(QByteArray& buffer, quint64 frames)
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    while (!buffer.isEmpty() && !trySubmit(buffer, frames)) {
+        QThread::msleep(1);
+    }
+
+    {
+        QMutexLocker lock(&_mutex);
+        _stop = true;
+        _dataReady.wakeOne();
+    }
+
+    wait();
+}
+
+quint64 RecorderWriter::bytesWritten() const
+{
+    return _bytesWritten;
+}
+
+quint64 RecorderWriter::framesWritten() const
+{
+    return _framesWritten;
+}
+
+quint64 RecorderWriter::framesLost() const
+{
+    return _framesLost;
+}
+
+bool RecorderWriter::hasError() const
+{
+    return _error;
+}
+
+void RecorderWriter::run()
+{
+    forever {
+        quint64 frames = 0;
+
+        {
+            QMutexLocker lock(&_mutex);
+
+            while (!_hasPending && !_stop) {
+                _dataReady.wait(&_mutex);
+            }
+
+            if (!_hasPending) {
+                break;
+            }
+
+            // Emptied buffer goes to pending, so it is handed back on next submit
+            _writing.swap(_pending);
+            frames = _pendingFrames;
+            _hasPending = false;
+        }
+
+        write(_writing, frames);
+
+        // Reserved capacity is kept when buffer is emptied
+        _writing.resize(0);
+    }
+
+    _file.close();
+}
+
+void RecorderWriter::write(const QByteArray& data, quint64 frames)
+{
+    // Failed file is not retried, so a bad path does not create a new file and error for every buffer
+    if (_error) {
+        _framesLost += frames;
+        return;
+    }
+
+    // File gets at least one buffer, even if buffer alone exceeds size limit
+    const bool rotateBySize
+        = (_rotateSize > 0) && (_fileSize > _header.size()) && (_fileSize + data.size() > _rotateSize);
+    const bool rotateByTime
+        = (_rotateIntervalMs > 0) && _fileAge.isValid() && (_fileAge.elapsed() >= _rotateIntervalMs);
+
+    if ((!_file.isOpen() || rotateBySize || rotateByTime) && !openNextFile()) {
+        _framesLost += frames;
+        return;
+    }
+
+    if (_file.write(data) != data.size()) {
+        cds_error("Failed to write '{}': {}", _file.fileName().toStdString(), _file.errorString().toStdString());
+        _error = true;
+        _framesLost += frames;
+        return;
+    }
+
+    _fileSize += data.size();
+    _bytesWritten += data.size();
+    _framesWritten += frames;
+}
+
+bool RecorderWriter::openNextFile()
+{
+    QString fileName = _fileName;
+
+    _file.close();
+
+    if ((_rotateSize > 0) || (_rotateIntervalMs > 0)) {
+        const QFileInfo info(_fileName);
+        const QString suffix = info.suffix().isEmpty() ? QString() : "." + info.suffix();
+
+        fileName = info.path() + "/" + info.completeBaseName() + QString("_%1").arg(_fileIndex, 4, 10, QChar('0'))
+            + suffix;
+    }
+
+    ++_fileIndex;
+    _file.setFileName(fileName);
+
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        cds_error("Could not open file '{}'", fileName.toStdString());
+        _error = true;
+        return false;
+    }
+
+    cds_info("Recording to '{}'", fileName.toStdString());
+
+    _file.write(_header);
+    _fileSize = _header.size();
+    _fileAge.start();
+
+    return true;
+}
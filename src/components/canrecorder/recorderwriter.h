@@ -0,0 +1,102 @@
+#ifndef RECORDERWRITER_H
+#define RECORDERWRITER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+#include <atomic>
+
+/**
+*   @brief The class provides background thread writing capture buffers to disk.
+*
+*   Writer accepts one buffer at a time. Producer fills its own buffer while the previous one is being written and
+*   swaps buffers with the writer, so data is never copied and disk access never blocks the producer. Producer gets
+*   back the buffer written before, emptied but with its capacity, so the two buffers are reused.
+*   Files are rotated on buffer boundaries, so records are never split between files. After the first error nothing
+*   more is written and submitted frames are counted as lost.
+*/
+class RecorderWriter : public QThread {
+public:
+    /**
+    *   @brief  Constructor
+    *   @param  fileName path to capture file. With rotation enabled consecutive files get _<n> suffix.
+    *   @param  header data written at the beginning of every file
+    *   @param  rotateSize maximum file size in bytes, 0 disables size based rotation
+    *   @param  rotateIntervalMs maximum file age in milliseconds, 0 disables time based rotation
+    */
+    RecorderWriter(const QString& fileName, const QByteArray& header, qint64 rotateSize, qint64 rotateIntervalMs);
+    ~RecorderWriter();
+
+    /**
+    *   @brief  Passes buffer to the writer if previous one has been already taken
+    *   @param  buffer data to be written. On success it is swapped with an empty buffer.
+    *   @param  frames number of frames in the buffer
+    *   @return true if buffer was accepted, false if writer is busy
+    */
+    bool trySubmit(QByteArray& buffer, quint64 frames);
+
+    /**
+    *   @brief  Writes remaining data and stops the thread
+    *   @param  buffer last data to be written
+    *   @param  frames number of frames in the buffer
+    */
+    void finish(QByteArray& buffer, quint64 frames);
+
+    /**
+    *   @brief  Gets number of bytes written to disk
+    *   @return bytes written in all files
+    */
+    quint64 bytesWritten() const;
+
+    /**
+    *   @brief  Gets number of frames written to disk
+    *   @return frames written in all files
+    */
+    quint64 framesWritten() const;
+
+    /**
+    *   @brief  Gets number of submitted frames that were not written because of error
+    *   @return number of frames
+    */
+    quint64 framesLost() const;
+
+    /**
+    *   @brief  Checks if write error occurred
+    *   @return true if any file could not be opened or written
+    */
+    bool hasError() const;
+
+protected:
+    void run() override;
+
+private:
+    void write(const QByteArray& data, quint64 frames);
+    bool openNextFile();
+
+    const QString _fileName;
+    const QByteArray _header;
+    const qint64 _rotateSize;
+    const qint64 _rotateIntervalMs;
+
+    QMutex _mutex;
+    QWaitCondition _dataReady;
+    QByteArray _pending;
+    quint64 _pendingFrames{ 0 };
+    bool _hasPending{ false };
+    QByteArray _writing;
+    bool _stop{ false };
+
+    QFile _file;
+    qint64 _fileSize{ 0 };
+    QElapsedTimer _fileAge;
+    int _fileIndex{ 0 };
+    std::atomic<quint64> _bytesWritten{ 0 };
+    std::atomic<quint64> _framesWritten{ 0 };
+    std::atomic<quint64> _framesLost{ 0 };
+    std::atomic<bool> _error{ false };
+};
+
+#endif // RECORDERWRITER_H
@@ -0,0 +1,123 @@
+#include "recordformat.h"
+#include <QtCore/QtEndian>
+#include <QtSerialBus/QCanBusFrame>
+#include <cstring>
+#include <hexformat.h>
+
+namespace {
+void appendDecimal(char*& out, quint64 value, int digits)
+{
+    for (int i = digits - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+
+    out += digits;
+}
+
+void appendCandump(QByteArray& out, quint64 timestampUs, const QByteArray& iface, const QCanBusFrame& frame)
+{
+    const QByteArray payload = frame.payload();
+    // "(" + 10 + "." + 6 + ") " + iface + " " + 8 + "##0" + 2 * 64 + "\n"
+    const int maxSize = 22 + iface.size() + 12 + 2 * payload.size();
+    const int start = out.size();
+
+    out.resize(start + maxSize);
+
+    char* p = out.data() + start;
+
+    *p++ = '(';
+    appendDecimal(p, timestampUs / 1000000, 10);
+    *p++ = '.';
+    appendDecimal(p, timestampUs % 1000000, 6);
+    *p++ = ')';
+    *p++ = ' ';
+    memcpy(p, iface.constData(), iface.size());
+    p += iface.size();
+    *p++ = ' ';
+    p = HexFormat::writeHex(p, frame.frameId(), frame.hasExtendedFrameFormat() ? 8 : 3, true);
+    *p++ = '#';
+
+    if (frame.frameType() == QCanBusFrame::RemoteRequestFrame) {
+        *p++ = 'R';
+    } else {
+        // Frames longer than 8 bytes are CAN FD
+        if (payload.size() > 8) {
+            *p++ = '#';
+            *p++ = '0';
+        }
+
+        p = HexFormat::writeBytes(p, payload.constData(), payload.size(), 0, true);
+    }
+
+    *p++ = '\n';
+
+    out.resize(static_cast<int>(p - out.constData()));
+}
+
+void appendBinary(QByteArray& out, quint64 timestampUs, const QCanBusFrame& frame, bool tx)
+{
+    const QByteArray payload = frame.payload();
+    const int start = out.size();
+    quint32 id = frame.frameId();
+
+    id |= frame.hasExtendedFrameFormat() ? RecordFormat::kExtendedFlag : 0;
+    id |= tx ? RecordFormat::kTxFlag : 0;
+    id |= (frame.frameType() == QCanBusFrame::RemoteRequestFrame) ? RecordFormat::kRemoteFlag : 0;
+
+    out.resize(start + 13 + payload.size());
+
+    uchar* p = reinterpret_cast<uchar*>(out.data() + start);
+
+    qToLittleEndian<quint64>(timestampUs, p);
+    qToLittleEndian<quint32>(id, p + 8);
+    p[12] = static_cast<uchar>(payload.size());
+    memcpy(p + 13, payload.constData(), payload.size());
+}
+}
+
+constexpr quint32 RecordFormat::kBinaryMagic;
+constexpr quint32 RecordFormat::kBinaryVersion;
+constexpr quint32 RecordFormat::kExtendedFlag;
+constexpr quint32 RecordFormat::kTxFlag;
+constexpr quint32 RecordFormat::kRemoteFlag;
+
+QByteArray RecordFormat::fileHeader(Format format)
+{
+    if (format != Format::Binary) {
+        return {};
+    }
+
+    QByteArray header(12, '\0');
+    uchar* p = reinterpret_cast<uchar*>(header.data());
+
+    qToLittleEndian<quint32>(kBinaryMagic, p);
+    qToLittleEndian<quint32>(kBinaryVersion, p + 4);
+
+    return header;
+}
+
+QString RecordFormat::extension(Format format)
+{
+    return (format == Format::Binary) ? "cdsr" : "log";
+}
+
+void RecordFormat::append(QByteArray& out, Format format, quint64 timestampUs, const QByteArray& iface,
+    const QCanBusFrame& frame, bool tx)
+{
+    if (format == Format::Binary) {
+        appendBinary(out, timestampUs, frame, tx);
+    } else {
+        appendCandump(out, timestampUs, iface, frame);
+    }
+}
+
+QString RecordFormat::formatToString(Format format)
+{
+    return (format == Format::Binary) ? "binary" : "candump";
+}
+
+RecordFormat::Format RecordFormat::formatFromString(const QString& format)
+{
+    return (format == "binary") ? Format::Binary : Format::Candump;
+}
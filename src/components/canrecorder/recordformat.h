@@ -0,0 +1,60 @@
+#ifndef RECORDFORMAT_H
+#define RECORDFORMAT_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+class QCanBusFrame;
+
+/**
+*   @brief The class provides serialization of frames to capture files.
+*
+*   Candump format is the text format of candump -l, e.g. "(1500000000.123456) can0 123#DEADBEEF".
+*
+*   Binary format starts with a header (magic "CDSR", version, reserved, all 32-bit little endian) followed by records:
+*       quint64 timestamp in microseconds since epoch
+*       quint32 frame ID, bit 31 set for extended format, bit 30 for transmitted frames, bit 29 for remote requests
+*       quint8  payload length
+*       payload
+*/
+class RecordFormat {
+public:
+    enum class Format { Candump, Binary };
+
+    static constexpr quint32 kBinaryMagic = 0x52534443; // "CDSR" in little endian
+    static constexpr quint32 kBinaryVersion = 1;
+    static constexpr quint32 kExtendedFlag = 0x80000000;
+    static constexpr quint32 kTxFlag = 0x40000000;
+    static constexpr quint32 kRemoteFlag = 0x20000000;
+
+    /**
+    *   @brief  Gets data to be written at the beginning of every file
+    *   @param  format file format
+    *   @return file header, empty for text formats
+    */
+    static QByteArray fileHeader(Format format);
+
+    /**
+    *   @brief  Gets file name extension
+    *   @param  format file format
+    *   @return extension without dot
+    */
+    static QString extension(Format format);
+
+    /**
+    *   @brief  Serializes frame and appends it to buffer
+    *   @param  out buffer
+    *   @param  format file format
+    *   @param  timestampUs timestamp in microseconds since epoch
+    *   @param  iface interface name, used by candump format
+    *   @param  frame frame to be serialized
+    *   @param  tx true if frame was transmitted
+    */
+    static void append(QByteArray& out, Format format, quint64 timestampUs, const QByteArray& iface,
+        const QCanBusFrame& frame, bool tx);
+
+    static QString formatToString(Format format);
+    static Format formatFromString(const QString& format);
+};
+
+#endif // RECORDFORMAT_H
@@ -4,6 +4,17 @@
 #include <log.h>
 
 CanDeviceModel::CanDeviceModel()
+{
+    init();
+}
+
+CanDeviceModel::CanDeviceModel(CanDeviceCtx&& ctx)
+    : ComponentModel(std::move(ctx))
+{
+    init();
+}
+
+void CanDeviceModel::init()
 {
     _label->setAlignment(Qt::AlignVCenter | Qt::AlignHCenter);
     _label->setFixedSize(75, 25);
@@ -18,6 +29,10 @@ CanDeviceModel::CanDeviceModel()
     _modelName = "CAN device";
 
     _component.init("socketcan", "can0"); // TODO
+
+    // Frames requested to be sent must not be lost, queue only spreads processing over time
+    initInputQueues(1, [this](const std::shared_ptr<NodeData>& nodeData, PortIndex) { processInData(nodeData); },
+        InputQueue::Delivery::Lossless);
 }
 
 unsigned int CanDeviceModel::nPorts(PortType portType) const
@@ -27,22 +42,21 @@ unsigned int CanDeviceModel::nPorts(PortType portType) const
     return (PortType::None != portType) ? 1 : 0;
 }
 
-void CanDeviceModel::frameOnQueue()
+void CanDeviceModel::publish(const std::shared_ptr<CanDeviceDataOut>& data)
 {
-    std::tie(_frame, _direction, _status) = _frameQueue.takeFirst();
+    // The same immutable object is propagated to all connections, consumers must not copy it
+    _nodeData = data;
     emit dataUpdated(0); // Data ready on port 0
 }
 
 void CanDeviceModel::frameReceived(const QCanBusFrame& frame)
 {
-    _frameQueue.push_back(std::make_tuple(frame, Direction::RX, false));
-    frameOnQueue();
+    publish(std::make_shared<CanDeviceDataOut>(frame, Direction::RX, false));
 }
 
 void CanDeviceModel::frameSent(bool status, const QCanBusFrame& frame)
 {
-    _frameQueue.push_back(std::make_tuple(frame, Direction::TX, status));
-    frameOnQueue();
+    publish(std::make_shared<CanDeviceDataOut>(frame, Direction::TX, status));
 }
 
 NodeDataType CanDeviceModel::dataType(PortType portType, PortIndex) const
@@ -54,10 +68,19 @@ NodeDataType CanDeviceModel::dataType(PortType portType, PortIndex) const
 
 std::shared_ptr<NodeData> CanDeviceModel::outData(PortIndex)
 {
-    return std::make_shared<CanDeviceDataOut>(_frame, _direction, _status);
+    if (!_nodeData) {
+        _nodeData = std::make_shared<CanDeviceDataOut>();
+    }
+
+    return _nodeData;
+}
+
+void CanDeviceModel::setInData(std::shared_ptr<NodeData> nodeData, PortIndex port)
+{
+    _inQueues[port]->push(nodeData);
 }
 
-void CanDeviceModel::setInData(std::shared_ptr<NodeData> nodeData, PortIndex)
+void CanDeviceModel::processInData(const std::shared_ptr<NodeData>& nodeData)
 {
     if (nodeData) {
         auto d = std::dynamic_pointer_cast<CanDeviceDataIn>(nodeData);
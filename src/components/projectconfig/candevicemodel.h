@@ -11,7 +11,7 @@ using QtNodes::PortIndex;
 using QtNodes::NodeData;
 using QtNodes::NodeDataType;
 
-enum class Direction;
+class CanDeviceDataOut;
 
 /**
 *   @brief The class provides node graphical representation of CanDevice
@@ -22,6 +22,12 @@ class CanDeviceModel : public ComponentModel<CanDevice, CanDeviceModel> {
 public:
     CanDeviceModel();
 
+    /**
+    *   @brief  Constructor
+    *   @param  ctx CanDevice context, allows to replace CAN backend (e.g. in benchmarks)
+    */
+    explicit CanDeviceModel(CanDeviceCtx&& ctx);
+
     /**
     *   @brief  Used to get number of ports of each type used by model
     *   @param  type of port
@@ -38,24 +44,19 @@ public:
     NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
 
     /**
-    *   @brief  Sets output data for propagation
+    *   @brief  Gets output data for propagation. Object is shared by all connections of the port.
     *   @param  port id
-    *   @return CanDeviceDataOut or CanDeviceDataIn filled with data
+    *   @return CanDeviceDataOut filled with data
     */
     std::shared_ptr<NodeData> outData(PortIndex port) override;
 
     /**
-    *   @brief  Handles data on input port, sends frame if correct
+    *   @brief  Passes data received on input port to the port queue
     *   @param  data on port
     *   @param  port id
     */
     void setInData(std::shared_ptr<NodeData> nodeData, PortIndex port) override;
 
-    /**
-    *   @brief Used to send frames that were put in queue
-    */
-    void frameOnQueue();
-
 public slots:
 
     /**
@@ -79,11 +80,24 @@ signals:
     void sendFrame(const QCanBusFrame& frame);
 
 private:
-    std::shared_ptr<NodeData> _nodeData;
-    QVector<std::tuple<QCanBusFrame, Direction, bool>> _frameQueue;
-    bool _status;
-    Direction _direction;
-    QCanBusFrame _frame;
+    /**
+    *   @brief  Handles data taken from input queue, sends frame if correct
+    *   @param  data on port
+    */
+    void processInData(const std::shared_ptr<NodeData>& nodeData);
+
+    /**
+    *   @brief  Sets data on output port and notifies connections
+    *   @param  data output data
+    */
+    void publish(const std::shared_ptr<CanDeviceDataOut>& data);
+
+    /**
+    *   @brief  Sets up label, connections and input queue. Shared by constructors.
+    */
+    void init();
+
+    std::shared_ptr<CanDeviceDataOut> _nodeData;
 };
 
 #endif // CANDEVICEMODEL_H
@@ -0,0 +1,65 @@
+#include "canexpressionmodel.h"
+#include <datamodeltypes/candevicedata.h>
+#include <log.h>
+
+CanExpressionModel::CanExpressionModel()
+{
+    _label->setAlignment(Qt::AlignVCenter | Qt::AlignHCenter);
+    _label->setFixedSize(75, 25);
+    _label->setAttribute(Qt::WA_TranslucentBackground);
+
+    _caption = "CanExpression Node";
+    _name = "CanExpressionModel";
+    _modelName = "Expression";
+
+    initInputQueues(1, [this](const std::shared_ptr<NodeData>& nodeData, PortIndex) { processInData(nodeData); });
+    exposeComponentProperties({ "expression" });
+}
+
+unsigned int CanExpressionModel::nPorts(PortType portType) const
+{
+    return (PortType::None != portType) ? 1 : 0;
+}
+
+NodeDataType CanExpressionModel::dataType(PortType, PortIndex) const
+{
+    return CanDeviceDataOut{}.type();
+}
+
+std::shared_ptr<NodeData> CanExpressionModel::outData(PortIndex)
+{
+    if (!_nodeData) {
+        _nodeData = std::make_shared<CanDeviceDataOut>();
+    }
+
+    return _nodeData;
+}
+
+void CanExpressionModel::setInData(std::shared_ptr<NodeData> nodeData, PortIndex port)
+{
+    _inQueues[port]->push(nodeData);
+}
+
+QString CanExpressionModel::nodeStatus() const
+{
+    if (_component.evaluationCount() == 0) {
+        return {};
+    }
+
+    return QString("%1 ns").arg(_component.averageCostNs());
+}
+
+void CanExpressionModel::processInData(const std::shared_ptr<NodeData>& nodeData)
+{
+    if (nodeData) {
+        auto d = std::dynamic_pointer_cast<CanDeviceDataOut>(nodeData);
+        assert(nullptr != d);
+
+        if (_component.evaluate(d->frame(), d->direction() == Direction::TX)) {
+            _nodeData = d;
+            emit dataUpdated(0); // Data ready on port 0
+        }
+    } else {
+        cds_warn("Incorrect nodeData");
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef CANEXPRESSIONMODEL_H
+#define CANEXPRESSIONMODEL_H
+
+#include "componentmodel.h"
+#include <canexpression.h>
+
+using QtNodes::PortType;
+using QtNodes::PortIndex;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+
+class CanDeviceDataOut;
+
+/**
+*   @brief The class provides node graphical representation of CanExpression
+*/
+class CanExpressionModel : public ComponentModel<CanExpression, CanExpressionModel> {
+    Q_OBJECT
+
+public:
+    CanExpressionModel();
+
+    /**
+    *   @brief  Used to get number of ports of each type used by model
+    *   @param  type of port
+    *   @return 1 if port in or out, 0 if any other type
+    */
+    unsigned int nPorts(PortType portType) const override;
+
+    /**
+    *   @brief  Used to get data type of each port
+    *   @param  type of port
+    *   @patam  port id
+    *   @return CanDeviceDataOut type for both in and out ports
+    */
+    NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
+
+    /**
+    *   @brief  Gets output data for propagation. Input data meeting the condition is forwarded without copying.
+    *   @param  port id
+    *   @return last CanDeviceDataOut that met the condition
+    */
+    std::shared_ptr<NodeData> outData(PortIndex port) override;
+
+    /**
+    *   @brief  Passes data received on input port to the port queue
+    *   @param  data on port
+    *   @param  port id
+    */
+    void setInData(std::shared_ptr<NodeData> nodeData, PortIndex port) override;
+
+protected:
+    /**
+    *   @brief  Shows average evaluation time
+    *   @return status text
+    */
+    QString nodeStatus() const override;
+
+private:
+    /**
+    *   @brief  Handles data taken from input queue, forwards frame if it meets the condition
+    *   @param  data on port
+    */
+    void processInData(const std::shared_ptr<NodeData>& nodeData);
+
+    std::shared_ptr<CanDeviceDataOut> _nodeData;
+};
+
+#endif // CANEXPRESSIONMODEL_H
@@ -0,0 +1,56 @@
+#include "canfiltermodel.h"
+#include <datamodeltypes/candevicedata.h>
+#include <log.h>
+
+CanFilterModel::CanFilterModel()
+{
+    _label->setAlignment(Qt::AlignVCenter | Qt::AlignHCenter);
+    _label->setFixedSize(75, 25);
+    _label->setAttribute(Qt::WA_TranslucentBackground);
+
+    _caption = "CanFilter Node";
+    _name = "CanFilterModel";
+    _modelName = "Filter";
+
+    initInputQueues(1, [this](const std::shared_ptr<NodeData>& nodeData, PortIndex) { processInData(nodeData); });
+    exposeComponentProperties({ "rules", "mode" });
+}
+
+unsigned int CanFilterModel::nPorts(PortType portType) const
+{
+    return (PortType::None != portType) ? 1 : 0;
+}
+
+NodeDataType CanFilterModel::dataType(PortType, PortIndex) const
+{
+    return CanDeviceDataOut{}.type();
+}
+
+std::shared_ptr<NodeData> CanFilterModel::outData(PortIndex)
+{
+    if (!_nodeData) {
+        _nodeData = std::make_shared<CanDeviceDataOut>();
+    }
+
+    return _nodeData;
+}
+
+void CanFilterModel::setInData(std::shared_ptr<NodeData> nodeData, PortIndex port)
+{
+    _inQueues[port]->push(nodeData);
+}
+
+void CanFilterModel::processInData(const std::shared_ptr<NodeData>& nodeData)
+{
+    if (nodeData) {
+        auto d = std::dynamic_pointer_cast<CanDeviceDataOut>(nodeData);
+        assert(nullptr != d);
+
+        if (_component.accepts(d->frame())) {
+            _nodeData = d;
+            emit dataUpdated(0); // Data ready on port 0
+        }
+    } else {
+        cds_warn("Incorrect nodeData");
+    }
+}
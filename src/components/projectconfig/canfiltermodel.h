@@ -0,0 +1,62 @@
+#ifndef CANFILTERMODEL_H
+#define CANFILTERMODEL_H
+
+#include "componentmodel.h"
+#include <canfilter.h>
+
+using QtNodes::PortType;
+using QtNodes::PortIndex;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+
+class CanDeviceDataOut;
+
+/**
+*   @brief The class provides node graphical representation of CanFilter
+*/
+class CanFilterModel : public ComponentModel<CanFilter, CanFilterModel> {
+    Q_OBJECT
+
+public:
+    CanFilterModel();
+
+    /**
+    *   @brief  Used to get number of ports of each type used by model
+    *   @param  type of port
+    *   @return 1 if port in or out, 0 if any other type
+    */
+    unsigned int nPorts(PortType portType) const override;
+
+    /**
+    *   @brief  Used to get data type of each port
+    *   @param  type of port
+    *   @patam  port id
+    *   @return CanDeviceDataOut type for both in and out ports
+    */
+    NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
+
+    /**
+    *   @brief  Gets output data for propagation. Accepted input data is forwarded without copying.
+    *   @param  port id
+    *   @return last accepted CanDeviceDataOut
+    */
+    std::shared_ptr<NodeData> outData(PortIndex port) override;
+
+    /**
+    *   @brief  Passes data received on input port to the port queue
+    *   @param  data on port
+    *   @param  port id
+    */
+    void setInData(std::shared_ptr<NodeData> nodeData, PortIndex port) override;
+
+private:
+    /**
+    *   @brief  Handles data taken from input queue, forwards frame if it passes the filter
+    *   @param  data on port
+    */
+    void processInData(const std::shared_ptr<NodeData>& nodeData);
+
+    std::shared_ptr<CanDeviceDataOut> _nodeData;
+};
+
+#endif // CANFILTERMODEL_H
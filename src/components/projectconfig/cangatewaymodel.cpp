@@ -0,0 +1,67 @@
+#include "cangatewaymodel.h"
+#include <datamodeltypes/candevicedata.h>
+#include <log.h>
+
+CanGatewayModel::CanGatewayModel()
+    : _nodeData(CanGateway::kPortCount)
+{
+    _label->setAlignment(Qt::AlignVCenter | Qt::AlignHCenter);
+    _label->setFixedSize(75, 25);
+    _label->setAttribute(Qt::WA_TranslucentBackground);
+
+    connect(&_component, &CanGateway::frameRouted, this, &CanGatewayModel::frameRouted);
+    connect(this, &CanGatewayModel::frameReceived, &_component, &CanGateway::frameReceived);
+
+    _caption = "CanGateway Node";
+    _name = "CanGatewayModel";
+    _modelName = "Gateway";
+
+    initInputQueues(CanGateway::kPortCount,
+        [this](const std::shared_ptr<NodeData>& nodeData, PortIndex port) { processInData(nodeData, port); });
+    exposeComponentProperties({ "rules" });
+}
+
+unsigned int CanGatewayModel::nPorts(PortType portType) const
+{
+    return (PortType::None != portType) ? CanGateway::kPortCount : 0;
+}
+
+NodeDataType CanGatewayModel::dataType(PortType portType, PortIndex) const
+{
+    return (PortType::Out == portType) ? CanDeviceDataIn{}.type() : CanDeviceDataOut{}.type();
+}
+
+std::shared_ptr<NodeData> CanGatewayModel::outData(PortIndex port)
+{
+    if (!_nodeData[port]) {
+        _nodeData[port] = std::make_shared<CanDeviceDataIn>();
+    }
+
+    return _nodeData[port];
+}
+
+void CanGatewayModel::setInData(std::shared_ptr<NodeData> nodeData, PortIndex port)
+{
+    _inQueues[port]->push(nodeData);
+}
+
+void CanGatewayModel::frameRouted(int port, const QCanBusFrame& frame)
+{
+    _nodeData[port] = std::make_shared<CanDeviceDataIn>(frame);
+    emit dataUpdated(port);
+}
+
+void CanGatewayModel::processInData(const std::shared_ptr<NodeData>& nodeData, PortIndex port)
+{
+    if (nodeData) {
+        auto d = std::dynamic_pointer_cast<CanDeviceDataOut>(nodeData);
+        assert(nullptr != d);
+
+        // Transmitted frames come back from the device. Routing them would create a loop.
+        if (d->direction() == Direction::RX) {
+            emit frameReceived(port, d->frame());
+        }
+    } else {
+        cds_warn("Incorrect nodeData");
+    }
+}
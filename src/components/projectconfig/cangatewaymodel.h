@@ -0,0 +1,81 @@
+#ifndef CANGATEWAYMODEL_H
+#define CANGATEWAYMODEL_H
+
+#include "componentmodel.h"
+#include <QtSerialBus/QCanBusFrame>
+#include <cangateway.h>
+#include <vector>
+
+using QtNodes::PortType;
+using QtNodes::PortIndex;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+
+class CanDeviceDataIn;
+
+/**
+*   @brief The class provides node graphical representation of CanGateway
+*/
+class CanGatewayModel : public ComponentModel<CanGateway, CanGatewayModel> {
+    Q_OBJECT
+
+public:
+    CanGatewayModel();
+
+    /**
+    *   @brief  Used to get number of ports of each type used by model
+    *   @param  type of port
+    *   @return CanGateway::kPortCount if port in or out, 0 if any other type
+    */
+    unsigned int nPorts(PortType portType) const override;
+
+    /**
+    *   @brief  Used to get data type of each port
+    *   @param  type of port
+    *   @patam  port id
+    *   @return CanDeviceDataIn type if portType is out, CanDeviceDataOut type if portType is in
+    */
+    NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
+
+    /**
+    *   @brief  Gets output data for propagation
+    *   @param  port id
+    *   @return CanDeviceDataIn with last frame routed to the port
+    */
+    std::shared_ptr<NodeData> outData(PortIndex port) override;
+
+    /**
+    *   @brief  Passes data received on input port to the port queue
+    *   @param  data on port
+    *   @param  port id
+    */
+    void setInData(std::shared_ptr<NodeData> nodeData, PortIndex port) override;
+
+public slots:
+    /**
+    *   @brief  Callback, called when CanGateway emits signal frameRouted
+    *   @param  port output port
+    *   @param  frame frame to be sent
+    */
+    void frameRouted(int port, const QCanBusFrame& frame);
+
+signals:
+    /**
+    *   @brief  Emitted for received frames
+    *   @param  port input port
+    *   @param  frame received frame
+    */
+    void frameReceived(int port, const QCanBusFrame& frame);
+
+private:
+    /**
+    *   @brief  Handles data taken from input queue. Only received frames are routed.
+    *   @param  data on port
+    *   @param  port id
+    */
+    void processInData(const std::shared_ptr<NodeData>& nodeData, PortIndex port);
+
+    std::vector<std::shared_ptr<CanDeviceDataIn>> _nodeData;
+};
+
+#endif // CANGATEWAYMODEL_H
@@ -0,0 +1,66 @@
+#include "canmonitormodel.h"
+#include <datamodeltypes/candevicedata.h>
+#include <log.h>
+
+CanMonitorModel::CanMonitorModel()
+{
+    _label->setAlignment(Qt::AlignVCenter | Qt::AlignHCenter);
+    _label->setFixedSize(75, 25);
+    _label->setAttribute(Qt::WA_TranslucentBackground);
+
+    _caption = "CanMonitor Node";
+    _name = "CanMonitorModel";
+    _modelName = "Monitor";
+
+    connect(this, &CanMonitorModel::frameReceived, &_component, &CanMonitor::frameReceived);
+
+    connect(&_component, &CanMonitor::periodViolated, this, [this] { scheduleStatsUpdate(); });
+
+    // Arrival time is measured when frame is processed, so frames must not wait in the queue
+    initInputQueues(1, [this](const std::shared_ptr<NodeData>& nodeData, PortIndex) { processInData(nodeData); },
+        InputQueue::Delivery::Immediate);
+    exposeComponentProperties({ "periods", "tolerance", "learn" });
+}
+
+unsigned int CanMonitorModel::nPorts(PortType portType) const
+{
+    return (PortType::In == portType) ? 1 : 0;
+}
+
+NodeDataType CanMonitorModel::dataType(PortType, PortIndex) const
+{
+    return CanDeviceDataOut{}.type();
+}
+
+std::shared_ptr<NodeData> CanMonitorModel::outData(PortIndex)
+{
+    return {};
+}
+
+void CanMonitorModel::setInData(std::shared_ptr<NodeData> nodeData, PortIndex port)
+{
+    _inQueues[port]->push(nodeData);
+}
+
+QString CanMonitorModel::nodeStatus() const
+{
+    if (!_component.isMonitoring()) {
+        return {};
+    }
+
+    return QString("t:%1 e:%2").arg(_component.timeoutCount()).arg(_component.earlyCount());
+}
+
+void CanMonitorModel::processInData(const std::shared_ptr<NodeData>& nodeData)
+{
+    if (nodeData) {
+        auto d = std::dynamic_pointer_cast<CanDeviceDataOut>(nodeData);
+        assert(nullptr != d);
+        // Only bus traffic is monitored, frames sent by the node itself are ignored
+        if (d->direction() == Direction::RX) {
+            emit frameReceived(d->frame());
+        }
+    } else {
+        cds_warn("Incorrect nodeData");
+    }
+}
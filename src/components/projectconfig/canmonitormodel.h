@@ -0,0 +1,73 @@
+#ifndef CANMONITORMODEL_H
+#define CANMONITORMODEL_H
+
+#include "componentmodel.h"
+#include <QtSerialBus/QCanBusFrame>
+#include <canmonitor.h>
+
+using QtNodes::PortType;
+using QtNodes::PortIndex;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+
+/**
+*   @brief The class provides node graphical representation of CanMonitor
+*/
+class CanMonitorModel : public ComponentModel<CanMonitor, CanMonitorModel> {
+    Q_OBJECT
+
+public:
+    CanMonitorModel();
+
+    /**
+    *   @brief  Used to get number of ports of each type used by model
+    *   @param  type of port
+    *   @return 1 if port in, 0 if any other type
+    */
+    unsigned int nPorts(PortType portType) const override;
+
+    /**
+    *   @brief  Used to get data type of each port
+    *   @param  type of port
+    *   @patam  port id
+    *   @return CanDeviceDataOut type
+    */
+    NodeDataType dataType(PortType portType, PortIndex portIndex) const override;
+
+    /**
+    *   @brief  Sets output data for propagation, not used in this class
+    *   @param  port id
+    *   @return
+    */
+    std::shared_ptr<NodeData> outData(PortIndex port) override;
+
+    /**
+    *   @brief  Passes data received on input port to the port queue
+    *   @param  data on port
+    *   @param  port id
+    */
+    void setInData(std::shared_ptr<NodeData> nodeData, PortIndex port) override;
+
+signals:
+    /**
+    *   @brief  Emits singal on CAN frame receival
+    *   @param frame Received frame
+    */
+    void frameReceived(const QCanBusFrame& frame);
+
+protected:
+    /**
+    *   @brief  Shows timeout and early frame counters
+    *   @return status text
+    */
+    QString nodeStatus() const override;
+
+private:
+    /**
+    *   @brief  Handles data taken from input queue, passes received frames to CanMonitor
+    *   @param  data on port
+    */
+    void processInData(const std::shared_ptr<NodeData>& nodeData);
+};
+
+#endif // CANMONITORMODEL_H
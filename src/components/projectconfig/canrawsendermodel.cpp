@@ -1,5 +1,4 @@
 #include "canrawsendermodel.h"
-#include <datamodeltypes/canrawsenderdata.h>
 
 CanRawSenderModel::CanRawSenderModel()
 {
@@ -7,9 +6,6 @@ CanRawSenderModel::CanRawSenderModel()
     _label->setFixedSize(75, 25);
     _label->setAttribute(Qt::WA_TranslucentBackground);
 
-    QWidget* crsWidget = _component.getMainWidget();
-    crsWidget->setWindowTitle("CANrawSender");
-
     connect(&_component, &CanRawSender::sendFrame, this, &CanRawSenderModel::sendFrame);
 
     _caption = "CanRawSender Node";
@@ -24,13 +20,17 @@ NodeDataType CanRawSenderModel::dataType(PortType, PortIndex) const
 
 std::shared_ptr<NodeData> CanRawSenderModel::outData(PortIndex)
 {
-    return std::make_shared<CanRawSenderDataOut>(_frame);
+    if (!_nodeData) {
+        _nodeData = std::make_shared<CanRawSenderDataOut>();
+    }
+
+    return _nodeData;
 }
 
 void CanRawSenderModel::sendFrame(const QCanBusFrame& frame)
 {
-    // TODO: Check if we don't need queue here. If different threads will operate on _frame we may loose data
-    _frame = frame;
+    // Immutable object is shared by all connections of the port
+    _nodeData = std::make_shared<CanRawSenderDataOut>(frame);
     emit dataUpdated(0); // Data ready on port 0
 }
 
@@ -4,6 +4,7 @@
 #include "componentmodel.h"
 #include <QtSerialBus/QCanBusFrame>
 #include <canrawsender.h>
+#include <datamodeltypes/canrawsenderdata.h>
 
 using QtNodes::PortType;
 using QtNodes::PortIndex;
@@ -58,7 +59,7 @@ public slots:
     void sendFrame(const QCanBusFrame& frame);
 
 private:
-    QCanBusFrame _frame;
+    std::shared_ptr<CanRawSenderDataOut> _nodeData;
 };
 
 #endif // CANRAWSENDERMODEL_H
@@ -12,9 +12,11 @@ CanRawViewModel::CanRawViewModel()
     _name = "CanRawViewModel";
     _modelName = "Raw view";
 
-    _component.getMainWidget()->setWindowTitle("CANrawView");
     connect(this, &CanRawViewModel::frameSent, &_component, &CanRawView::frameSent);
     connect(this, &CanRawViewModel::frameReceived, &_component, &CanRawView::frameReceived);
+
+    initInputQueues(1, [this](const std::shared_ptr<NodeData>& nodeData, PortIndex) { processInData(nodeData); });
+    exposeComponentProperties({ "maxRows", "maxMemoryMB", "spillToDisk", "refreshRate", "overloadRate" });
 }
 
 unsigned int CanRawViewModel::nPorts(PortType portType) const
@@ -32,7 +34,12 @@ std::shared_ptr<NodeData> CanRawViewModel::outData(PortIndex)
     return std::make_shared<CanRawViewDataIn>();
 }
 
-void CanRawViewModel::setInData(std::shared_ptr<NodeData> nodeData, PortIndex)
+void CanRawViewModel::setInData(std::shared_ptr<NodeData> nodeData, PortIndex port)
+{
+    _inQueues[port]->push(nodeData);
+}
+
+void CanRawViewModel::processInData(const std::shared_ptr<NodeData>& nodeData)
 {
     if (nodeData) {
         auto d = std::dynamic_pointer_cast<CanRawViewDataIn>(nodeData);
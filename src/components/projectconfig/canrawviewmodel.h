@@ -43,7 +43,7 @@ public:
     std::shared_ptr<NodeData> outData(PortIndex port) override;
 
     /**
-    *   @brief  Handles data on input port, send frames to CanRawView
+    *   @brief  Passes data received on input port to the port queue
     *   @param  data on port
     *   @param  port id
     */
@@ -64,6 +64,12 @@ signals:
     void frameSent(bool status, const QCanBusFrame& frame);
 
 private:
+    /**
+    *   @brief  Handles data taken from input queue, send frames to CanRawView
+    *   @param  data on port
+    */
+    void processInData(const std::shared_ptr<NodeData>& nodeData);
+
     QCanBusFrame _frame;
 };
 
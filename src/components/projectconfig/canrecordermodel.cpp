@@ -0,0 +1,68 @@
+#include "canrecordermodel.h"
+#include <datamodeltypes/candevicedata.h>
+#include <log.h>
+
+CanRecorderModel::CanRecorderModel()
+{
+    _label->setAlignment(Qt::AlignVCenter | Qt::AlignHCenter);
+    _label->setFixedSize(75, 25);
+    _label->setAttribute(Qt::WA_TranslucentBackground);
+
+    _caption = "CanRecorder Node";
+    _name = "CanRecorderModel";
+    _modelName = "Recorder";
+
+    connect(this, &CanRecorderModel::frameSent, &_component, &CanRecorder::frameSent);
+    connect(this, &CanRecorderModel::frameReceived, &_component, &CanRecorder::frameReceived);
+
+    initInputQueues(1, [this](const std::shared_ptr<NodeData>& nodeData, PortIndex) { processInData(nodeData); });
+    exposeComponentProperties({ "fileName", "format", "interface", "rotateSizeMB", "rotateMinutes" });
+}
+
+unsigned int CanRecorderModel::nPorts(PortType portType) const
+{
+    return (PortType::In == portType) ? 1 : 0;
+}
+
+NodeDataType CanRecorderModel::dataType(PortType, PortIndex) const
+{
+    return CanDeviceDataOut{}.type();
+}
+
+std::shared_ptr<NodeData> CanRecorderModel::outData(PortIndex)
+{
+    return {};
+}
+
+void CanRecorderModel::setInData(std::shared_ptr<NodeData> nodeData, PortIndex port)
+{
+    _inQueues[port]->push(nodeData);
+}
+
+QString CanRecorderModel::nodeStatus() const
+{
+    if (!_component.isRecording()) {
+        return {};
+    }
+
+    const QString status = QString("r:%1 x:%2").arg(_component.recordedCount()).arg(_component.droppedCount());
+
+    return _component.hasError() ? status + " write error" : status;
+}
+
+void CanRecorderModel::processInData(const std::shared_ptr<NodeData>& nodeData)
+{
+    if (nodeData) {
+        auto d = std::dynamic_pointer_cast<CanDeviceDataOut>(nodeData);
+        assert(nullptr != d);
+        if (d->direction() == Direction::TX) {
+            emit frameSent(d->status(), d->frame());
+        } else if (d->direction() == Direction::RX) {
+            emit frameReceived(d->frame());
+        } else {
+            cds_warn("Incorrect direction");
+        }
+    } else {
+        cds_warn("Incorrect nodeData");
+    }
+}
@@ -1,10 +1,19 @@
 #ifndef COMPONENTMODEL_H
 #define COMPONENTMODEL_H
 
+#include "inputqueue.h"
+#include <QtCore/QDynamicPropertyChangeEvent>
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
 #include <QtWidgets/QLabel>
 #include <functional>
+#include <memory>
+#include <modelvisitor.h>
 #include <nodes/NodeDataModel>
+#include <utility>
+#include <vector>
 
 struct ComponentInterface;
 
@@ -14,10 +23,23 @@ struct ComponentModelInterface {
 };
 
 template <typename C, typename Derived>
-class ComponentModel : public QtNodes::NodeDataModel, public ComponentModelInterface {
+class ComponentModel : public QtNodes::NodeDataModel,
+                       public ComponentModelInterface,
+                       public VisitableWith<CanNodeDataModelVisitor> {
 
 public:
     ComponentModel() = default;
+
+    /**
+    *   @brief  Constructor passing context with injected dependencies to the component
+    *   @param  ctx component context
+    */
+    template <typename Ctx>
+    explicit ComponentModel(Ctx&& ctx)
+        : _component(std::forward<Ctx>(ctx))
+    {
+    }
+
     virtual ~ComponentModel() = default;
 
     /**
@@ -55,9 +77,37 @@ public:
     {
         QJsonObject json = _component.getConfig();
         json["name"] = name();
+
+        if (!_inQueues.empty() && (_inQueues.front()->delivery() == InputQueue::Delivery::Budgeted)) {
+            json["queue"] = QJsonObject{ { "capacity", _inQueues.front()->capacity() },
+                { "policy", InputQueue::policyToString(_inQueues.front()->policy()) },
+                { "sampleN", _inQueues.front()->sampleN() } };
+        }
+
         return json;
     }
 
+    /**
+     * @brief Restores node properties
+     * @param json object created by save()
+     */
+    virtual void restore(const QJsonObject& json) override
+    {
+        QJsonObject config = json;
+        _component.setConfig(config);
+        syncComponentProperties();
+
+        const QJsonObject queue = json["queue"].toObject();
+        if (!queue.isEmpty() && !_inQueues.empty()
+            && (_inQueues.front()->delivery() == InputQueue::Delivery::Budgeted)) {
+            const auto& current = *_inQueues.front();
+
+            setProperty(kQueueCapacity, queue["capacity"].toInt(current.capacity()));
+            setProperty(kQueuePolicy, queue["policy"].toString(InputQueue::policyToString(current.policy())));
+            setProperty(kQueueSampleN, queue["sampleN"].toInt(current.sampleN()));
+        }
+    }
+
     /**
     *   @brief  Used to get model name
     *   @return Model name
@@ -94,7 +144,194 @@ public:
         return _component;
     }
 
+    /**
+    *   @brief Applies visitor to the model
+    *   @param visitor visitor to be applied
+    */
+    virtual void visit(CanNodeDataModelVisitor& visitor) override
+    {
+        visitor(static_cast<Derived&>(*this));
+    }
+
 protected:
+    typedef std::function<void(const std::shared_ptr<QtNodes::NodeData>&, QtNodes::PortIndex)> deliver_t;
+
+    /**
+    *   @brief  Creates queue for each input port. Settings of bounded queues are exposed as properties. Data received
+    *           in setInData shall be pushed to the queue of given port.
+    *   @param  count number of input ports
+    *   @param  deliver function processing data taken from the queue
+    *   @param  delivery delivery mode of the queues
+    */
+    void initInputQueues(unsigned int count, const deliver_t& deliver,
+        InputQueue::Delivery delivery = InputQueue::Delivery::Budgeted)
+    {
+        for (unsigned int i = 0; i < count; ++i) {
+            _inQueues.push_back(std::make_unique<InputQueue>(
+                [this, deliver, i](const std::shared_ptr<QtNodes::NodeData>& data) {
+                    deliver(data, i);
+                    scheduleStatsUpdate();
+                },
+                delivery));
+        }
+
+        if (delivery == InputQueue::Delivery::Budgeted) {
+            setProperty(kQueueCapacity, _inQueues.front()->capacity());
+            setProperty(kQueuePolicy, InputQueue::policyToString(_inQueues.front()->policy()));
+            setProperty(kQueueSampleN, _inQueues.front()->sampleN());
+            addExposedProperties({ kQueueCapacity, kQueuePolicy, kQueueSampleN });
+        }
+
+        // Timer runs only while node is active, idle nodes cost nothing
+        _queueStatsTimer.setInterval(500);
+        QObject::connect(&_queueStatsTimer, &QTimer::timeout, [this] { updateQueueStats(); });
+    }
+
+    /**
+    *   @brief  Starts periodic refresh of queue statistics and node status. Refresh stops by itself once node is idle.
+    *           Shall be called when node status changes without any input data.
+    */
+    void scheduleStatsUpdate()
+    {
+        _statsActivity = true;
+
+        if (!_queueStatsTimer.isActive()) {
+            _queueStatsTimer.start();
+        }
+    }
+
+    /**
+    *   @brief  Exposes component configuration entries as properties. Changing the property updates component config.
+    *   @param  names configuration keys
+    */
+    void exposeComponentProperties(const QStringList& names)
+    {
+        _componentProperties += names;
+        syncComponentProperties();
+        addExposedProperties(names);
+    }
+
+    /**
+    *   @brief  Updates exposed component properties with values from component config
+    */
+    void syncComponentProperties()
+    {
+        const QJsonObject config = _component.getConfig();
+
+        _syncingProperties = true;
+
+        for (const auto& name : _componentProperties) {
+            setProperty(name.toLatin1().constData(), config[name].toVariant());
+        }
+
+        _syncingProperties = false;
+    }
+
+    /**
+    *   @brief  Handles changes of queue settings and component config done via dynamic properties
+    *   @param  e event
+    *   @return true if event was recognized and processed
+    */
+    virtual bool event(QEvent* e) override
+    {
+        if (e->type() == QEvent::DynamicPropertyChange) {
+            const QByteArray name = static_cast<QDynamicPropertyChangeEvent*>(e)->propertyName();
+            const QVariant value = property(name);
+
+            if (!_syncingProperties && _componentProperties.contains(QString(name))) {
+                QJsonObject json{ { QString(name), QJsonValue::fromVariant(value) } };
+                _component.setConfig(json);
+                // Component may reject or normalize the value
+                syncComponentProperties();
+            }
+
+            for (auto& queue : _inQueues) {
+                if (name == kQueueCapacity) {
+                    queue->setCapacity(value.toInt());
+                } else if (name == kQueuePolicy) {
+                    queue->setPolicy(InputQueue::policyFromString(value.toString()));
+                } else if (name == kQueueSampleN) {
+                    queue->setSampleN(value.toInt());
+                }
+            }
+        }
+
+        return QtNodes::NodeDataModel::event(e);
+    }
+
+    /**
+    *   @brief  Gets component status shown on the node. Status is refreshed together with queue statistics.
+    *   @return status text, empty if there is nothing to show
+    */
+    virtual QString nodeStatus() const
+    {
+        return {};
+    }
+
+    /**
+    *   @brief  Shows node status and depth, high water mark and drop count of input queues on the node
+    */
+    void updateQueueStats()
+    {
+        const QString status = nodeStatus();
+        QStringList tooltip;
+        int depth = 0;
+        quint64 dropped = 0;
+
+        for (std::size_t i = 0; i < _inQueues.size(); ++i) {
+            const auto& queue = _inQueues[i];
+
+            depth += queue->depth();
+            dropped += queue->dropped();
+            tooltip << QString("In %1: depth %2/%3, high water mark %4, dropped %5 (%6)")
+                           .arg(i)
+                           .arg(queue->depth())
+                           .arg(queue->capacity())
+                           .arg(queue->highWaterMark())
+                           .arg(queue->dropped())
+                           .arg(InputQueue::policyToString(queue->policy()));
+        }
+
+        QStringList text;
+
+        if (!status.isEmpty()) {
+            text << status;
+            tooltip.prepend(status);
+        }
+
+        if ((depth > 0) || (dropped > 0)) {
+            text << QString("q:%1 d:%2").arg(depth).arg(dropped);
+        }
+
+        _label->setText(text.join(" "));
+        _label->setToolTip(tooltip.join("\n"));
+
+        // One more refresh after last activity, so final state is shown
+        if (!_statsActivity && (depth == 0)) {
+            _queueStatsTimer.stop();
+        }
+
+        _statsActivity = false;
+    }
+
+    /**
+    *   @brief  Appends properties to the list shown in property editor
+    *   @param  names property names
+    */
+    void addExposedProperties(const QStringList& names)
+    {
+        setProperty("exposedProperties", property("exposedProperties").toStringList() + names);
+    }
+
+    static constexpr const char* kQueueCapacity = "queueCapacity";
+    static constexpr const char* kQueuePolicy = "queuePolicy";
+    static constexpr const char* kQueueSampleN = "queueSampleN";
+
+    std::vector<std::unique_ptr<InputQueue>> _inQueues;
+    QTimer _queueStatsTimer;
+    bool _statsActivity{ false };
+    QStringList _componentProperties;
+    bool _syncingProperties{ false };
     C _component;
     QLabel* _label{ new QLabel };
     QString _caption;
@@ -0,0 +1,196 @@
+#include "inputqueue.h"
+#include <algorithm>
+
+namespace {
+// Maximum processing time consumer may accumulate while idle
+const qint64 kMaxBudgetNs = 20 * 1000 * 1000;
+// Delay before next attempt to drain the queue when budget is exhausted
+const int kRetryIntervalMs = 5;
+}
+
+InputQueue::InputQueue(const deliver_t& deliver, Delivery delivery)
+    : _deliver(deliver)
+    , _delivery(delivery)
+    , _budgetNs(kMaxBudgetNs)
+{
+    _drainTimer.setSingleShot(true);
+    QObject::connect(&_drainTimer, &QTimer::timeout, [this] { drain(); });
+    _clock.start();
+}
+
+void InputQueue::push(const std::shared_ptr<QtNodes::NodeData>& data)
+{
+    if (_delivery == Delivery::Immediate) {
+        _deliver(data);
+        return;
+    }
+
+    if (_queue.empty() && !_delivering) {
+        refillBudget();
+
+        if (_budgetNs > 0) {
+            deliverOne(data);
+            return;
+        }
+    }
+
+    enqueue(data);
+
+    if (!_drainTimer.isActive()) {
+        _drainTimer.start(kRetryIntervalMs);
+    }
+}
+
+void InputQueue::clear()
+{
+    _queue.clear();
+    _drainTimer.stop();
+    _highWaterMark = 0;
+    _dropped = 0;
+    _sampleCounter = 0;
+}
+
+InputQueue::Delivery InputQueue::delivery() const
+{
+    return _delivery;
+}
+
+void InputQueue::setCapacity(int capacity)
+{
+    _capacity = std::max(capacity, 1);
+
+    while ((_delivery == Delivery::Budgeted) && (static_cast<int>(_queue.size()) > _capacity)) {
+        _queue.pop_front();
+        ++_dropped;
+    }
+}
+
+int InputQueue::capacity() const
+{
+    return _capacity;
+}
+
+void InputQueue::setPolicy(Policy policy)
+{
+    _policy = policy;
+    _sampleCounter = 0;
+}
+
+InputQueue::Policy InputQueue::policy() const
+{
+    return _policy;
+}
+
+void InputQueue::setSampleN(int sampleN)
+{
+    _sampleN = std::max(sampleN, 1);
+    _sampleCounter = 0;
+}
+
+int InputQueue::sampleN() const
+{
+    return _sampleN;
+}
+
+int InputQueue::depth() const
+{
+    return static_cast<int>(_queue.size());
+}
+
+int InputQueue::highWaterMark() const
+{
+    return _highWaterMark;
+}
+
+quint64 InputQueue::dropped() const
+{
+    return _dropped;
+}
+
+QString InputQueue::policyToString(Policy policy)
+{
+    switch (policy) {
+    case Policy::DropNewest:
+        return "drop newest";
+    case Policy::SampleEveryN:
+        return "sample every N";
+    default:
+        return "drop oldest";
+    }
+}
+
+InputQueue::Policy InputQueue::policyFromString(const QString& policy)
+{
+    if (policy == policyToString(Policy::DropNewest)) {
+        return Policy::DropNewest;
+    } else if (policy == policyToString(Policy::SampleEveryN)) {
+        return Policy::SampleEveryN;
+    }
+
+    return Policy::DropOldest;
+}
+
+void InputQueue::enqueue(const std::shared_ptr<QtNodes::NodeData>& data)
+{
+    if ((_delivery == Delivery::Lossless) || (static_cast<int>(_queue.size()) < _capacity)) {
+        _queue.push_back(data);
+        _highWaterMark = std::max(_highWaterMark, static_cast<int>(_queue.size()));
+        return;
+    }
+
+    ++_dropped;
+
+    switch (_policy) {
+    case Policy::DropOldest:
+        _queue.pop_front();
+        _queue.push_back(data);
+        break;
+
+    case Policy::SampleEveryN:
+        if (++_sampleCounter >= _sampleN) {
+            _sampleCounter = 0;
+            _queue.pop_front();
+            _queue.push_back(data);
+        }
+        break;
+
+    case Policy::DropNewest:
+        break;
+    }
+}
+
+void InputQueue::deliverOne(const std::shared_ptr<QtNodes::NodeData>& data)
+{
+    const qint64 start = _clock.nsecsElapsed();
+
+    _delivering = true;
+    _deliver(data);
+    _delivering = false;
+
+    _budgetNs -= _clock.nsecsElapsed() - start;
+}
+
+void InputQueue::drain()
+{
+    refillBudget();
+
+    while (!_queue.empty() && (_budgetNs > 0)) {
+        // Keep data alive after removal from the queue. Consumer may push new data while processing.
+        const auto data = std::move(_queue.front());
+        _queue.pop_front();
+        deliverOne(data);
+    }
+
+    if (!_queue.empty()) {
+        _drainTimer.start(kRetryIntervalMs);
+    }
+}
+
+void InputQueue::refillBudget()
+{
+    const qint64 now = _clock.nsecsElapsed();
+
+    // Consumer is allowed to use half of the elapsed time
+    _budgetNs = std::min(kMaxBudgetNs, _budgetNs + (now - _lastRefillNs) / 2);
+    _lastRefillNs = now;
+}
@@ -0,0 +1,98 @@
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <deque>
+#include <functional>
+#include <memory>
+
+namespace QtNodes {
+class NodeData;
+}
+
+/**
+*   @brief The class provides bounded queue placed on a graph connection, in front of consumer input port.
+*
+*   Data is delivered to the consumer right away as long as the consumer stays within its processing time budget.
+*   Budget refills with wall clock time, so one consumer may use at most half of the GUI thread. Once the budget is
+*   exhausted data is queued and delivered later. When the queue is full data is dropped according to the policy.
+*   Consumers that must see all data, or see it without delay, use other delivery modes.
+*/
+class InputQueue {
+public:
+    enum class Policy { DropOldest, DropNewest, SampleEveryN };
+
+    enum class Delivery {
+        Budgeted, // within time budget, data above capacity is dropped according to the policy
+        Lossless, // within time budget, queue grows as needed and nothing is dropped
+        Immediate // at once regardless of budget, nothing is queued
+    };
+
+    typedef std::function<void(const std::shared_ptr<QtNodes::NodeData>&)> deliver_t;
+
+    /**
+    *   @brief  Constructor
+    *   @param  deliver function passing data to the consumer
+    *   @param  delivery delivery mode
+    */
+    explicit InputQueue(const deliver_t& deliver, Delivery delivery = Delivery::Budgeted);
+
+    /**
+    *   @brief  Passes data to the consumer or queues it
+    *   @param  data data received on input port
+    */
+    void push(const std::shared_ptr<QtNodes::NodeData>& data);
+
+    /**
+    *   @brief  Drops all queued data. Statistics are reset.
+    */
+    void clear();
+
+    Delivery delivery() const;
+
+    void setCapacity(int capacity);
+    int capacity() const;
+
+    void setPolicy(Policy policy);
+    Policy policy() const;
+
+    /**
+    *   @brief  Sets sampling ratio used by SampleEveryN policy. One of N items received while queue is full replaces
+    *           the oldest queued item.
+    *   @param  sampleN sampling ratio
+    */
+    void setSampleN(int sampleN);
+    int sampleN() const;
+
+    int depth() const;
+    int highWaterMark() const;
+    quint64 dropped() const;
+
+    static QString policyToString(Policy policy);
+    static Policy policyFromString(const QString& policy);
+
+private:
+    void enqueue(const std::shared_ptr<QtNodes::NodeData>& data);
+    void deliverOne(const std::shared_ptr<QtNodes::NodeData>& data);
+    void drain();
+    void refillBudget();
+
+    deliver_t _deliver;
+    Delivery _delivery;
+    std::deque<std::shared_ptr<QtNodes::NodeData>> _queue;
+    QTimer _drainTimer;
+    QElapsedTimer _clock;
+    qint64 _budgetNs;
+    qint64 _lastRefillNs{ 0 };
+    bool _delivering{ false };
+    int _capacity{ 10000 };
+    Policy _policy{ Policy::DropOldest };
+    int _sampleN{ 10 };
+    int _sampleCounter{ 0 };
+    int _highWaterMark{ 0 };
+    quint64 _dropped{ 0 };
+};
+
+#endif // INPUTQUEUE_H
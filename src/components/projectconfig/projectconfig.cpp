@@ -49,8 +49,26 @@ void ProjectConfig::load(const QByteArray& data)
     return d->load(data);
 }
 
+bool ProjectConfig::saveToFile(const QString& fileName)
+{
+    Q_D(ProjectConfig);
+    return d->saveToFile(fileName);
+}
+
+bool ProjectConfig::loadFromFile(const QString& fileName)
+{
+    Q_D(ProjectConfig);
+    return d->loadFromFile(fileName);
+}
+
 void ProjectConfig::clearGraphView()
 {
     Q_D(ProjectConfig);
     return d->clearGraphView();
 }
+
+void ProjectConfig::visitModels(const CanNodeDataModelVisitor& v)
+{
+    Q_D(ProjectConfig);
+    d->visitModels(v);
+}
@@ -8,6 +8,7 @@ class Node;
 }
 
 class ProjectConfigPrivate;
+struct CanNodeDataModelVisitor;
 
 class ProjectConfig : public QWidget {
     Q_OBJECT
@@ -19,11 +20,39 @@ public:
     void closeEvent(QCloseEvent* e);
     QByteArray save();
     void load(const QByteArray& data);
+
+    /**
+    *   @brief  Saves project to binary container. Graph and component configs are stored in one section, bulk
+    *           component data in separate sections.
+    *   @param  fileName path to project file
+    *   @return true on success, false on failure
+    */
+    bool saveToFile(const QString& fileName);
+
+    /**
+    *   @brief  Loads project file. Both binary container and legacy JSON files are supported. Only graph section
+    *           is read, bulk component data is loaded on demand.
+    *   @param  fileName path to project file
+    *   @return true on success, false on failure
+    */
+    bool loadFromFile(const QString& fileName);
     void clearGraphView();
 
+    /**
+    *   @brief  Applies visitor to data models of all nodes in the graph
+    *   @param  v visitor to be applied
+    */
+    void visitModels(const CanNodeDataModelVisitor& v);
+
 signals:
     void handleDock(QWidget* component);
     void componentWidgetCreated(QWidget* component);
+
+    /**
+    *   @brief  Emitted when user requests editing of node properties
+    *   @param  propertySource object exposing properties via "exposedProperties" property
+    */
+    void propertiesRequested(QObject* propertySource);
     void stopSimulation();
     void startSimulation();
 
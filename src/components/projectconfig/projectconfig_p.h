@@ -1,11 +1,22 @@
 #ifndef PROJECTCONFIG_P_H
 #define PROJECTCONFIG_P_H
 
+#include "canexpressionmodel.h"
+#include "canfiltermodel.h"
+#include "cangatewaymodel.h"
+#include "canmonitormodel.h"
 #include "canrawsendermodel.h"
+#include "canrecordermodel.h"
 #include "canrawviewmodel.h"
 #include "flowviewwrapper.h"
 #include "modeltoolbutton.h"
+#include "projectfile.h"
 #include "ui_projectconfig.h"
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QUuid>
+#include <QtWidgets/QMenu>
 #include <QtWidgets/QPushButton>
 #include <log.h>
 #include <modelvisitor.h> // apply_model_visitor
@@ -28,13 +39,20 @@ public:
     {
         auto& modelRegistry = _graphScene.registry();
         modelRegistry.registerModel<CanDeviceModel>();
+        modelRegistry.registerModel<CanFilterModel>();
+        modelRegistry.registerModel<CanExpressionModel>();
+        modelRegistry.registerModel<CanGatewayModel>();
+        modelRegistry.registerModel<CanMonitorModel>();
         modelRegistry.registerModel<CanRawSenderModel>();
         modelRegistry.registerModel<CanRawViewModel>();
+        modelRegistry.registerModel<CanRecorderModel>();
 
         connect(&_graphScene, &QtNodes::FlowScene::nodeCreated, this, &ProjectConfigPrivate::nodeCreatedCallback);
         connect(&_graphScene, &QtNodes::FlowScene::nodeDeleted, this, &ProjectConfigPrivate::nodeDeletedCallback);
         connect(&_graphScene, &QtNodes::FlowScene::nodeDoubleClicked, this,
             &ProjectConfigPrivate::nodeDoubleClickedCallback);
+        connect(&_graphScene, &QtNodes::FlowScene::nodeContextMenu, this,
+            &ProjectConfigPrivate::nodeContextMenuCallback);
 
         _ui->setupUi(this);
         _ui->layout->addWidget(_graphView);
@@ -54,11 +72,109 @@ public:
         return _graphScene.loadFromMemory(data);
     }
 
+    bool saveToFile(const QString& fileName)
+    {
+        ProjectFile::Sections sections;
+        const QFileInfo info(fileName);
+        // Bulk data goes to files in a directory next to the project, project only refers to them
+        const QString dataDir = info.completeBaseName() + "_data";
+        QStringList dataFiles;
+
+        sections.emplace_back(graphSectionName(), _graphScene.saveToMemory());
+
+        for (const auto& node : _graphScene.nodes()) {
+            auto iface = dynamic_cast<ComponentModelInterface*>(node.second->nodeDataModel());
+            assert(nullptr != iface);
+
+            auto& component = iface->getComponent();
+            if (!component.hasData()) {
+                continue;
+            }
+
+            const QString dataFile = dataFileName(node.first);
+            if (!info.dir().mkpath(dataDir) || !component.saveData(info.dir().filePath(dataDir + "/" + dataFile))) {
+                cds_error("Could not save data of '{}'", node.second->nodeDataModel()->caption().toStdString());
+                return false;
+            }
+
+            sections.emplace_back(dataFileSectionName(node.first), (dataDir + "/" + dataFile).toUtf8());
+            dataFiles.append(dataFile);
+        }
+
+        if (!ProjectFile::write(fileName, sections)) {
+            return false;
+        }
+
+        // Remove data of deleted nodes
+        QDir dir(info.dir().filePath(dataDir));
+        for (const auto& file : dir.entryList({ "*" + dataFileSuffix() }, QDir::Files)) {
+            if (!dataFiles.contains(file)) {
+                dir.remove(file);
+            }
+        }
+
+        return true;
+    }
+
+    bool loadFromFile(const QString& fileName)
+    {
+        if (!ProjectFile::isProjectFile(fileName)) {
+            cds_info("'{}' is not a binary project. Loading as JSON.", fileName.toStdString());
+
+            QFile file(fileName);
+            if (!file.open(QIODevice::ReadOnly)) {
+                cds_error("Could not open file '{}'", fileName.toStdString());
+                return false;
+            }
+
+            clearGraphView();
+            load(file.readAll());
+
+            return true;
+        }
+
+        auto projectFile = std::make_shared<ProjectFile>();
+        if (!projectFile->open(fileName)) {
+            return false;
+        }
+
+        clearGraphView();
+        load(projectFile->section(graphSectionName()));
+
+        // Bulk data is read only when component asks for it
+        for (const auto& node : _graphScene.nodes()) {
+            const QString fileSection = dataFileSectionName(node.first);
+            const QString name = dataSectionName(node.first);
+            auto iface = dynamic_cast<ComponentModelInterface*>(node.second->nodeDataModel());
+            assert(nullptr != iface);
+
+            if (projectFile->hasSection(fileSection)) {
+                const QString dataFile = QString::fromUtf8(projectFile->section(fileSection));
+                iface->getComponent().setDataFile(QFileInfo(fileName).dir().filePath(dataFile));
+            } else if (projectFile->hasSection(name)) {
+                // Data embedded by older versions stays in mapped file
+                iface->getComponent().setDataLoader([projectFile, name] { return projectFile->section(name); });
+            }
+        }
+
+        return true;
+    }
+
     void clearGraphView()
     {
         return _graphScene.clearScene();
     };
 
+    void visitModels(const CanNodeDataModelVisitor& v)
+    {
+        for (const auto& node : _graphScene.nodes()) {
+            auto dataModel = node.second->nodeDataModel();
+            assert(nullptr != dataModel);
+
+            apply_model_visitor(*dataModel, v);
+        }
+    }
+
     void nodeCreatedCallback(QtNodes::Node& node)
     {
         auto dataModel = node.nodeDataModel();
@@ -78,7 +194,10 @@ public:
         auto iface = dynamic_cast<ComponentModelInterface*>(dataModel);
         auto& component = iface->getComponent();
 
-        handleWidgetDeletion(component.getMainWidget());
+        // Do not construct main widget just to delete it
+        if (component.mainWidgetCreated()) {
+            handleWidgetDeletion(component.getMainWidget());
+        }
     }
 
     void nodeDoubleClickedCallback(QtNodes::Node& node)
@@ -92,7 +211,49 @@ public:
         handleWidgetShowing(component.getMainWidget(), component.mainWidgetDocked());
     }
 
+    void nodeContextMenuCallback(QtNodes::Node& node, const QPointF& pos)
+    {
+        Q_Q(ProjectConfig);
+
+        auto dataModel = node.nodeDataModel();
+        assert(nullptr != dataModel);
+
+        QMenu contextMenu;
+        QAction* properties = contextMenu.addAction("Properties...");
+        properties->setEnabled(dataModel->property("exposedProperties").isValid());
+
+        if (contextMenu.exec(_graphView->mapToGlobal(_graphView->mapFromScene(pos))) == properties) {
+            emit q->propertiesRequested(dataModel);
+        }
+    }
+
 private:
+    static QString graphSectionName()
+    {
+        return "graph";
+    }
+
+    static QString dataSectionName(const QUuid& id)
+    {
+        return "data/" + id.toString();
+    }
+
+    static QString dataFileSectionName(const QUuid& id)
+    {
+        return "datafile/" + id.toString();
+    }
+
+    static QString dataFileSuffix()
+    {
+        return ".dat";
+    }
+
+    static QString dataFileName(const QUuid& id)
+    {
+        // Strip braces
+        return id.toString().mid(1, 36) + dataFileSuffix();
+    }
+
     void handleWidgetDeletion(QWidget* widget)
     {
         if (!widget)
@@ -133,10 +294,10 @@ private:
     {
         Q_Q(ProjectConfig);
 
-        QWidget* widget = view.getMainWidget();
         connect(q, &ProjectConfig::startSimulation, std::bind(&ComponentInterface::startSimulation, &view));
         connect(q, &ProjectConfig::stopSimulation, std::bind(&ComponentInterface::stopSimulation, &view));
-        view.setDockUndockClbk([widget, q] { emit q->handleDock(widget); });
+        // Main widget is looked up on demand. Node creation must not force widget construction (e.g. headless runs).
+        view.setDockUndockClbk([&view, q] { emit q->handleDock(view.getMainWidget()); });
     }
 
     QtNodes::FlowScene _graphScene;
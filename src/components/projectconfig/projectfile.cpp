@@ -0,0 +1,159 @@
+#include "projectfile.h"
+#include <QtCore/QDataStream>
+#include <QtCore/QSaveFile>
+#include <limits>
+#include <log.h>
+
+namespace {
+const quint32 kMagic = 0x43445350; // "CDSP"
+const quint32 kVersion = 1;
+const quint64 kAlignment = 8;
+
+quint64 align(quint64 value)
+{
+    return (value + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+QByteArray serializeIndex(const ProjectFile::Sections& sections, quint64 dataOffset)
+{
+    QByteArray index;
+    QDataStream out(&index, QIODevice::WriteOnly);
+    quint64 offset = dataOffset;
+
+    out << kMagic << kVersion << static_cast<quint32>(sections.size());
+
+    for (const auto& section : sections) {
+        out << section.first << offset << static_cast<quint64>(section.second.size());
+        offset += align(section.second.size());
+    }
+
+    return index;
+}
+}
+
+ProjectFile::~ProjectFile()
+{
+    if (_map) {
+        _file.unmap(_map);
+    }
+}
+
+bool ProjectFile::isProjectFile(const QString& fileName)
+{
+    QFile file(fileName);
+    quint32 magic = 0;
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in >> magic;
+
+    return (in.status() == QDataStream::Ok) && (magic == kMagic);
+}
+
+bool ProjectFile::write(const QString& fileName, const Sections& sections)
+{
+    // Index size does not depend on offset values. Serialize it once to get the size and once with real offsets.
+    const quint64 dataOffset = align(serializeIndex(sections, 0).size());
+    const QByteArray index = serializeIndex(sections, dataOffset);
+    const QByteArray padding(static_cast<int>(kAlignment), '\0');
+    QSaveFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        cds_error("Could not open file '{}'", fileName.toStdString());
+        return false;
+    }
+
+    // Sections are aligned to simplify reading of binary structures directly from mapped memory
+    file.write(index);
+    file.write(padding.constData(), dataOffset - index.size());
+
+    for (const auto& section : sections) {
+        file.write(section.second);
+        file.write(padding.constData(), align(section.second.size()) - section.second.size());
+    }
+
+    if (!file.commit()) {
+        cds_error("Failed to write file '{}': {}", fileName.toStdString(), file.errorString().toStdString());
+        return false;
+    }
+
+    return true;
+}
+
+bool ProjectFile::open(const QString& fileName)
+{
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+
+    _file.setFileName(fileName);
+
+    if (!_file.open(QIODevice::ReadOnly)) {
+        cds_error("Could not open file '{}'", fileName.toStdString());
+        return false;
+    }
+
+    const quint64 fileSize = static_cast<quint64>(_file.size());
+    QDataStream in(&_file);
+    in >> magic >> version >> count;
+
+    if ((magic != kMagic) || (version != kVersion)) {
+        cds_error("'{}' is not a supported project file", fileName.toStdString());
+        return false;
+    }
+
+    for (quint32 i = 0; (i < count) && (in.status() == QDataStream::Ok); ++i) {
+        QString name;
+        quint64 offset = 0;
+        quint64 size = 0;
+
+        in >> name >> offset >> size;
+
+        // Checked without the sum, which could wrap around for corrupted index
+        if ((size > fileSize) || (offset > fileSize - size)) {
+            cds_error("Section '{}' exceeds file size", name.toStdString());
+            return false;
+        }
+
+        // Sections are accessed as QByteArray
+        if (size > static_cast<quint64>(std::numeric_limits<int>::max())) {
+            cds_error("Section '{}' is too large", name.toStdString());
+            return false;
+        }
+
+        _index.insert(name, qMakePair(offset, size));
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        cds_error("Failed to read section index of '{}'", fileName.toStdString());
+        return false;
+    }
+
+    _map = _file.map(0, _file.size());
+
+    if (!_map) {
+        cds_error("Failed to map file '{}'", fileName.toStdString());
+        return false;
+    }
+
+    return true;
+}
+
+bool ProjectFile::hasSection(const QString& name) const
+{
+    return _index.contains(name);
+}
+
+QByteArray ProjectFile::section(const QString& name) const
+{
+    const auto it = _index.find(name);
+
+    if ((it == _index.end()) || !_map) {
+        return {};
+    }
+
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(_map + it->first), static_cast<int>(it->second));
+}
@@ -0,0 +1,71 @@
+#ifndef PROJECTFILE_H
+#define PROJECTFILE_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <utility>
+#include <vector>
+
+/**
+*   @brief The class provides binary project container.
+*
+*   Container starts with a header and an index of named sections followed by section data. On load only the index is
+*   read. File is memory mapped, so section data is paged in only when a section is accessed.
+*/
+class ProjectFile {
+public:
+    typedef std::vector<std::pair<QString, QByteArray>> Sections;
+
+    ProjectFile() = default;
+    ~ProjectFile();
+
+    ProjectFile(const ProjectFile&) = delete;
+    ProjectFile& operator=(const ProjectFile&) = delete;
+
+    /**
+    *   @brief  Checks if file is a binary project container
+    *   @param  fileName path to file
+    *   @return true if file starts with container magic
+    */
+    static bool isProjectFile(const QString& fileName);
+
+    /**
+    *   @brief  Writes container. File is replaced atomically.
+    *   @param  fileName path to file
+    *   @param  sections named sections to be written
+    *   @return true on success, false on failure
+    */
+    static bool write(const QString& fileName, const Sections& sections);
+
+    /**
+    *   @brief  Opens container, reads section index and maps the file. Sections must fit in the file and must be
+    *           smaller than 2 GB.
+    *   @param  fileName path to file
+    *   @return true on success, false on failure
+    */
+    bool open(const QString& fileName);
+
+    /**
+    *   @brief  Checks if section is present in container
+    *   @param  name section name
+    *   @return true if section exists
+    */
+    bool hasSection(const QString& name) const;
+
+    /**
+    *   @brief  Gets section data. Data is not copied and stays valid as long as ProjectFile object exists.
+    *   @param  name section name
+    *   @return section data or empty array if section does not exist
+    */
+    QByteArray section(const QString& name) const;
+
+private:
+    QFile _file;
+    uchar* _map{ nullptr };
+    QHash<QString, QPair<quint64, quint64>> _index; // name -> (offset, size)
+};
+
+#endif // PROJECTFILE_H
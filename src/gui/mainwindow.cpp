@@ -2,6 +2,7 @@
 #include "mainwindow.h"
 #include "log.h"
 #include "modelvisitor.h" // apply_model_visitor
+#include "propertyeditordialog.h"
 #include "subwindow.h"
 #include "ui_mainwindow.h"
 
@@ -78,9 +79,8 @@ void MainWindow::handleSaveAction()
         if (!fileName.endsWith(".cds", Qt::CaseInsensitive))
             fileName += ".cds";
 
-        QFile file(fileName);
-        if (file.open(QIODevice::WriteOnly)) {
-            file.write(projectConfig->save()); // FIXME
+        if (!projectConfig->saveToFile(fileName)) {
+            QMessageBox::warning(this, "Save", "Failed to save project to " + fileName);
         }
     } else {
         cds_error("File name empty");
@@ -97,20 +97,12 @@ void MainWindow::handleLoadAction()
         return;
     }
 
-    QFile file(fileName);
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        cds_error("Could not open file");
-        return;
-    }
-
-    QByteArray wholeFile = file.readAll();
-
     // TODO check if file is correct, nodeeditor library does not provide it and will crash if incorrect file is
     // supplied
 
-    projectConfig->clearGraphView();
-    projectConfig->load(wholeFile); // FIXME
+    if (!projectConfig->loadFromFile(fileName)) {
+        QMessageBox::warning(this, "Load", "Failed to load project from " + fileName);
+    }
 }
 
 void MainWindow::connectMenuSignals()
@@ -141,6 +133,12 @@ void MainWindow::componentWidgetCreated(QWidget* component)
     wnd->setAttribute(Qt::WA_DeleteOnClose);
 }
 
+void MainWindow::showProperties(QObject* propertySource)
+{
+    PropertyEditorDialog dialog(propertySource, this);
+    dialog.exec();
+}
+
 void MainWindow::setupMdiArea()
 {
     projectConfig->setWindowTitle("Project Configuration");
@@ -149,4 +147,5 @@ void MainWindow::setupMdiArea()
     ui->mdiArea->setViewMode(QMdiArea::TabbedView);
     connect(projectConfig.get(), &ProjectConfig::componentWidgetCreated, this, &MainWindow::componentWidgetCreated);
     connect(projectConfig.get(), &ProjectConfig::handleDock, this, &MainWindow::handleDock);
+    connect(projectConfig.get(), &ProjectConfig::propertiesRequested, this, &MainWindow::showProperties);
 }
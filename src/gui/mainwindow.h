@@ -33,6 +33,7 @@ private:
 public slots:
     void handleDock(QWidget* component);
     void componentWidgetCreated(QWidget* component);
+    void showProperties(QObject* propertySource);
 };
 
 #endif // MAINWINDOW_H
@@ -20,7 +20,7 @@ int PropertyModel::columnCount(const QModelIndex&) const
 
 QVariant PropertyModel::data(const QModelIndex& index, int role) const
 {
-    if (role == Qt::DisplayRole) {
+    if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
         if (index.column() == 0) {
             return properties[index.row()];
         } else {
@@ -0,0 +1,272 @@
+#include "headlessrunner.h"
+#include <QtCore/QFileInfo>
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <iostream>
+#include <log.h>
+#include <modelvisitor.h>
+#include <projectconfig/candevicemodel.h>
+#include <projectconfig/projectconfig.h>
+
+namespace {
+// Latency histogram resolution and range. Frames slower than the range land in the last bucket.
+constexpr qint64 kLatencyBucketNs = 100;
+constexpr size_t kLatencyBuckets = 100000;
+// Max number of frames injected in one event loop iteration. Lets Qt process queued events in between.
+constexpr int kReplayBatch = 1000;
+}
+
+HeadlessRunner::HeadlessRunner()
+    : _projectConfig(std::make_unique<ProjectConfig>())
+    , _latencyHist(kLatencyBuckets, 0)
+{
+    connect(&_replayTimer, &QTimer::timeout, this, &HeadlessRunner::replayTick);
+}
+
+HeadlessRunner::~HeadlessRunner()
+{
+}
+
+bool HeadlessRunner::loadProject(const QString& fileName)
+{
+    if (!QFileInfo::exists(fileName)) {
+        cds_error("File '{}' does not exist", fileName.toStdString());
+        return false;
+    }
+
+    if (!_projectConfig->loadFromFile(fileName)) {
+        return false;
+    }
+
+    _devices.clear();
+    _projectConfig->visitModels(CanNodeDataModelVisitor{ [this](CanDeviceModel& m) { _devices.push_back(&m); } });
+
+    for (auto device : _devices) {
+        connect(device, &CanDeviceModel::dataUpdated, this, [this] { ++_framesOut; });
+    }
+
+    cds_info("Project loaded. {} CanDevice node(s) found", _devices.size());
+
+    return true;
+}
+
+bool HeadlessRunner::setReplay(const QString& fileName, bool realTime)
+{
+    _replayFile.setFileName(fileName);
+
+    if (!_replayFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        cds_error("Could not open replay file '{}'", fileName.toStdString());
+        return false;
+    }
+
+    _replayRealTime = realTime;
+    // Busy loop is not needed when original timing is kept
+    _replayTimer.setInterval(realTime ? 1 : 0);
+
+    return true;
+}
+
+void HeadlessRunner::start(int durationMs)
+{
+    _running = true;
+    _runTimer.start();
+    emit _projectConfig->startSimulation();
+
+    if (durationMs > 0) {
+        QTimer::singleShot(durationMs, this, &HeadlessRunner::stop);
+    }
+
+    if (_replayFile.isOpen()) {
+        _replayTimer.start();
+    }
+}
+
+void HeadlessRunner::stop()
+{
+    if (!_running) {
+        return;
+    }
+
+    _running = false;
+    _runTimeNs = _runTimer.nsecsElapsed();
+    _replayTimer.stop();
+    emit _projectConfig->stopSimulation();
+    emit finished();
+}
+
+void HeadlessRunner::replayTick()
+{
+    const double elapsed = _runTimer.nsecsElapsed() / 1e9;
+
+    for (int i = 0; i < kReplayBatch; ++i) {
+        if (!_hasPendingFrame) {
+            if (!readReplayFrame(_pendingFrame, _pendingTimestamp)) {
+                cds_info("End of replay file");
+                stop();
+                return;
+            }
+
+            _hasPendingFrame = true;
+        }
+
+        if (_replayRealTime) {
+            if (_replayStartTimestamp < 0) {
+                _replayStartTimestamp = _pendingTimestamp;
+            }
+
+            if (_pendingTimestamp - _replayStartTimestamp > elapsed) {
+                // Not yet the time to send this one
+                return;
+            }
+        }
+
+        injectFrame(_pendingFrame);
+        _hasPendingFrame = false;
+    }
+}
+
+bool HeadlessRunner::parseLogLine(const QByteArray& line, QCanBusFrame& frame, double& timestamp)
+{
+    // candump log format: "(1436509052.249713) can0 123#DEADBEEF", "123##1DEADBEEF" for CAN FD, "123#R" for RTR
+    const QList<QByteArray> fields = line.simplified().split(' ');
+
+    if ((fields.size() < 3) || !fields[0].startsWith('(') || !fields[0].endsWith(')')) {
+        return false;
+    }
+
+    bool ok = false;
+    timestamp = fields[0].mid(1, fields[0].size() - 2).toDouble(&ok);
+
+    const int hashPos = fields[2].indexOf('#');
+    if (!ok || (hashPos <= 0)) {
+        return false;
+    }
+
+    const QByteArray idStr = fields[2].left(hashPos);
+    const quint32 id = idStr.toUInt(&ok, 16);
+    // Extended IDs are always written with 8 digits
+    const bool extended = idStr.size() > 3;
+
+    if (!ok || (id > (extended ? 0x1fffffffu : 0x7ffu))) {
+        return false;
+    }
+
+    QByteArray data = fields[2].mid(hashPos + 1);
+    const bool fd = data.startsWith('#');
+
+    if (fd) {
+        // Skip flags nibble
+        if ((data.size() < 2) || !isxdigit(static_cast<unsigned char>(data[1]))) {
+            return false;
+        }
+
+        data = data.mid(2);
+    }
+
+    frame = QCanBusFrame();
+    frame.setFrameId(id);
+    frame.setExtendedFrameFormat(extended);
+
+    if (!fd && data.startsWith('R')) {
+        // Optional DLC follows
+        frame.setFrameType(QCanBusFrame::RemoteRequestFrame);
+        return (data.size() == 1) || ((data.size() == 2) && (data[1] >= '0') && (data[1] <= '8'));
+    }
+
+    if ((data.size() % 2 != 0) || (data.size() > 2 * (fd ? 64 : 8))
+        || !std::all_of(data.begin(), data.end(), [](char c) { return isxdigit(static_cast<unsigned char>(c)); })) {
+        return false;
+    }
+
+    frame.setPayload(QByteArray::fromHex(data));
+
+    return true;
+}
+
+quint64 HeadlessRunner::framesReplayed() const
+{
+    return _framesInjected;
+}
+
+quint64 HeadlessRunner::framesOut() const
+{
+    return _framesOut;
+}
+
+quint64 HeadlessRunner::malformedLines() const
+{
+    return _malformedLines;
+}
+
+bool HeadlessRunner::readReplayFrame(QCanBusFrame& frame, double& timestamp)
+{
+    while (!_replayFile.atEnd()) {
+        const QByteArray line = _replayFile.readLine().trimmed();
+
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        if (parseLogLine(line, frame, timestamp)) {
+            return true;
+        }
+
+        cds_warn("Malformed replay line: {}", line.toStdString());
+        ++_malformedLines;
+    }
+
+    return false;
+}
+
+void HeadlessRunner::injectFrame(const QCanBusFrame& frame)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Graph connections are direct. Time spent here covers whole synchronous processing of the frame.
+    for (auto device : _devices) {
+        device->frameReceived(frame);
+    }
+
+    const qint64 latency = timer.nsecsElapsed();
+    const size_t bucket = std::min<size_t>(latency / kLatencyBucketNs, kLatencyBuckets - 1);
+
+    ++_latencyHist[bucket];
+    _latencyMaxNs = std::max(_latencyMaxNs, latency);
+    ++_framesInjected;
+}
+
+qint64 HeadlessRunner::latencyPercentile(double percentile) const
+{
+    const quint64 threshold = static_cast<quint64>(_framesInjected * percentile);
+    quint64 count = 0;
+
+    for (size_t i = 0; i < _latencyHist.size(); ++i) {
+        count += _latencyHist[i];
+        if (count > threshold) {
+            return (i + 1) * kLatencyBucketNs;
+        }
+    }
+
+    return _latencyMaxNs;
+}
+
+void HeadlessRunner::printStats() const
+{
+    const double runTime = _runTimeNs / 1e9;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "run time [s]:       " << runTime << std::endl;
+    std::cout << "frames out:         " << _framesOut << std::endl;
+    std::cout << "throughput [fps]:   " << (runTime > 0 ? _framesOut / runTime : 0.0) << std::endl;
+
+    if (_framesInjected > 0) {
+        std::cout << "frames replayed:    " << _framesInjected << std::endl;
+        std::cout << "malformed lines:    " << _malformedLines << std::endl;
+        std::cout << "latency p50 [us]:   " << latencyPercentile(0.50) / 1000.0 << std::endl;
+        std::cout << "latency p90 [us]:   " << latencyPercentile(0.90) / 1000.0 << std::endl;
+        std::cout << "latency p99 [us]:   " << latencyPercentile(0.99) / 1000.0 << std::endl;
+        std::cout << "latency max [us]:   " << _latencyMaxNs / 1000.0 << std::endl;
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtSerialBus/QCanBusFrame>
+#include <memory>
+#include <vector>
+
+class ProjectConfig;
+class CanDeviceModel;
+
+/**
+*   @brief The class runs saved project without GUI and collects throughput/latency statistics
+*/
+class HeadlessRunner : public QObject {
+    Q_OBJECT
+
+public:
+    HeadlessRunner();
+    ~HeadlessRunner();
+
+    /**
+    *   @brief  Loads project file
+    *   @param  fileName path to project file
+    *   @return true on success, false on failure
+    */
+    bool loadProject(const QString& fileName);
+
+    /**
+    *   @brief  Sets candump log that will be replayed into every CanDevice node
+    *   @param  fileName path to candump log file
+    *   @param  realTime true to keep original frames timing, false to replay as fast as possible
+    *   @return true on success, false on failure
+    */
+    bool setReplay(const QString& fileName, bool realTime);
+
+    /**
+    *   @brief  Starts simulation. Simulation is stopped after given time or at the end of replay.
+    *   @param  durationMs simulation duration in ms, 0 to run until the end of replay
+    */
+    void start(int durationMs);
+
+    /**
+    *   @brief  Prints collected statistics to stdout
+    */
+    void printStats() const;
+
+    /**
+    *   @brief  Gets number of frames injected into CanDevice nodes
+    *   @return number of frames
+    */
+    quint64 framesReplayed() const;
+
+    /**
+    *   @brief  Gets number of frames published by CanDevice nodes
+    *   @return number of frames
+    */
+    quint64 framesOut() const;
+
+    /**
+    *   @brief  Gets number of skipped replay lines that could not be parsed
+    *   @return number of lines
+    */
+    quint64 malformedLines() const;
+
+    /**
+    *   @brief  Parses one line of candump log
+    *   @param  line log line, e.g. "(1436509052.249713) can0 123#DEADBEEF"
+    *   @param  frame parsed frame
+    *   @param  timestamp parsed timestamp in seconds
+    *   @return true on success, false if line is malformed
+    */
+    static bool parseLogLine(const QByteArray& line, QCanBusFrame& frame, double& timestamp);
+
+signals:
+    /**
+    *   @brief  Emitted when simulation has been stopped
+    */
+    void finished();
+
+private slots:
+    void replayTick();
+    void stop();
+
+private:
+    bool readReplayFrame(QCanBusFrame& frame, double& timestamp);
+    void injectFrame(const QCanBusFrame& frame);
+    qint64 latencyPercentile(double percentile) const;
+
+    std::unique_ptr<ProjectConfig> _projectConfig;
+    std::vector<CanDeviceModel*> _devices;
+    QFile _replayFile;
+    QTimer _replayTimer;
+    QElapsedTimer _runTimer;
+    bool _replayRealTime{ false };
+    bool _running{ false };
+    bool _hasPendingFrame{ false };
+    QCanBusFrame _pendingFrame;
+    double _pendingTimestamp{ 0.0 };
+    double _replayStartTimestamp{ -1.0 };
+    qint64 _runTimeNs{ 0 };
+    quint64 _framesOut{ 0 };
+    quint64 _framesInjected{ 0 };
+    quint64 _malformedLines{ 0 };
+    qint64 _latencyMaxNs{ 0 };
+    std::vector<quint64> _latencyHist;
+};
+
+#endif // HEADLESSRUNNER_H
@@ -0,0 +1,69 @@
+#include "headlessrunner.h"
+#include <QtCore/QCommandLineParser>
+#include <QtWidgets/QApplication>
+
+#include "log.h"
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+int main(int argc, char* argv[])
+{
+    // Components still use QtWidgets internally. Offscreen platform lets us run without display.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication a(argc, argv);
+    QCoreApplication::setApplicationName("cds-headless");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs CANdevStudio project without GUI and prints performance statistics");
+    parser.addHelpOption();
+    parser.addPositionalArgument("project", "Project file (*.cds)");
+
+    QCommandLineOption durationOpt(QStringList() << "d" << "duration", "Simulation duration in ms.", "ms", "0");
+    QCommandLineOption replayOpt(
+        QStringList() << "r" << "replay", "candump log file replayed into all CanDevice nodes.", "file");
+    QCommandLineOption realTimeOpt("realtime", "Keep original timing of replayed frames.");
+    QCommandLineOption verboseOpt(QStringList() << "v" << "verbose", "Enable debug logs.");
+    parser.addOption(durationOpt);
+    parser.addOption(replayOpt);
+    parser.addOption(realTimeOpt);
+    parser.addOption(verboseOpt);
+    parser.process(a);
+
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (parser.isSet(verboseOpt) || CDS_DEBUG) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+
+    const QStringList args = parser.positionalArguments();
+    const int duration = parser.value(durationOpt).toInt();
+
+    if (args.size() != 1) {
+        parser.showHelp(1);
+    }
+
+    if ((duration <= 0) && !parser.isSet(replayOpt)) {
+        cds_error("Either duration or replay file has to be provided");
+        return 1;
+    }
+
+    HeadlessRunner runner;
+
+    if (!runner.loadProject(args.first())) {
+        return 1;
+    }
+
+    if (parser.isSet(replayOpt) && !runner.setReplay(parser.value(replayOpt), parser.isSet(realTimeOpt))) {
+        return 1;
+    }
+
+    QObject::connect(&runner, &HeadlessRunner::finished, &a, &QCoreApplication::quit, Qt::QueuedConnection);
+    runner.start(duration);
+
+    const int ret = a.exec();
+    runner.printStats();
+
+    return ret;
+}
@@ -3,6 +3,7 @@
 #define CATCH_CONFIG_RUNNER
 #include "log.h"
 #include <QSignalSpy>
+#include <QtTest/QTest>
 #include <datamodeltypes/candevicedata.h>
 #include <fakeit.hpp>
 
@@ -63,6 +64,24 @@ TEST_CASE("Calling frameSent emits dataUpdated and outData returns that frame",
         == testFrame.frameId());
 }
 
+TEST_CASE("outData returns the same instance to all connections", "[candevice]")
+{
+    CanDeviceModel canDeviceModel;
+    QCanBusFrame testFrame;
+    testFrame.setFrameId(123);
+    canDeviceModel.frameReceived(testFrame);
+
+    auto first = canDeviceModel.outData(0);
+    auto second = canDeviceModel.outData(0);
+
+    CHECK(first == second);
+
+    canDeviceModel.frameReceived(testFrame);
+
+    CHECK(canDeviceModel.outData(0) != first);
+    CHECK(std::dynamic_pointer_cast<CanDeviceDataOut>(first)->frame().frameId() == testFrame.frameId());
+}
+
 TEST_CASE("Calling setInData will result in sendFrame being emitted", "[candevice]")
 {
     CanDeviceModel canDeviceModel;
@@ -76,6 +95,28 @@ TEST_CASE("Calling setInData will result in sendFrame being emitted", "[candevic
     CHECK(qvariant_cast<QCanBusFrame>(sendFrameSpy.takeFirst().at(0)).frameId() == testFrame.frameId());
 }
 
+TEST_CASE("Frames to be sent are never dropped", "[candevice]")
+{
+    CanDeviceModel canDeviceModel;
+    QCanBusFrame testFrame;
+    testFrame.setFrameId(123);
+    auto canDeviceDataIn = std::make_shared<CanDeviceDataIn>(testFrame);
+    QSignalSpy sendFrameSpy(&canDeviceModel, &CanDeviceModel::sendFrame);
+    const int count = 50000; // above default queue capacity
+
+    for (int i = 0; i < count; ++i) {
+        canDeviceModel.setInData(canDeviceDataIn, 0);
+    }
+
+    for (int i = 0; (i < 100) && (sendFrameSpy.count() < count); ++i) {
+        QTest::qWait(50);
+    }
+
+    CHECK(sendFrameSpy.count() == count);
+    CHECK(!canDeviceModel.property("exposedProperties").toStringList().contains("queuePolicy"));
+    CHECK(canDeviceModel.save().find("queue") == canDeviceModel.save().end());
+}
+
 TEST_CASE("Test save configuration", "[candevice]")
 {
     CanDeviceModel canDeviceModel;
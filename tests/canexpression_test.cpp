@@ -0,0 +1,143 @@
+#include <QtCore/QCoreApplication>
+#include <QtSerialBus/QCanBusFrame>
+#include <canexpression.h>
+#include <expression.h>
+#define CATCH_CONFIG_RUNNER
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+namespace {
+bool eval(const QString& source, const QCanBusFrame& frame, bool tx = false)
+{
+    Expression expression;
+    QString error;
+
+    REQUIRE(expression.compile(source, &error));
+    CHECK(error.isEmpty());
+
+    return expression.evaluate(frame, tx);
+}
+
+const QCanBusFrame kFrame(0x123, QByteArray::fromHex("0102f3ff"));
+}
+
+TEST_CASE("Frame fields", "[expression]")
+{
+    CHECK(eval("id == 0x123", kFrame));
+    CHECK(eval("id == 291", kFrame));
+    CHECK(eval("len == 4 and dlc == 4", kFrame));
+    CHECK(eval("b0 == 1 && byte1 == 2 && b3 == 255", kFrame));
+    CHECK(eval("b10 == 0", kFrame));
+    CHECK(eval("ext", kFrame) == false);
+    CHECK(eval("ext", QCanBusFrame(0x1234567, QByteArray())));
+    CHECK(eval("tx", kFrame, true));
+    CHECK(eval("rx", kFrame, true) == false);
+    CHECK(eval("rtr", kFrame) == false);
+}
+
+TEST_CASE("Operator priorities", "[expression]")
+{
+    CHECK(eval("id == 0x123 and b2 & 0x0f == 3", kFrame));
+    CHECK(eval("b2 >> 4 == 0xf", kFrame));
+    CHECK(eval("1 + 2 * 3 == 7", kFrame));
+    CHECK(eval("(1 + 2) * 3 == 9", kFrame));
+    CHECK(eval("1 | 2 ^ 3 & 1 == 3", kFrame));
+    CHECK(eval("not id == 0x124", kFrame));
+    CHECK(eval("!(b0 == 1) || b1 == 2", kFrame));
+    CHECK(eval("-b0 == ~0", kFrame));
+    CHECK(eval("10 % 4 == 2 and 10 / 0 == 0", kFrame));
+}
+
+TEST_CASE("Arithmetic overflow wraps around", "[expression]")
+{
+    CHECK(eval("(1 << 63) / -1 == 1 << 63", kFrame));
+    CHECK(eval("(1 << 63) % -1 == 0", kFrame));
+    CHECK(eval("-(1 << 63) == 1 << 63", kFrame));
+    CHECK(eval("(1 << 63) - 1 + 1 == 1 << 63", kFrame));
+    CHECK(eval("(1 << 62) * 4 == 0", kFrame));
+    CHECK(eval("-7 / -1 == 7 and -7 % 3 == -1", kFrame));
+}
+
+TEST_CASE("Short circuit keeps boolean result", "[expression]")
+{
+    CHECK(eval("0 or 5", kFrame));
+    CHECK(eval("0 and 5", kFrame) == false);
+    CHECK(eval("(2 and 3) == 1", kFrame));
+    CHECK(eval("(0 or 0 or 7) == 1", kFrame));
+    CHECK(eval("id == 1 or id == 2 or id == 0x123", kFrame));
+}
+
+TEST_CASE("Incorrect expressions are rejected", "[expression]")
+{
+    Expression expression;
+    QString error;
+
+    REQUIRE(expression.compile("id == 0x123"));
+    CHECK(expression.compile("id ==", &error) == false);
+    CHECK(error.isEmpty() == false);
+    CHECK(expression.compile("foo == 1") == false);
+    CHECK(expression.compile("(id == 1") == false);
+    CHECK(expression.compile("id == 1)") == false);
+    CHECK(expression.compile("b64 == 1") == false);
+    CHECK(expression.compile("id $ 1") == false);
+    CHECK(expression.compile("0xzz") == false);
+    CHECK(expression.source() == "id == 0x123");
+    CHECK(expression.evaluate(kFrame, false));
+}
+
+TEST_CASE("Deeply nested expressions are rejected", "[expression]")
+{
+    Expression expression;
+    QString error;
+
+    CHECK(expression.compile(QString(50, '(') + "id == 0x123" + QString(50, ')')));
+    CHECK(expression.evaluate(kFrame, false));
+    CHECK(expression.compile(QString(100000, '(') + "1" + QString(100000, ')'), &error) == false);
+    CHECK(error == "Expression too complex");
+    CHECK(expression.compile(QString(100000, '!') + "1", &error) == false);
+    CHECK(error == "Expression too complex");
+    CHECK(expression.compile(QString(100000, '-') + "1", &error) == false);
+    CHECK(error == "Expression too complex");
+    CHECK(expression.compile(QString(100000, '~') + "1", &error) == false);
+    CHECK(error == "Expression too complex");
+}
+
+TEST_CASE("Empty expression passes everything", "[expression]")
+{
+    Expression expression;
+
+    CHECK(expression.isEmpty());
+    CHECK(expression.evaluate(kFrame, false));
+    REQUIRE(expression.compile("  "));
+    CHECK(expression.isEmpty());
+}
+
+TEST_CASE("Component evaluates configured expression", "[canexpression]")
+{
+    CanExpression canExpression;
+    QJsonObject config{ { "expression", "id == 0x123" } };
+
+    canExpression.setConfig(config);
+    CHECK(canExpression.getConfig()["expression"].toString() == "id == 0x123");
+    CHECK(canExpression.evaluate(kFrame, false));
+    CHECK(canExpression.evaluate(QCanBusFrame(0x124, QByteArray()), false) == false);
+    CHECK(canExpression.evaluationCount() == 2);
+
+    config = QJsonObject{ { "expression", "id ==" } };
+    canExpression.setConfig(config);
+    CHECK(canExpression.getConfig()["expression"].toString() == "id == 0x123");
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QCoreApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
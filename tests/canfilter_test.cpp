@@ -0,0 +1,109 @@
+#include <QtCore/QCoreApplication>
+#include <QtSerialBus/QCanBusFrame>
+#include <canfilter.h>
+#include <idfilter.h>
+#define CATCH_CONFIG_RUNNER
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+namespace {
+QCanBusFrame makeFrame(quint32 id, bool extended = false)
+{
+    QCanBusFrame frame(id, QByteArray());
+    frame.setExtendedFrameFormat(extended);
+
+    return frame;
+}
+}
+
+TEST_CASE("Exact ID rules", "[idfilter]")
+{
+    IdFilter filter;
+
+    REQUIRE(filter.setRules("123, 0x7ff 1abcdef"));
+    CHECK(filter.matches(0x123, false));
+    CHECK(filter.matches(0x123, true));
+    CHECK(filter.matches(0x7ff, false));
+    CHECK(filter.matches(0x1abcdef, true));
+    CHECK(filter.matches(0x124, false) == false);
+    CHECK(filter.matches(0x1abcdee, true) == false);
+}
+
+TEST_CASE("ID/mask rules", "[idfilter]")
+{
+    IdFilter filter;
+
+    REQUIRE(filter.setRules("100/7f0;18fe0000/1fff0000"));
+    CHECK(filter.matches(0x100, false));
+    CHECK(filter.matches(0x10f, false));
+    CHECK(filter.matches(0x110, false) == false);
+    CHECK(filter.matches(0x18fe1234, true));
+    CHECK(filter.matches(0x18ff1234, true) == false);
+}
+
+TEST_CASE("Range rules", "[idfilter]")
+{
+    IdFilter filter;
+
+    REQUIRE(filter.setRules("200-2ff 250-300 400-410 1000000-1000fff"));
+    CHECK(filter.matches(0x1ff, false) == false);
+    CHECK(filter.matches(0x200, false));
+    CHECK(filter.matches(0x300, false));
+    CHECK(filter.matches(0x301, false) == false);
+    CHECK(filter.matches(0x405, false));
+    CHECK(filter.matches(0x1000800, true));
+    CHECK(filter.matches(0x1001000, true) == false);
+}
+
+TEST_CASE("Incorrect rules are rejected", "[idfilter]")
+{
+    IdFilter filter;
+
+    REQUIRE(filter.setRules("123"));
+    CHECK(filter.setRules("xyz") == false);
+    CHECK(filter.setRules("300-200") == false);
+    CHECK(filter.setRules("100/") == false);
+    CHECK(filter.setRules("20000000") == false);
+    CHECK(filter.rules() == "123");
+    CHECK(filter.matches(0x123, false));
+}
+
+TEST_CASE("Filter without rules passes everything", "[canfilter]")
+{
+    CanFilter canFilter;
+
+    CHECK(canFilter.accepts(makeFrame(0x123)));
+    CHECK(canFilter.accepts(makeFrame(0x1234567, true)));
+}
+
+TEST_CASE("Pass and block modes", "[canfilter]")
+{
+    CanFilter canFilter;
+    QJsonObject config{ { "rules", "100-1ff" }, { "mode", "pass" } };
+
+    canFilter.setConfig(config);
+    CHECK(canFilter.accepts(makeFrame(0x150)));
+    CHECK(canFilter.accepts(makeFrame(0x250)) == false);
+
+    config = QJsonObject{ { "mode", "block" } };
+    canFilter.setConfig(config);
+    CHECK(canFilter.accepts(makeFrame(0x150)) == false);
+    CHECK(canFilter.accepts(makeFrame(0x250)));
+
+    CHECK(canFilter.getConfig()["rules"].toString() == "100-1ff");
+    CHECK(canFilter.getConfig()["mode"].toString() == "block");
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QCoreApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,78 @@
+#include <QtWidgets/QApplication>
+#include <datamodeltypes/candevicedata.h>
+#include <projectconfig/canfiltermodel.h>
+#define CATCH_CONFIG_RUNNER
+#include <QSignalSpy>
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+TEST_CASE("Test basic functionality", "[canfilter]")
+{
+    CanFilterModel canFilterModel;
+    CHECK(canFilterModel.caption() == "CanFilter Node");
+    CHECK(canFilterModel.name() == "CanFilterModel");
+    CHECK(canFilterModel.modelName() == "Filter");
+    CHECK(canFilterModel.resizable() == false);
+    CHECK(dynamic_cast<CanFilterModel*>(canFilterModel.clone().get()) != nullptr);
+    CHECK(dynamic_cast<QLabel*>(canFilterModel.embeddedWidget()) != nullptr);
+}
+
+TEST_CASE("Port information", "[canfilter]")
+{
+    CanFilterModel canFilterModel;
+    CanDeviceDataOut canDeviceDataOut;
+    CHECK(canFilterModel.nPorts(PortType::Out) == 1);
+    CHECK(canFilterModel.nPorts(PortType::In) == 1);
+    CHECK(canFilterModel.nPorts(PortType::None) == 0);
+    CHECK(canFilterModel.dataType(PortType::In, 0).id == canDeviceDataOut.type().id);
+    CHECK(canFilterModel.dataType(PortType::Out, 0).id == canDeviceDataOut.type().id);
+}
+
+TEST_CASE("Accepted data is forwarded without copying", "[canfilter]")
+{
+    CanFilterModel canFilterModel;
+    QSignalSpy dataUpdatedSpy(&canFilterModel, &CanFilterModel::dataUpdated);
+
+    canFilterModel.setProperty("rules", "100-1ff");
+
+    auto accepted = std::make_shared<CanDeviceDataOut>(QCanBusFrame(0x150, QByteArray()), Direction::RX, false);
+    auto rejected = std::make_shared<CanDeviceDataOut>(QCanBusFrame(0x250, QByteArray()), Direction::RX, false);
+
+    canFilterModel.setInData(accepted, 0);
+    canFilterModel.setInData(rejected, 0);
+
+    CHECK(dataUpdatedSpy.count() == 1);
+    CHECK(canFilterModel.outData(0) == accepted);
+}
+
+TEST_CASE("Properties are saved and restored", "[canfilter]")
+{
+    CanFilterModel canFilterModel;
+
+    canFilterModel.setProperty("rules", "123 456");
+    canFilterModel.setProperty("mode", "block");
+
+    const QJsonObject json = canFilterModel.save();
+    CHECK(json["rules"].toString() == "123 456");
+    CHECK(json["mode"].toString() == "block");
+
+    CanFilterModel restored;
+    restored.restore(json);
+    CHECK(restored.property("rules").toString() == "123 456");
+    CHECK(restored.property("mode").toString() == "block");
+    CHECK(restored.property("exposedProperties").toStringList().contains("rules"));
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,116 @@
+#include <QtCore/QCoreApplication>
+#include <QtSerialBus/QCanBusFrame>
+#include <cangateway.h>
+#include <routingtable.h>
+#define CATCH_CONFIG_RUNNER
+#include <QSignalSpy>
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+// needed for QSignalSpy cause according to qtbug 49623 comments
+// automatic detection of types is "flawed" in moc
+Q_DECLARE_METATYPE(QCanBusFrame);
+
+TEST_CASE("Frames are routed by ID and mask", "[routingtable]")
+{
+    RoutingTable table;
+
+    REQUIRE(table.compile("0:123 > 1; 0:200/700 > 1\n1:18fe0000/1fff0000 > 0", 2));
+    CHECK(table.lookup(0, 0x123, false).size() == 1);
+    CHECK(table.lookup(0, 0x2ab, false).size() == 1);
+    CHECK(table.lookup(0, 0x124, false).empty());
+    CHECK(table.lookup(1, 0x123, false).empty());
+    CHECK(table.lookup(1, 0x18fe1234, true).size() == 1);
+    CHECK(table.lookup(1, 0x18fe1234, true).front()->outPort == 0);
+    CHECK(table.lookup(1, 0x18ff1234, true).empty());
+    CHECK(table.lookup(2, 0x123, false).empty());
+}
+
+TEST_CASE("All matching rules are applied", "[routingtable]")
+{
+    RoutingTable table;
+
+    REQUIRE(table.compile("0:* > 1; 0:123 > 0:321", 2));
+    CHECK(table.lookup(0, 0x123, false).size() == 2);
+    CHECK(table.lookup(0, 0x124, false).size() == 1);
+    CHECK(table.lookup(0, 0x1234567, true).size() == 1);
+}
+
+TEST_CASE("ID remap and payload rewrite", "[routingtable]")
+{
+    RoutingTable table;
+
+    REQUIRE(table.compile("0:123 > 1:1abcdef b0=ff b2=05/0f b7=00", 2));
+
+    const auto& route = table.lookup(0, 0x123, false);
+    REQUIRE(route.size() == 1);
+
+    const QCanBusFrame out
+        = RoutingTable::apply(*route.front(), QCanBusFrame(0x123, QByteArray::fromHex("0011f233")));
+    CHECK(out.frameId() == 0x1abcdef);
+    CHECK(out.hasExtendedFrameFormat());
+    CHECK(out.payload() == QByteArray::fromHex("ff11f533"));
+}
+
+TEST_CASE("Incorrect rules are rejected", "[routingtable]")
+{
+    RoutingTable table;
+
+    REQUIRE(table.compile("0:123 > 1", 2));
+    CHECK(table.compile("0:123 > 2", 2) == false);
+    CHECK(table.compile("0:xyz > 1", 2) == false);
+    CHECK(table.compile("0:123 > 1 b64=00", 2) == false);
+    CHECK(table.compile("0:123", 2) == false);
+    CHECK(table.rules() == "0:123 > 1");
+    CHECK(table.lookup(0, 0x123, false).size() == 1);
+}
+
+TEST_CASE("Gateway routes frames only during simulation", "[cangateway]")
+{
+    CanGateway canGateway;
+    QJsonObject config{ { "rules", "0:123 > 1:456" } };
+    QSignalSpy routedSpy(&canGateway, &CanGateway::frameRouted);
+
+    canGateway.setConfig(config);
+    CHECK(canGateway.getConfig()["rules"].toString() == "0:123 > 1:456");
+
+    canGateway.frameReceived(0, QCanBusFrame(0x123, QByteArray()));
+    CHECK(routedSpy.count() == 0);
+
+    canGateway.startSimulation();
+    canGateway.frameReceived(0, QCanBusFrame(0x123, QByteArray()));
+    canGateway.frameReceived(1, QCanBusFrame(0x123, QByteArray()));
+    REQUIRE(routedSpy.count() == 1);
+    CHECK(routedSpy.at(0).at(0).toInt() == 1);
+    CHECK(routedSpy.at(0).at(1).value<QCanBusFrame>().frameId() == 0x456);
+
+    canGateway.stopSimulation();
+    canGateway.frameReceived(0, QCanBusFrame(0x123, QByteArray()));
+    CHECK(routedSpy.count() == 1);
+}
+
+TEST_CASE("Incorrect config is ignored", "[cangateway]")
+{
+    CanGateway canGateway;
+    QJsonObject config{ { "rules", "0:123 > 1" } };
+
+    canGateway.setConfig(config);
+    config = QJsonObject{ { "rules", "garbage" } };
+    canGateway.setConfig(config);
+
+    CHECK(canGateway.getConfig()["rules"].toString() == "0:123 > 1");
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    qRegisterMetaType<QCanBusFrame>(); // required by QSignalSpy
+    QCoreApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
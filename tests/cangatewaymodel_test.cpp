@@ -0,0 +1,60 @@
+#include <QtWidgets/QApplication>
+#include <datamodeltypes/candevicedata.h>
+#include <projectconfig/cangatewaymodel.h>
+#define CATCH_CONFIG_RUNNER
+#include <QSignalSpy>
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+TEST_CASE("Test basic functionality", "[cangateway]")
+{
+    CanGatewayModel canGatewayModel;
+    CHECK(canGatewayModel.caption() == "CanGateway Node");
+    CHECK(canGatewayModel.name() == "CanGatewayModel");
+    CHECK(canGatewayModel.modelName() == "Gateway");
+    CHECK(canGatewayModel.resizable() == false);
+    CHECK(dynamic_cast<CanGatewayModel*>(canGatewayModel.clone().get()) != nullptr);
+}
+
+TEST_CASE("Port information", "[cangateway]")
+{
+    CanGatewayModel canGatewayModel;
+    CHECK(canGatewayModel.nPorts(PortType::Out) == 2);
+    CHECK(canGatewayModel.nPorts(PortType::In) == 2);
+    CHECK(canGatewayModel.nPorts(PortType::None) == 0);
+    CHECK(canGatewayModel.dataType(PortType::In, 1).id == CanDeviceDataOut{}.type().id);
+    CHECK(canGatewayModel.dataType(PortType::Out, 1).id == CanDeviceDataIn{}.type().id);
+}
+
+TEST_CASE("Received frames are routed, transmitted ones are not", "[cangateway]")
+{
+    CanGatewayModel canGatewayModel;
+    QSignalSpy dataUpdatedSpy(&canGatewayModel, &CanGatewayModel::dataUpdated);
+
+    canGatewayModel.setProperty("rules", "1:* > 0");
+    canGatewayModel.getComponent().startSimulation();
+
+    canGatewayModel.setInData(
+        std::make_shared<CanDeviceDataOut>(QCanBusFrame(0x123, QByteArray()), Direction::TX, true), 1);
+    CHECK(dataUpdatedSpy.count() == 0);
+
+    canGatewayModel.setInData(
+        std::make_shared<CanDeviceDataOut>(QCanBusFrame(0x123, QByteArray()), Direction::RX, false), 1);
+    REQUIRE(dataUpdatedSpy.count() == 1);
+    CHECK(dataUpdatedSpy.at(0).at(0).toUInt() == 0);
+    CHECK(std::dynamic_pointer_cast<CanDeviceDataIn>(canGatewayModel.outData(0))->frame().frameId() == 0x123);
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
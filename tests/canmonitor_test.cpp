@@ -0,0 +1,313 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonObject>
+#include <QtSerialBus/QCanBusFrame>
+#include <canmonitor.h>
+#include <periodmonitor.h>
+#include <vector>
+#define CATCH_CONFIG_RUNNER
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+namespace {
+struct Report {
+    quint32 key;
+    PeriodMonitor::Violation violation;
+    qint64 intervalUs;
+};
+
+void collect(PeriodMonitor& monitor, std::vector<Report>& reports)
+{
+    monitor.setCallback([&reports](const PeriodMonitor::Entry& entry, PeriodMonitor::Violation violation,
+                            qint64 intervalUs) { reports.push_back({ entry.key, violation, intervalUs }); });
+}
+}
+
+TEST_CASE("Configured ID times out once", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+    std::vector<Report> reports;
+
+    collect(monitor, reports);
+    monitor.setExpected(0x123, false, 100000);
+    monitor.start(0);
+
+    monitor.advance(119999);
+    CHECK(reports.empty());
+
+    monitor.advance(120000);
+    REQUIRE(reports.size() == 1);
+    CHECK(reports[0].key == 0x123);
+    CHECK(reports[0].violation == PeriodMonitor::Violation::Timeout);
+    CHECK(monitor.find(0x123, false)->timedOut);
+
+    monitor.advance(500000);
+    CHECK(reports.size() == 1);
+    CHECK(monitor.timeoutCount() == 1);
+
+    // ID comes back and is monitored again
+    monitor.frame(0x123, false, 500000);
+    CHECK(monitor.find(0x123, false)->timedOut == false);
+    monitor.advance(610000);
+    CHECK(reports.size() == 1);
+    monitor.advance(620000);
+    CHECK(reports.size() == 2);
+}
+
+TEST_CASE("Frames on time are not reported", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+    std::vector<Report> reports;
+
+    collect(monitor, reports);
+    monitor.setExpected(0x18fe0000, true, 10000);
+    monitor.start(0);
+
+    for (qint64 t = 0; t < 1000000; t += 10000) {
+        monitor.frame(0x18fe0000, true, t + ((t / 10000) % 2) * 1000);
+        monitor.advance(t + 5000);
+    }
+
+    CHECK(reports.empty());
+
+    const auto entry = monitor.find(0x18fe0000, true);
+    REQUIRE(entry != nullptr);
+    CHECK(entry->count == 100);
+    CHECK(entry->minUs == 9000);
+    CHECK(entry->maxUs == 11000);
+    CHECK(monitor.find(0x18fe0000, false) == nullptr);
+}
+
+TEST_CASE("Early frame is reported", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+    std::vector<Report> reports;
+
+    collect(monitor, reports);
+    monitor.setExpected(0x100, false, 100000);
+    monitor.start(0);
+
+    monitor.frame(0x100, false, 0);
+    monitor.frame(0x100, false, 100000);
+    monitor.frame(0x100, false, 181000);
+    CHECK(reports.empty());
+
+    monitor.frame(0x100, false, 231000);
+    REQUIRE(reports.size() == 1);
+    CHECK(reports[0].violation == PeriodMonitor::Violation::Early);
+    CHECK(reports[0].intervalUs == 50000);
+    CHECK(monitor.earlyCount() == 1);
+}
+
+TEST_CASE("Tolerance", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+    std::vector<Report> reports;
+
+    collect(monitor, reports);
+    monitor.setTolerance(50);
+    monitor.setExpected(0x100, false, 100000);
+    monitor.start(0);
+
+    monitor.frame(0x100, false, 0);
+    monitor.frame(0x100, false, 60000);
+    monitor.advance(200000);
+    CHECK(reports.empty());
+
+    monitor.advance(210000);
+    CHECK(reports.size() == 1);
+}
+
+TEST_CASE("Period is learned", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+    std::vector<Report> reports;
+
+    collect(monitor, reports);
+    monitor.start(0);
+
+    for (qint64 t = 0; t <= 40000; t += 10000) {
+        monitor.frame(0x200, false, t);
+    }
+
+    CHECK(monitor.find(0x200, false)->periodUs == 10000);
+    CHECK(monitor.find(0x200, false)->configured == false);
+
+    monitor.advance(59999);
+    CHECK(reports.empty());
+    monitor.advance(60000);
+    CHECK(reports.size() == 1);
+}
+
+TEST_CASE("Learning disabled", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+    std::vector<Report> reports;
+
+    collect(monitor, reports);
+    monitor.setLearning(false);
+    monitor.start(0);
+
+    for (qint64 t = 0; t <= 100000; t += 10000) {
+        monitor.frame(0x200, false, t);
+    }
+
+    monitor.advance(1000000);
+    CHECK(reports.empty());
+    CHECK(monitor.find(0x200, false)->periodUs == 0);
+    CHECK(monitor.trackedCount() == 1);
+}
+
+TEST_CASE("Period longer than timer wheel", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+    std::vector<Report> reports;
+
+    collect(monitor, reports);
+    monitor.setExpected(0x300, false, 15000000);
+    monitor.start(0);
+
+    for (qint64 t = 0; t < 17990000; t += PeriodMonitor::kTickUs) {
+        monitor.advance(t);
+    }
+
+    CHECK(reports.empty());
+    monitor.advance(18000000);
+    CHECK(reports.size() == 1);
+}
+
+TEST_CASE("Long gap between advances", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+    std::vector<Report> reports;
+
+    collect(monitor, reports);
+    for (quint32 id = 0; id < 100; ++id) {
+        monitor.setExpected(id, false, 10000 * (id + 1));
+    }
+    monitor.start(0);
+
+    monitor.advance(100000000);
+    CHECK(reports.size() == 100);
+
+    monitor.advance(200000000);
+    CHECK(reports.size() == 100);
+}
+
+TEST_CASE("Thousands of IDs", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+    std::vector<Report> reports;
+
+    collect(monitor, reports);
+    monitor.start(0);
+
+    for (int round = 0; round < 10; ++round) {
+        for (quint32 id = 0; id < 5000; ++id) {
+            monitor.frame(id, id >= 0x800, round * 100000 + id);
+        }
+
+        monitor.advance(round * 100000 + 50000);
+    }
+
+    CHECK(monitor.trackedCount() == 5000);
+    CHECK(reports.empty());
+
+    // ID 4999 is last in every round
+    monitor.advance(999999 + 120000 + PeriodMonitor::kTickUs);
+    CHECK(reports.size() == 5000);
+}
+
+TEST_CASE("Extended IDs sharing low bits", "[periodmonitor]")
+{
+    PeriodMonitor monitor;
+
+    monitor.start(0);
+
+    // IDs differ only above bit 13, standard and extended format of the same ID are distinct
+    for (quint32 i = 0; i < 500; ++i) {
+        monitor.frame(0x21 | (i << 14), true, i);
+    }
+
+    monitor.frame(0x21, false, 500);
+    CHECK(monitor.trackedCount() == 501);
+
+    for (quint32 i = 1; i < 500; ++i) {
+        const PeriodMonitor::Entry* entry = monitor.find(0x21 | (i << 14), true);
+
+        REQUIRE(entry != nullptr);
+        CHECK(entry != monitor.find(0x21 | ((i - 1) << 14), true));
+    }
+
+    REQUIRE(monitor.find(0x21, false) != nullptr);
+    CHECK(monitor.find(0x21, false) != monitor.find(0x21, true));
+    CHECK(monitor.find(0x22, true) == nullptr);
+}
+
+TEST_CASE("Table capacity", "[periodmonitor]")
+{
+    PeriodMonitor monitor(4);
+
+    monitor.start(0);
+
+    for (quint32 id = 0; id < 20; ++id) {
+        monitor.frame(id, false, 0);
+    }
+
+    CHECK(monitor.trackedCount() == 12);
+    CHECK(monitor.untrackedCount() == 8);
+
+    monitor.start(0);
+    CHECK(monitor.trackedCount() == 0);
+    CHECK(monitor.untrackedCount() == 0);
+}
+
+TEST_CASE("Monitor config", "[canmonitor]")
+{
+    CanMonitor monitor;
+    QJsonObject config{ { "periods", "123:100, 18fe0000:1000" }, { "tolerance", 10 }, { "learn", false } };
+
+    monitor.setConfig(config);
+    CHECK(monitor.getConfig()["periods"].toString() == "123:100, 18fe0000:1000");
+    CHECK(monitor.getConfig()["tolerance"].toInt() == 10);
+    CHECK(monitor.getConfig()["learn"].toBool() == false);
+
+    QJsonObject invalid{ { "periods", "123:100, zz:5" }, { "tolerance", 150 } };
+    monitor.setConfig(invalid);
+    CHECK(monitor.getConfig()["periods"].toString() == "123:100, 18fe0000:1000");
+    CHECK(monitor.getConfig()["tolerance"].toInt() == 10);
+
+    QJsonObject noPeriod{ { "periods", "123" } };
+    monitor.setConfig(noPeriod);
+    CHECK(monitor.getConfig()["periods"].toString() == "123:100, 18fe0000:1000");
+}
+
+TEST_CASE("Frames are ignored when simulation is stopped", "[canmonitor]")
+{
+    CanMonitor monitor;
+
+    CHECK(monitor.isMonitoring() == false);
+    monitor.frameReceived(QCanBusFrame(0x123, QByteArray()));
+    CHECK(monitor.trackedCount() == 0);
+
+    monitor.startSimulation();
+    CHECK(monitor.isMonitoring());
+    monitor.frameReceived(QCanBusFrame(0x123, QByteArray()));
+    CHECK(monitor.trackedCount() == 1);
+
+    monitor.stopSimulation();
+    CHECK(monitor.isMonitoring() == false);
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QCoreApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
@@ -1,4 +1,7 @@
 #include <QtWidgets/QApplication>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QTableView>
+#include <canrawsender.h>
 #include <projectconfig/canrawsendermodel.h>
 #include <datamodeltypes/canrawsenderdata.h>
 #define CATCH_CONFIG_RUNNER
@@ -52,6 +55,32 @@ TEST_CASE("Test save configuration", "[canrawsender]")
     CHECK(json.find("sorting") != json.end());
 }
 
+TEST_CASE("Widget is created on first use", "[canrawsender]")
+{
+    CanRawSender canRawSender;
+
+    CHECK(canRawSender.mainWidgetCreated() == false);
+    canRawSender.getConfig();
+    CHECK(canRawSender.mainWidgetCreated() == false);
+
+    // Setup requested so far is applied at once
+    QWidget* widget = canRawSender.getMainWidget();
+    REQUIRE(widget != nullptr);
+    CHECK(canRawSender.mainWidgetCreated());
+    CHECK(canRawSender.getMainWidget() == widget);
+
+    auto tv = widget->findChild<QTableView*>("tv");
+    REQUIRE(tv != nullptr);
+    REQUIRE(tv->model() != nullptr);
+
+    auto pbAdd = widget->findChild<QPushButton*>("pbAdd");
+    REQUIRE(pbAdd != nullptr);
+    pbAdd->click();
+    CHECK(canRawSender.getLineCount() == 1);
+    CHECK(tv->model()->rowCount() == 1);
+    CHECK(tv->indexWidget(tv->model()->index(0, 0)) != nullptr);
+}
+
 int main(int argc, char* argv[])
 {
     bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
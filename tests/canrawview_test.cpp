@@ -0,0 +1,779 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtSerialBus/QCanBusFrame>
+#include <capturefile.h>
+#include <frameexporter.h>
+#include <framemodel.h>
+#include <framesearch.h>
+#include <framestatsmodel.h>
+#include <framestatetable.h>
+#include <framestore.h>
+#include <sortindex.h>
+#include <uniqueframemodel.h>
+#define CATCH_CONFIG_RUNNER
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+TEST_CASE("Frames are stored", "[framestore]")
+{
+    FrameStore store;
+    QCanBusFrame ext(0x18fe0001, QByteArray::fromHex("0102"));
+    ext.setExtendedFrameFormat(true);
+
+    store.append(10, QCanBusFrame(0x123, QByteArray::fromHex("deadbeef")), false);
+    store.append(20, ext, true);
+    store.append(30, QCanBusFrame(0x7ff, QByteArray()), false);
+
+    REQUIRE(store.size() == 3);
+    CHECK(store.timeUs(0) == 10);
+    CHECK(store.id(0) == 0x123);
+    CHECK(store.flags(0) == 0);
+    CHECK(store.length(0) == 4);
+    CHECK(QByteArray(store.payload(0), store.length(0)) == QByteArray::fromHex("deadbeef"));
+
+    CHECK(store.id(1) == 0x18fe0001);
+    CHECK(store.flags(1) == (FrameStore::Tx | FrameStore::Extended));
+    CHECK(QByteArray(store.payload(1), store.length(1)) == QByteArray::fromHex("0102"));
+
+    CHECK(store.length(2) == 0);
+
+    store.clear();
+    CHECK(store.size() == 0);
+    CHECK(store.memoryUsage() == 0);
+}
+
+TEST_CASE("CAN FD payloads are stored", "[framestore]")
+{
+    FrameStore store;
+    QByteArray fd;
+
+    for (int i = 0; i < 64; ++i) {
+        fd.append(static_cast<char>(i));
+    }
+
+    store.append(0, 0x100, 0, fd.constData(), 64);
+    store.append(1, 0x101, 0, fd.constData(), 8);
+    store.append(2, 0x102, 0, fd.constData() + 1, 12);
+
+    CHECK(QByteArray(store.payload(0), store.length(0)) == fd);
+    CHECK(QByteArray(store.payload(1), store.length(1)) == fd.left(8));
+    CHECK(QByteArray(store.payload(2), store.length(2)) == fd.mid(1, 12));
+}
+
+TEST_CASE("Changed payload bytes are marked", "[framestore]")
+{
+    FrameStore store;
+    FrameStateTable states;
+    QByteArray fd(64, '\0');
+    const auto append = [&store, &states](qint64 timeUs, quint32 id, quint8 flags, const char* payload, int length) {
+        const std::size_t state = states.update(store.size(), timeUs, id, flags, payload, length);
+        store.append(timeUs, id, flags, payload, length, states.at(state).changed);
+    };
+
+    append(0, 0x100, 0, "\x01\x02\x03", 3);
+    append(1, 0x200, 0, "\x01\x02\x03", 3);
+    append(2, 0x100, 0, "\x01\x05\x03\x04", 4);
+    append(3, 0x100, FrameStore::Tx, "\x00", 1);
+    append(4, 0x100, 0, "\x01\x05\x03\x04", 4);
+    append(5, 0x300, 0, fd.constData(), fd.size());
+    fd[63] = 1;
+    append(6, 0x300, 0, fd.constData(), fd.size());
+    fd[7] = 1;
+    fd[8] = 1;
+    append(7, 0x300, 0, fd.constData(), fd.size());
+    append(8, 0x300, 0, fd.constData(), 12);
+
+    // First frame of ID and direction has nothing to compare with
+    CHECK(store.changed(0) == 0);
+    CHECK(store.changed(1) == 0);
+    CHECK(store.changed(2) == 0xa);
+    CHECK(store.changed(3) == 0);
+    CHECK(store.changed(4) == 0);
+    CHECK(store.changed(5) == 0);
+    CHECK(store.changed(6) == Q_UINT64_C(0x8000000000000000));
+    CHECK(store.changed(7) == 0x180);
+    CHECK(store.changed(8) == 0);
+    CHECK(QByteArray(store.payload(7), store.length(7)) == fd);
+
+    FrameModel model;
+    model.store().append(0, 0x100, 0, "\x01", 1);
+    model.store().append(1, 0x100, 0, "\x02", 1, 1);
+    model.commit();
+    CHECK(model.data(model.index(1, FrameModel::Data), FrameModel::ChangedRole).toULongLong() == 1);
+    CHECK(model.data(model.index(1, FrameModel::Dlc), FrameModel::ChangedRole).isValid() == false);
+
+    // Bytes beyond length of the previous frame count as changed
+    append(9, 0x300, 0, fd.constData(), 20);
+    CHECK(store.changed(9) == 0xff000);
+}
+
+TEST_CASE("Frames span multiple chunks", "[framestore]")
+{
+    FrameStore store;
+    const int count = FrameStore::kChunkSize * 2 + 10;
+
+    for (int i = 0; i < count; ++i) {
+        const char payload = static_cast<char>(i);
+        store.append(i, i, 0, &payload, 1);
+    }
+
+    REQUIRE(store.size() == static_cast<quint64>(count));
+
+    for (int i = 0; i < count; i += 97) {
+        CHECK(store.timeUs(i) == i);
+        CHECK(store.id(i) == static_cast<quint32>(i));
+        CHECK(*store.payload(i) == static_cast<char>(i));
+    }
+
+    // Compact storage is the point of the store
+    CHECK(store.memoryUsage() < 3 * FrameStore::kChunkSize * 23);
+}
+
+TEST_CASE("Oldest frames are removed", "[framestore]")
+{
+    FrameStore store;
+    const int count = FrameStore::kChunkSize * 3;
+
+    for (int i = 0; i < count; ++i) {
+        store.append(i, i, 0, nullptr, 0);
+    }
+
+    store.removeFirst(FrameStore::kChunkSize + 5);
+    REQUIRE(store.size() == static_cast<quint64>(count - FrameStore::kChunkSize - 5));
+    CHECK(store.firstSeq() == static_cast<quint64>(FrameStore::kChunkSize + 5));
+    CHECK(store.id(0) == static_cast<quint32>(FrameStore::kChunkSize + 5));
+    CHECK(store.id(store.size() - 1) == static_cast<quint32>(count - 1));
+
+    // Works as ring buffer, memory does not grow
+    const quint64 memory = store.memoryUsage();
+    for (int i = 0; i < count; ++i) {
+        store.removeFirst(1);
+        store.append(count + i, count + i, 0, nullptr, 0);
+    }
+    CHECK(store.memoryUsage() <= memory);
+    CHECK(store.id(0) == static_cast<quint32>(count + FrameStore::kChunkSize + 5));
+
+    store.removeFirst(store.size());
+    CHECK(store.size() == 0);
+
+    store.clear();
+    CHECK(store.firstSeq() == 0);
+}
+
+TEST_CASE("Older chunks are moved to file", "[framestore]")
+{
+    FrameStore store;
+    const int count = FrameStore::kChunkSize * (FrameStore::kMappedChunks + 8) + 10;
+
+    store.setResidentChunks(2);
+
+    for (int i = 0; i < count; ++i) {
+        QByteArray payload(i % 10 ? i % 9 : 12 + i % 50, static_cast<char>(i));
+        store.append(i, i, 0, payload.constData(), payload.size());
+    }
+
+    REQUIRE(store.size() == static_cast<quint64>(count));
+    CHECK(store.memoryUsage() < 4 * FrameStore::kChunkSize * FrameStore::kFrameSize);
+    CHECK(store.diskUsage() > static_cast<quint64>(count - 2 * FrameStore::kChunkSize) * FrameStore::kFrameSize);
+
+    // Backwards to page every chunk in and out
+    for (int i = count - 1; i >= 0; i -= 101) {
+        const QByteArray payload(i % 10 ? i % 9 : 12 + i % 50, static_cast<char>(i));
+
+        CHECK(store.timeUs(i) == i);
+        CHECK(store.id(i) == static_cast<quint32>(i));
+        CHECK(QByteArray(store.payload(i), store.length(i)) == payload);
+    }
+
+    // Frames of an ID are found in chunks moved to file as well
+    std::vector<quint64> found;
+    store.findIds(0, store.size(), 100, 102, found);
+    store.findIds(count - 3, store.size(), 0, static_cast<quint32>(count), found);
+    CHECK(found == std::vector<quint64>{ 100, 101, 102, count - 3, count - 2, count - 1 });
+
+    store.removeFirst(FrameStore::kChunkSize * 3 + 5);
+    CHECK(store.id(0) == static_cast<quint32>(FrameStore::kChunkSize * 3 + 5));
+
+    store.clear();
+    CHECK(store.diskUsage() == 0);
+}
+
+TEST_CASE("Cells are formatted on demand", "[framemodel]")
+{
+    FrameModel model;
+
+    model.append(1234567, QCanBusFrame(0x1ab, QByteArray::fromHex("0011ff")), true);
+    model.commit();
+
+    REQUIRE(model.rowCount() == 1);
+    REQUIRE(model.columnCount() == FrameModel::ColumnCount);
+    CHECK(model.data(model.index(0, FrameModel::RowId)).toInt() == 0);
+    CHECK(model.data(model.index(0, FrameModel::TimeDouble)).toDouble() == 1.234567);
+    CHECK(model.data(model.index(0, FrameModel::Time)).toString() == "1.23");
+    CHECK(model.data(model.index(0, FrameModel::IdInt)).toInt() == 0x1ab);
+    CHECK(model.data(model.index(0, FrameModel::Id)).toString() == "0x1ab");
+    CHECK(model.data(model.index(0, FrameModel::Dir)).toString() == "TX");
+    CHECK(model.data(model.index(0, FrameModel::Dlc)).toInt() == 3);
+    CHECK(model.data(model.index(0, FrameModel::Data)).toString() == "00 11 ff");
+    CHECK(model.headerData(FrameModel::IdInt, Qt::Horizontal).toString() == "idInt");
+    CHECK(model.data(model.index(0, FrameModel::Data), Qt::EditRole).isValid() == false);
+}
+
+TEST_CASE("Rows are inserted in batches on commit", "[framemodel]")
+{
+    FrameModel model;
+    int insertions = 0;
+    int inserted = 0;
+    int resets = 0;
+
+    QObject::connect(&model, &FrameModel::rowsInserted, [&](const QModelIndex&, int first, int last) {
+        ++insertions;
+        inserted += last - first + 1;
+    });
+    QObject::connect(&model, &FrameModel::modelReset, [&resets] { ++resets; });
+
+    model.append(0, QCanBusFrame(0x1, QByteArray()), false);
+    model.append(1, QCanBusFrame(0x2, QByteArray()), false);
+    CHECK(model.rowCount() == 0);
+    CHECK(model.pendingCount() == 2);
+    CHECK(model.row(0) == -1);
+
+    CHECK(model.commit());
+    CHECK(insertions == 1);
+    CHECK(inserted == 2);
+    CHECK(model.rowCount() == 2);
+    CHECK(model.row(1) == 1);
+    CHECK(model.row(2) == -1);
+    CHECK(model.pendingCount() == 0);
+    CHECK(model.commit() == false);
+
+    model.store().append(2, 0x3, 0, nullptr, 0);
+    model.reset();
+    CHECK(resets == 1);
+    CHECK(model.rowCount() == 3);
+
+    model.clear();
+    CHECK(resets == 2);
+    CHECK(model.rowCount() == 0);
+}
+
+TEST_CASE("History is limited", "[framemodel]")
+{
+    FrameModel model;
+    int removed = 0;
+
+    QObject::connect(&model, &FrameModel::rowsRemoved, [&removed](const QModelIndex&, int first, int last) {
+        CHECK(first == 0);
+        removed += last - first + 1;
+    });
+
+    model.setCapacity(160);
+
+    for (int i = 0; i < 1000; ++i) {
+        model.append(i, QCanBusFrame(i, QByteArray()), false);
+
+        if (i % 7 == 0) {
+            model.commit();
+            CHECK(model.rowCount() <= 160);
+        }
+    }
+
+    model.commit();
+    CHECK(model.rowCount() == 160);
+    CHECK(model.evictedCount() == 840);
+    CHECK(static_cast<quint64>(removed) == model.evictedCount());
+    CHECK(model.data(model.index(0, FrameModel::RowId)).toULongLong() == model.evictedCount());
+    CHECK(model.data(model.index(0, FrameModel::IdInt)).toULongLong() == model.evictedCount());
+
+    model.setCapacity(10);
+    model.commit();
+    CHECK(model.rowCount() == 10);
+
+    // Frames evicted before commit are never shown
+    removed = 0;
+    for (int i = 1000; i < 1050; ++i) {
+        model.append(i, QCanBusFrame(i, QByteArray()), false);
+    }
+    model.commit();
+    CHECK(removed == 10);
+    CHECK(model.rowCount() == 10);
+    CHECK(model.data(model.index(9, FrameModel::IdInt)).toInt() == 1049);
+
+    model.clear();
+    CHECK(model.evictedCount() == 0);
+}
+
+TEST_CASE("Sort index keeps frames ordered by key", "[sortindex]")
+{
+    SortIndex index;
+    const quint64 keys[] = { 5, 1, 5, 3, 1, 5 };
+
+    for (quint64 seq = 0; seq < 6; ++seq) {
+        index.push(index.bucket({ keys[seq], 0 }), seq);
+    }
+
+    REQUIRE(index.size() == 6);
+    const quint64 ascending[] = { 1, 4, 3, 0, 2, 5 };
+    for (quint64 row = 0; row < 6; ++row) {
+        CHECK(index.seq(row) == ascending[row]);
+        CHECK(index.row({ keys[ascending[row]], 0 }, ascending[row]) == row);
+    }
+
+    // Frames sharing a key stay in order of arrival
+    index.setDescending(true);
+    const quint64 descending[] = { 0, 2, 5, 3, 1, 4 };
+    for (quint64 row = 0; row < 6; ++row) {
+        CHECK(index.seq(row) == descending[row]);
+    }
+
+    // Rows of a new key are known before frame is added
+    auto& bucket = index.bucket({ 4, 0 });
+    CHECK(index.row(bucket, 0) == 3);
+    index.push(bucket, 6);
+    CHECK(index.seq(3) == 6);
+
+    index.popFront(index.bucket({ 5, 0 }), 2);
+    CHECK(index.size() == 5);
+    CHECK(index.seq(0) == 5);
+    CHECK(index.row({ 5, 0 }, 0) == index.size());
+
+    // Emptied buckets are removed
+    CHECK(index.keyCount() == 4);
+    index.popFront(index.bucket({ 5, 0 }), 1);
+    index.popFront(index.bucket({ 3, 0 }), 1);
+    CHECK(index.keyCount() == 2);
+    CHECK(index.size() == 3);
+    CHECK(index.seq(0) == 6);
+    CHECK(index.seq(2) == 4);
+
+    index.clear();
+    CHECK(index.size() == 0);
+}
+
+TEST_CASE("Sort order is maintained on commit", "[framemodel]")
+{
+    FrameModel model;
+    const quint32 ids[] = { 0x300, 0x100, 0x200, 0x100, 0x300, 0x200, 0x100 };
+
+    auto idAt = [&model](int row) { return model.data(model.index(row, FrameModel::IdInt)).toUInt(); };
+    auto seqAt = [&model](int row) { return model.data(model.index(row, FrameModel::RowId)).toULongLong(); };
+
+    model.setCapacity(5);
+    model.append(0, QCanBusFrame(ids[0], QByteArray()), false);
+    model.append(1, QCanBusFrame(ids[1], QByteArray()), false);
+    model.commit();
+
+    model.sort(FrameModel::IdInt, Qt::AscendingOrder);
+    CHECK(idAt(0) == 0x100);
+    CHECK(idAt(1) == 0x300);
+
+    int insertions = 0;
+    QObject::connect(&model, &FrameModel::rowsInserted, [&insertions] { ++insertions; });
+
+    for (int i = 2; i < 7; ++i) {
+        model.append(i, QCanBusFrame(ids[i], QByteArray()), false);
+    }
+    model.commit();
+
+    // One insertion per ID, two oldest frames evicted
+    CHECK(insertions == 3);
+    REQUIRE(model.rowCount() == 5);
+    const quint64 ascending[] = { 3, 6, 2, 5, 4 };
+    for (int row = 0; row < 5; ++row) {
+        CHECK(seqAt(row) == ascending[row]);
+    }
+
+    model.sort(FrameModel::IdInt, Qt::DescendingOrder);
+    const quint64 descending[] = { 4, 2, 5, 3, 6 };
+    for (int row = 0; row < 5; ++row) {
+        CHECK(seqAt(row) == descending[row]);
+    }
+
+    // Time follows order of arrival
+    model.sort(FrameModel::TimeDouble, Qt::DescendingOrder);
+    model.append(7, QCanBusFrame(0x100, QByteArray()), false);
+    model.commit();
+    CHECK(seqAt(0) == 7);
+    CHECK(seqAt(4) == 3);
+
+    model.sort(FrameModel::Dlc, Qt::AscendingOrder);
+    model.clear();
+    model.append(8, QCanBusFrame(0x1, QByteArray::fromHex("0102")), false);
+    model.append(9, QCanBusFrame(0x2, QByteArray::fromHex("01")), false);
+    model.commit();
+    CHECK(idAt(0) == 0x2);
+    CHECK(idAt(1) == 0x1);
+}
+
+TEST_CASE("Capture file is appended while it mirrors the store", "[capturefile]")
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath("capture.dat");
+    FrameStore store;
+    CaptureFile captureFile;
+    const char fdPayload[64] = { 1, 2, 3 };
+
+    for (quint32 i = 0; i < 3000; ++i) {
+        store.append(i, i, static_cast<quint8>(i % 2), reinterpret_cast<const char*>(&i), 4);
+    }
+
+    REQUIRE(captureFile.save(store, fileName));
+    const qint64 size = QFileInfo(fileName).size();
+    CHECK(size == 8 + 3000 * (14 + 4));
+
+    store.append(3000, 0x18fe0001, FrameStore::Extended, fdPayload, 64);
+    REQUIRE(captureFile.save(store, fileName));
+    CHECK(QFileInfo(fileName).size() == size + 14 + 64);
+
+    FrameStore loaded;
+    CaptureFile loadedFile;
+    REQUIRE(loadedFile.load(loaded, fileName));
+    REQUIRE(loaded.size() == store.size());
+    CHECK(loaded.timeUs(2999) == 2999);
+    CHECK(loaded.id(2999) == 2999);
+    CHECK(loaded.flags(2999) == 1);
+    CHECK(QByteArray(loaded.payload(1234), 4) == QByteArray(store.payload(1234), 4));
+    CHECK(loaded.id(3000) == 0x18fe0001);
+    CHECK(loaded.flags(3000) == FrameStore::Extended);
+    CHECK(QByteArray(loaded.payload(3000), loaded.length(3000)) == QByteArray(fdPayload, 64));
+
+    // Loaded file is appended as well
+    loaded.append(3001, 0x1, 0, nullptr, 0);
+    REQUIRE(loadedFile.save(loaded, fileName));
+    CHECK(QFileInfo(fileName).size() == size + 14 + 64 + 14);
+
+    // File modified by another writer and evicted frames both need the file to be replaced
+    store.removeFirst(1000);
+    REQUIRE(captureFile.save(store, fileName));
+    CHECK(QFileInfo(fileName).size() == 8 + 2000 * (14 + 4) + 14 + 64);
+
+    FrameStore reloaded;
+    REQUIRE(CaptureFile().load(reloaded, fileName));
+    REQUIRE(reloaded.size() == 2001);
+    CHECK(reloaded.id(0) == 1000);
+
+    // File keeps frames removed from the store since last save, so only new frames are appended
+    store.removeFirst(500);
+    store.append(3001, 0x2, 0, nullptr, 0);
+    REQUIRE(captureFile.save(store, fileName));
+    CHECK(QFileInfo(fileName).size() == 8 + 2000 * (14 + 4) + 14 + 64 + 14);
+
+    // Frames removed before they were saved leave a gap, so the file is replaced
+    store.append(3002, 0x3, 0, nullptr, 0);
+    store.append(3003, 0x4, 0, nullptr, 0);
+    store.removeFirst(store.size() - 1);
+    REQUIRE(captureFile.save(store, fileName));
+    CHECK(QFileInfo(fileName).size() == 8 + 14);
+
+    reloaded.clear();
+    REQUIRE(CaptureFile().load(reloaded, fileName));
+    REQUIRE(reloaded.size() == 1);
+    CHECK(reloaded.id(0) == 0x4);
+
+    QFile file(fileName);
+    REQUIRE(file.open(QIODevice::ReadWrite));
+    file.resize(file.size() - 1);
+    file.close();
+    CHECK(CaptureFile().load(reloaded, fileName) == false);
+    CHECK(CaptureFile().load(reloaded, dir.filePath("missing.dat")) == false);
+}
+
+TEST_CASE("Frames are exported", "[frameexporter]")
+{
+    FrameStore store;
+    FrameExporter::slice_t slice;
+    const char fdPayload[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+    const auto line = [&slice](FrameExporter::Format format, int index) {
+        QByteArray out;
+        FrameExporter::append(out, format, slice[static_cast<std::size_t>(index)]);
+        return out;
+    };
+
+    store.append(1500000, 0x123, 0, "\xde\xad\xbe\xef", 4);
+    store.append(2000001, 0x18fe0001, FrameStore::Extended | FrameStore::Tx, "\x01\x02", 2);
+    store.append(3000000, 0x7ff, FrameStore::Remote, nullptr, 0);
+    store.append(4000000, 0x100, 0, fdPayload, 12);
+
+    FrameExporter::copy(slice, store, 1, 100);
+    CHECK(slice.size() == 3);
+    FrameExporter::copy(slice, store, 0, 100);
+    REQUIRE(slice.size() == 4);
+
+    CHECK(line(FrameExporter::Format::Candump, 0) == "(0000000001.500000) can0 123#DEADBEEF\n");
+    CHECK(line(FrameExporter::Format::Candump, 1) == "(0000000002.000001) can0 18FE0001#0102\n");
+    CHECK(line(FrameExporter::Format::Candump, 2) == "(0000000003.000000) can0 7FF#R\n");
+    CHECK(line(FrameExporter::Format::Candump, 3) == "(0000000004.000000) can0 100##0000102030405060708090A0B\n");
+
+    CHECK(line(FrameExporter::Format::Asc, 0).simplified() == "1.500000 1 123 Rx d 4 DE AD BE EF");
+    CHECK(line(FrameExporter::Format::Asc, 1).simplified() == "2.000001 1 18FE0001x Tx d 2 01 02");
+    CHECK(line(FrameExporter::Format::Asc, 2).simplified() == "3.000000 1 7FF Rx r");
+    CHECK(line(FrameExporter::Format::Asc, 3).simplified()
+        == "4.000000 CANFD 1 Rx 100 1 0 9 12 00 01 02 03 04 05 06 07 08 09 0A 0B");
+
+    CHECK(line(FrameExporter::Format::Csv, 0) == "1.500000,123,RX,4,DE AD BE EF\n");
+    CHECK(line(FrameExporter::Format::Csv, 1) == "2.000001,18FE0001,TX,2,01 02\n");
+
+    CHECK(FrameExporter::formatFromFileName("capture.ASC") == FrameExporter::Format::Asc);
+    CHECK(FrameExporter::formatFromFileName("capture.csv") == FrameExporter::Format::Csv);
+    CHECK(FrameExporter::formatFromFileName("capture.log") == FrameExporter::Format::Candump);
+
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath("capture.csv");
+    FrameExporter exporter(fileName, FrameExporter::Format::Csv);
+
+    exporter.start();
+    while (!exporter.trySubmit(slice)) {
+        QThread::msleep(1);
+    }
+    CHECK(slice.empty());
+    exporter.finish();
+
+    CHECK(exporter.hasError() == false);
+    CHECK(exporter.framesWritten() == 4);
+
+    QFile file(fileName);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    REQUIRE(lines.size() == 6);
+    CHECK(lines[0] == "time,id,dir,dlc,data");
+    CHECK(lines[3] == "3.000000,7FF,RX,0,");
+    file.close();
+
+    FrameExporter cancelled(fileName, FrameExporter::Format::Candump);
+    cancelled.start();
+    cancelled.cancel();
+    CHECK(QFile::exists(fileName) == false);
+}
+
+TEST_CASE("Frames are found by query", "[framesearch]")
+{
+    FrameStore store;
+    FrameSearch search;
+    const auto find = [&](const QString& query) {
+        REQUIRE(search.setQuery(query));
+        return search.find(store);
+    };
+
+    // Frames span several chunks, every 10 ms
+    for (quint32 i = 0; i < 3 * FrameStore::kChunkSize; ++i) {
+        const char payload[] = { static_cast<char>(i), static_cast<char>(i >> 8), 0x5a };
+        store.append(i * 10000, 0x100 + i % 16, 0, payload, (i % 2) ? 3 : 2);
+        search.add(store, store.size() - 1);
+    }
+
+    CHECK(search.setQuery(""));
+    CHECK(search.isEmpty());
+    CHECK(search.find(store).size() == store.size());
+
+    CHECK(find("105") == find("id:0x105"));
+    CHECK(find("id:105").size() == 3 * FrameStore::kChunkSize / 16);
+    CHECK(find("id:105").front() == 5);
+    CHECK(find("id:105-106").size() == 3 * FrameStore::kChunkSize / 8);
+    CHECK(find("id:105-106")[1] == 6);
+    CHECK(find("time:1-1.03") == std::vector<quint64>{ 100, 101, 102, 103 });
+    CHECK(find("time:-0.01 id:101") == std::vector<quint64>{ 1 });
+    CHECK(find("data:xx0x5a").size() == FrameStore::kChunkSize / 2);
+    CHECK(find("data:0301") == std::vector<quint64>{ 0x103 });
+    CHECK(find("data:03?1 id:103") == std::vector<quint64>{ 0x103, 0x1103, 0x2103 });
+    CHECK(find("data:0301 id:104").empty());
+
+    CHECK(search.setQuery("id:1-2 data:1") == false);
+    CHECK(search.setQuery("time:1") == false);
+    CHECK(search.setQuery("id:200-100") == false);
+    CHECK(search.setQuery("foo:1") == false);
+    CHECK(search.query() == "data:0301 id:104");
+
+    store.removeFirst(FrameStore::kChunkSize + 1);
+    search.evict(store);
+    CHECK(find("id:100").front() == FrameStore::kChunkSize + 16);
+    CHECK(find("time:-1").empty());
+
+    search.clear();
+    store.clear();
+    CHECK(find("").empty());
+}
+
+TEST_CASE("State is kept per ID and direction", "[framestatetable]")
+{
+    FrameStore store;
+    FrameStateTable table;
+    const quint8 extended = FrameStore::Extended;
+
+    store.append(1, 0x123, 0, "ab", 2);
+    store.append(2, 0x123, extended, "cd", 2);
+    store.append(3, 0x123, FrameStore::Tx, nullptr, 0);
+    store.append(4, 0x123, 0, "ef", 2);
+
+    // Enough extended IDs to grow the hash table several times
+    for (quint32 id = 0; id < 1000; ++id) {
+        store.append(5 + id, 0x18fe0000 + id, extended | (id % 2), nullptr, 0);
+    }
+
+    for (quint64 i = 0; i < store.size(); ++i) {
+        CHECK(table.update(store, i) < table.size());
+    }
+
+    CHECK(table.size() == 1003);
+
+    const FrameState* state = table.find(0x123, 0);
+    REQUIRE(state != nullptr);
+    CHECK(state->count == 2);
+    CHECK(state->timeUs == 4);
+    CHECK(state->seq == 3);
+    CHECK(QByteArray(state->payload.data(), state->length) == "ef");
+
+    REQUIRE(table.find(0x123, extended) != nullptr);
+    CHECK(table.find(0x123, extended)->count == 1);
+    CHECK(table.find(0x123, FrameStore::Tx)->count == 1);
+    CHECK(table.find(0x124, 0) == nullptr);
+
+    for (quint32 id = 0; id < 1000; id += 37) {
+        REQUIRE(table.find(0x18fe0000 + id, extended | (id % 2)) != nullptr);
+        CHECK(table.find(0x18fe0000 + id, extended | (id % 2))->timeUs == 5 + id);
+        CHECK(table.find(0x18fe0000 + id, extended | ((id + 1) % 2)) == nullptr);
+    }
+
+    table.clear();
+    CHECK(table.size() == 0);
+    CHECK(table.find(0x123, 0) == nullptr);
+}
+
+TEST_CASE("Extended IDs sharing low bits are told apart", "[framestatetable]")
+{
+    FrameStateTable table;
+    const quint8 extended = FrameStore::Extended;
+
+    // J1939 IDs of one source address differ only above bit 8
+    for (quint32 pgn = 0; pgn < 500; ++pgn) {
+        const quint32 id = 0x18000021 | (pgn << 8);
+
+        table.update(2 * pgn, 2 * pgn, id, extended, nullptr, 0);
+        table.update(2 * pgn + 1, 2 * pgn + 1, id, extended | FrameStore::Tx, nullptr, 0);
+    }
+
+    CHECK(table.size() == 1000);
+
+    for (quint32 pgn = 0; pgn < 500; ++pgn) {
+        const quint32 id = 0x18000021 | (pgn << 8);
+        const FrameState* rx = table.find(id, extended);
+        const FrameState* tx = table.find(id, extended | FrameStore::Tx);
+
+        REQUIRE(rx != nullptr);
+        REQUIRE(tx != nullptr);
+        CHECK(rx->timeUs == 2 * pgn);
+        CHECK(tx->timeUs == 2 * pgn + 1);
+        CHECK(table.find(id ^ 0x21, extended) == nullptr);
+    }
+}
+
+TEST_CASE("Period statistics are kept per ID and direction", "[framestatsmodel]")
+{
+    FrameStore store;
+    FrameStateTable table;
+    FrameStatsModel model(table);
+
+    // Periods of 10, 20 and 30 ms
+    store.append(0, 0x100, 0, nullptr, 0);
+    store.append(5000, 0x200, FrameStore::Tx, nullptr, 0);
+    store.append(10000, 0x100, 0, nullptr, 0);
+    store.append(30000, 0x100, 0, nullptr, 0);
+    store.append(60000, 0x100, 0, nullptr, 0);
+
+    for (quint64 i = 0; i < store.size(); ++i) {
+        table.update(store, i);
+    }
+
+    const FrameState* state = table.find(0x100, 0);
+    REQUIRE(state != nullptr);
+    CHECK(state->minPeriodUs == 10000);
+    CHECK(state->maxPeriodUs == 30000);
+    CHECK(state->meanPeriodUs == Approx(20000));
+
+    model.refresh();
+    REQUIRE(model.rowCount() == 2);
+    CHECK(model.value(0, FrameStatsModel::Rate) == Approx(50));
+    CHECK(model.value(0, FrameStatsModel::Jitter) == Approx(8.165).epsilon(0.001));
+    CHECK(model.data(model.index(0, FrameStatsModel::Count)).toULongLong() == 4);
+    CHECK(model.data(model.index(0, FrameStatsModel::MeanPeriod)).toString() == "20.000");
+    CHECK(model.data(model.index(1, FrameStatsModel::Dir)).toString() == "TX");
+
+    // Single frame has no period
+    CHECK(model.data(model.index(1, FrameStatsModel::Rate)).isNull());
+
+    model.sort(FrameStatsModel::Count, Qt::AscendingOrder);
+    CHECK(model.data(model.index(0, FrameStatsModel::Count)).toULongLong() == 1);
+
+    table.clear();
+    model.refresh();
+    CHECK(model.rowCount() == 0);
+}
+
+TEST_CASE("Newest frame of each ID and direction is shown", "[uniqueframemodel]")
+{
+    FrameStore store;
+    UniqueFrameModel model;
+    const char payload[] = { 0x01, 0x02 };
+    int inserted = 0;
+    int changes = 0;
+
+    QObject::connect(&model, &UniqueFrameModel::rowsInserted,
+        [&inserted](const QModelIndex&, int first, int last) { inserted += last - first + 1; });
+    QObject::connect(&model, &UniqueFrameModel::dataChanged, [&changes] { ++changes; });
+
+    store.append(10, 0x200, 0, payload, 2);
+    store.append(20, 0x100, 0, payload, 1);
+    store.append(30, 0x200, FrameStore::Tx, payload, 2);
+    store.append(40, 0x200, 0, payload, 0);
+
+    for (quint64 i = 0; i < store.size(); ++i) {
+        model.update(store, i);
+    }
+
+    CHECK(model.rowCount() == 0);
+    CHECK(model.commit());
+    CHECK(inserted == 3);
+    CHECK(changes == 1);
+    REQUIRE(model.rowCount() == 3);
+    CHECK(model.data(model.index(0, FrameModel::RowId)).toULongLong() == 3);
+    CHECK(model.data(model.index(0, FrameModel::Dlc)).toInt() == 0);
+    CHECK(model.data(model.index(2, FrameModel::Dir)).toString() == "TX");
+    CHECK(model.commit() == false);
+
+    model.sort(FrameModel::IdInt, Qt::AscendingOrder);
+    CHECK(model.data(model.index(0, FrameModel::IdInt)).toUInt() == 0x100);
+
+    model.sort(FrameModel::TimeDouble, Qt::DescendingOrder);
+    store.append(50, 0x100, 0, payload, 2);
+    model.update(store, 4);
+    model.commit();
+    CHECK(model.rowCount() == 3);
+    CHECK(model.data(model.index(0, FrameModel::IdInt)).toUInt() == 0x100);
+    CHECK(model.data(model.index(0, FrameModel::Data)).toString() == "01 02");
+    CHECK(model.data(model.index(0, FrameModel::Data), FrameModel::ChangedRole).toULongLong() == 0x2);
+
+    // Frames left out of the store are shown as well, without row ID
+    model.update(FrameState::kNotStored, 60, 0x100, 0, payload, 1);
+    model.commit();
+    CHECK(model.rowCount() == 3);
+    CHECK(model.data(model.index(0, FrameModel::RowId)).isNull());
+    CHECK(model.data(model.index(0, FrameModel::Data)).toString() == "01");
+    CHECK(model.states().find(0x100, 0)->count == 3);
+
+    model.clear();
+    CHECK(model.rowCount() == 0);
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QCoreApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
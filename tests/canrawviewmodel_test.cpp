@@ -1,8 +1,20 @@
+#include <QtCore/QAbstractItemModel>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
 #include <QtWidgets/QApplication>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QTableView>
+#include <canrawview.h>
+#include <framemodel.h>
+#include <framestatsmodel.h>
+#include <gui/crvguiinterface.h>
+#include <hexformat.h>
 #include <projectconfig/canrawviewmodel.h>
 #include <datamodeltypes/canrawviewdata.h>
 #define CATCH_CONFIG_RUNNER
 #include <QSignalSpy>
+#include <QtTest/QTest>
 #include <fakeit.hpp>
 #include <log.h>
 
@@ -67,8 +79,266 @@ TEST_CASE("Test save configuration", "[canrawview]")
     CHECK(json.find("name") != json.end());
     CHECK(json.find("columns") != json.end());
     CHECK(json.find("scrolling") != json.end());
-    CHECK(json.find("models") != json.end());
+    CHECK(json.find("models") == json.end()); // captured frames are not part of configuration
     CHECK(json.find("sorting") != json.end());
+    CHECK(json.find("maxRows") != json.end());
+    CHECK(json.find("maxMemoryMB") != json.end());
+    CHECK(json.find("spillToDisk") != json.end());
+    CHECK(json.find("refreshRate") != json.end());
+    CHECK(json.find("overloadRate") != json.end());
+}
+
+TEST_CASE("Sorting and scrolling are restored", "[canrawview]")
+{
+    CanRawViewModel canRawViewModel;
+    QJsonObject json = canRawViewModel.save();
+    json["scrolling"] = true;
+    json["sorting"]
+        = QJsonObject{ { "prevIndex", 6 }, { "sortIndex", 6 }, { "currentSortOrder", Qt::DescendingOrder } };
+    canRawViewModel.restore(json);
+
+    QJsonObject saved = canRawViewModel.save();
+    CHECK(saved["scrolling"].toBool() == true);
+    CHECK(saved["sorting"].toObject()["prevIndex"].toInt() == 6);
+    CHECK(saved["sorting"].toObject()["sortIndex"].toInt() == 6);
+    CHECK(saved["sorting"].toObject()["currentSortOrder"].toInt() == Qt::DescendingOrder);
+
+    // Sorting by payload is not available while frames are moved to disk
+    json["spillToDisk"] = true;
+    canRawViewModel.restore(json);
+
+    saved = canRawViewModel.save();
+    CHECK(saved["sorting"].toObject()["sortIndex"].toInt() == 0);
+    CHECK(saved["sorting"].toObject()["currentSortOrder"].toInt() == Qt::AscendingOrder);
+
+    json["sorting"] = QJsonObject{ { "prevIndex", 42 }, { "sortIndex", 6 }, { "currentSortOrder", 0 } };
+    json["spillToDisk"] = false;
+    canRawViewModel.restore(json);
+    CHECK(canRawViewModel.save()["sorting"].toObject()["prevIndex"].toInt() == 0);
+}
+
+TEST_CASE("History limit is exposed as property", "[canrawview]")
+{
+    CanRawViewModel canRawViewModel;
+
+    CHECK(canRawViewModel.property("exposedProperties").toStringList().contains("maxRows"));
+    canRawViewModel.setProperty("maxRows", 1000);
+    CHECK(canRawViewModel.save()["maxRows"].toInt() == 1000);
+
+    canRawViewModel.setProperty("maxRows", -5);
+    CHECK(canRawViewModel.save()["maxRows"].toInt() == 0);
+}
+
+TEST_CASE("Overload rate is exposed as property", "[canrawview]")
+{
+    CanRawViewModel canRawViewModel;
+
+    CHECK(canRawViewModel.property("exposedProperties").toStringList().contains("overloadRate"));
+    CHECK(canRawViewModel.save()["overloadRate"].toInt() == 0);
+    canRawViewModel.setProperty("overloadRate", 2000);
+    CHECK(canRawViewModel.save()["overloadRate"].toInt() == 2000);
+}
+
+TEST_CASE("Widget is created on first use", "[canrawview]")
+{
+    CanRawView canRawView;
+
+    CHECK(canRawView.mainWidgetCreated() == false);
+    canRawView.getConfig();
+    CHECK(canRawView.mainWidgetCreated() == false);
+
+    canRawView.startSimulation();
+    canRawView.frameReceived(QCanBusFrame(0x123, QByteArray::fromHex("01")));
+    CHECK(canRawView.mainWidgetCreated() == false);
+
+    // Setup requested so far is applied at once
+    QWidget* widget = canRawView.getMainWidget();
+    REQUIRE(widget != nullptr);
+    CHECK(canRawView.mainWidgetCreated());
+    CHECK(canRawView.getMainWidget() == widget);
+
+    auto tv = widget->findChild<QTableView*>("tv");
+    REQUIRE(tv != nullptr);
+    REQUIRE(tv->model() != nullptr);
+    CHECK(tv->isColumnHidden(0));
+
+    // Frames received while widget did not exist are shown
+    widget->show();
+    CHECK(tv->model()->rowCount() == 1);
+
+    auto pbClear = widget->findChild<QPushButton*>("pbClear");
+    REQUIRE(pbClear != nullptr);
+    pbClear->click();
+    CHECK(tv->model()->rowCount() == 0);
+
+    delete widget;
+}
+
+TEST_CASE("Frames above overload rate are elided", "[canrawview]")
+{
+    using namespace fakeit;
+    Mock<CRVGuiInterface> crvMock;
+    QAbstractItemModel* tvModel = nullptr;
+    QAbstractItemModel* statsModel = nullptr;
+    QAbstractItemModel* uniqueModel = nullptr;
+    CRVGuiInterface::filter_t filterCbk;
+    CRVGuiInterface::statistics_t statisticsCbk;
+    quint64 elided = 0;
+
+    Fake(Dtor(crvMock));
+    When(Method(crvMock, initTableView)).Do([&](QAbstractItemModel& model) { tvModel = &model; });
+    When(Method(crvMock, initStatsView)).Do([&](QAbstractItemModel& model) { statsModel = &model; });
+    When(Method(crvMock, setModel)).AlwaysDo([&](QAbstractItemModel* model) { uniqueModel = model; });
+    When(Method(crvMock, setFilterCbk)).Do([&](auto&& fn) { filterCbk = fn; });
+    When(Method(crvMock, setStatisticsCbk)).Do([&](auto&& fn) { statisticsCbk = fn; });
+    When(Method(crvMock, setElidedCount)).AlwaysDo([&](quint64 count) { elided = count; });
+    When(Method(crvMock, isVisible)).AlwaysReturn(true);
+    When(Method(crvMock, isViewFrozen)).AlwaysReturn(false);
+    When(Method(crvMock, getSortOrder)).AlwaysReturn(Qt::AscendingOrder);
+    When(Method(crvMock, getSortSection)).AlwaysReturn(0);
+    Fake(Method(crvMock, setClearCbk));
+    Fake(Method(crvMock, setDockUndockCbk));
+    Fake(Method(crvMock, setSectionClikedCbk));
+    Fake(Method(crvMock, setShowCbk));
+    Fake(Method(crvMock, setSearchCbk));
+    Fake(Method(crvMock, setExportCbk));
+    Fake(Method(crvMock, setCancelExportCbk));
+    Fake(Method(crvMock, setEvictedCount));
+    Fake(Method(crvMock, scrollToBottom));
+    Fake(Method(crvMock, setSorting));
+
+    CanRawView canRawView{ CanRawViewCtx(&crvMock.get()) };
+    QJsonObject config{ { "overloadRate", 500 } };
+    const int idCount = 4;
+    std::vector<quint32> sent;
+    std::vector<QByteArray> lastPayload(idCount);
+    quint32 n = 0;
+
+    canRawView.setConfig(config);
+    canRawView.startSimulation();
+    REQUIRE(tvModel != nullptr);
+    REQUIRE(statsModel != nullptr);
+
+    const auto send = [&] {
+        const int id = static_cast<int>(n % idCount);
+
+        lastPayload[id] = QByteArray(reinterpret_cast<const char*>(&n), sizeof(n));
+        canRawView.frameReceived(QCanBusFrame(static_cast<quint32>(0x100 + id), lastPayload[id]));
+        ++n;
+    };
+
+    // Well above overload rate for longer than the one second rate window
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < 1500) {
+        for (int i = 0; i < 50; ++i) {
+            send();
+        }
+        QTest::qWait(1);
+    }
+    QTest::qWait(100);
+
+    CHECK(elided > 0);
+    CHECK(static_cast<quint64>(tvModel->rowCount()) == n - elided);
+
+    // Statistics count every frame
+    statisticsCbk(true);
+    quint64 counted = 0;
+    REQUIRE(statsModel->rowCount() == idCount);
+    for (int row = 0; row < idCount; ++row) {
+        counted += statsModel->data(statsModel->index(row, FrameStatsModel::Count)).toULongLong();
+    }
+    CHECK(counted == n);
+
+    // Combined view shows the newest frame of each ID, stored or not
+    filterCbk();
+    REQUIRE(uniqueModel != nullptr);
+    REQUIRE(uniqueModel->rowCount() == idCount);
+    for (int row = 0; row < idCount; ++row) {
+        const int id = uniqueModel->data(uniqueModel->index(row, FrameModel::IdInt)).toInt() - 0x100;
+
+        REQUIRE(id >= 0);
+        REQUIRE(id < idCount);
+        CHECK(uniqueModel->data(uniqueModel->index(row, FrameModel::Data)).toString()
+            == HexFormat::bytesToString(lastPayload[id].constData(), lastPayload[id].size()));
+    }
+
+    // Below overload rate stride goes back to 1 after next rate window
+    for (int i = 0; i < 25; ++i) {
+        send();
+        QTest::qWait(100);
+    }
+
+    const quint64 elidedBefore = elided;
+    const int rowsBefore = tvModel->rowCount();
+
+    for (int i = 0; i < 20; ++i) {
+        send();
+    }
+    QTest::qWait(100);
+
+    CHECK(elided == elidedBefore);
+    CHECK(tvModel->rowCount() == rowsBefore + 20);
+}
+
+TEST_CASE("Failed export is reported", "[canrawview]")
+{
+    using namespace fakeit;
+    Mock<CRVGuiInterface> crvMock;
+    CRVGuiInterface::export_t exportCbk;
+    QString status;
+    int progress = -1;
+
+    Fake(Dtor(crvMock));
+    When(Method(crvMock, setExportCbk)).Do([&](auto&& fn) { exportCbk = fn; });
+    When(Method(crvMock, setExportProgress)).AlwaysDo([&](int percent) { progress = percent; });
+    When(Method(crvMock, setStatus)).AlwaysDo([&](const QString& text) { status = text; });
+    When(Method(crvMock, isVisible)).AlwaysReturn(true);
+    When(Method(crvMock, isViewFrozen)).AlwaysReturn(false);
+    Fake(Method(crvMock, initTableView));
+    Fake(Method(crvMock, initStatsView));
+    Fake(Method(crvMock, setClearCbk));
+    Fake(Method(crvMock, setDockUndockCbk));
+    Fake(Method(crvMock, setSectionClikedCbk));
+    Fake(Method(crvMock, setFilterCbk));
+    Fake(Method(crvMock, setShowCbk));
+    Fake(Method(crvMock, setSearchCbk));
+    Fake(Method(crvMock, setCancelExportCbk));
+    Fake(Method(crvMock, setStatisticsCbk));
+    Fake(Method(crvMock, setEvictedCount));
+    Fake(Method(crvMock, setElidedCount));
+    Fake(Method(crvMock, scrollToBottom));
+
+    CanRawView canRawView{ CanRawViewCtx(&crvMock.get()) };
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    REQUIRE(exportCbk);
+
+    canRawView.startSimulation();
+    for (int i = 0; i < 100; ++i) {
+        canRawView.frameReceived(QCanBusFrame(0x123, QByteArray::fromHex("0102")));
+    }
+    QTest::qWait(100);
+
+    const auto exportTo = [&](const QString& fileName) {
+        exportCbk(fileName);
+        CHECK(progress == 0);
+
+        for (int i = 0; (i < 100) && (progress != -1); ++i) {
+            QTest::qWait(20);
+        }
+    };
+
+    // Directory does not exist, so the file cannot be opened
+    exportTo(dir.path() + "/missing/frames.log");
+    CHECK(progress == -1);
+    CHECK(status == "Export failed, file could not be written");
+
+    // Failure is not shown once next export succeeds
+    exportTo(dir.path() + "/frames.log");
+    CHECK(progress == -1);
+    CHECK(status.isEmpty());
+    CHECK(QFile::exists(dir.path() + "/frames.log"));
 }
 
 int main(int argc, char* argv[])
@@ -0,0 +1,175 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
+#include <QtSerialBus/QCanBusFrame>
+#include <canrecorder.h>
+#include <recorderwriter.h>
+#include <recordformat.h>
+#define CATCH_CONFIG_RUNNER
+#include <fakeit.hpp>
+#include <log.h>
+#include <vector>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+namespace {
+QByteArray readFile(const QString& fileName)
+{
+    QFile file(fileName);
+
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+}
+
+TEST_CASE("Candump format", "[recordformat]")
+{
+    QByteArray out;
+
+    RecordFormat::append(out, RecordFormat::Format::Candump, 1500000000123456ull, "can0",
+        QCanBusFrame(0x123, QByteArray::fromHex("deadbeef")), false);
+    CHECK(out == "(1500000000.123456) can0 123#DEADBEEF\n");
+
+    out.clear();
+    RecordFormat::append(out, RecordFormat::Format::Candump, 7, "vcan1",
+        QCanBusFrame(0x1abcdef, QByteArray::fromHex("00")), false);
+    CHECK(out == "(0000000000.000007) vcan1 01ABCDEF#00\n");
+
+    out.clear();
+    QCanBusFrame remote(0x7ff, QByteArray());
+    remote.setFrameType(QCanBusFrame::RemoteRequestFrame);
+    RecordFormat::append(out, RecordFormat::Format::Candump, 0, "can0", remote, false);
+    CHECK(out == "(0000000000.000000) can0 7FF#R\n");
+}
+
+TEST_CASE("Binary format", "[recordformat]")
+{
+    QByteArray out = RecordFormat::fileHeader(RecordFormat::Format::Binary);
+
+    REQUIRE(out.size() == 12);
+    CHECK(out.left(4) == "CDSR");
+
+    RecordFormat::append(
+        out, RecordFormat::Format::Binary, 0x0102030405060708ull, "can0", QCanBusFrame(0x123, "ab"), true);
+    CHECK(out.mid(12) == QByteArray::fromHex("0807060504030201" "23010040" "02" "6162"));
+    CHECK(RecordFormat::fileHeader(RecordFormat::Format::Candump).isEmpty());
+}
+
+TEST_CASE("Writer rotates files by size", "[recorderwriter]")
+{
+    QTemporaryDir dir;
+    QByteArray buffer;
+    RecorderWriter writer(dir.path() + "/capture.log", "H", 10, 0);
+
+    writer.start();
+
+    for (int i = 0; i < 3; ++i) {
+        buffer = QByteArray(6, static_cast<char>('a' + i));
+
+        while (!writer.trySubmit(buffer, 1)) {
+            QThread::msleep(1);
+        }
+
+        CHECK(buffer.isEmpty());
+    }
+
+    writer.finish(buffer, 0);
+
+    CHECK(writer.bytesWritten() == 18);
+    CHECK(writer.framesWritten() == 3);
+    CHECK(writer.hasError() == false);
+    CHECK(readFile(dir.path() + "/capture_0000.log") == "Haaaaaa");
+    CHECK(readFile(dir.path() + "/capture_0001.log") == "Hbbbbbb");
+    CHECK(readFile(dir.path() + "/capture_0002.log") == "Hcccccc");
+}
+
+TEST_CASE("Writer hands back written buffers", "[recorderwriter]")
+{
+    QTemporaryDir dir;
+    RecorderWriter writer(dir.path() + "/capture.log", QByteArray(), 0, 0);
+    std::vector<QByteArray> buffers(3);
+
+    writer.start();
+
+    for (auto& buffer : buffers) {
+        buffer.reserve(4096);
+        buffer.append("data");
+
+        while (!writer.trySubmit(buffer, 1)) {
+            QThread::msleep(1);
+        }
+    }
+
+    // Third submit gets the first buffer back
+    CHECK(buffers[2].isEmpty());
+    CHECK(buffers[2].capacity() >= 4096);
+
+    writer.finish(buffers[2], 0);
+    CHECK(writer.framesWritten() == 3);
+    CHECK(readFile(dir.path() + "/capture.log") == "datadatadata");
+}
+
+TEST_CASE("Writer stops after open failure", "[recorderwriter]")
+{
+    QTemporaryDir dir;
+    RecorderWriter writer(dir.path() + "/missing/capture.log", QByteArray(), 10, 0);
+    QByteArray buffer;
+
+    writer.start();
+
+    for (int i = 0; i < 3; ++i) {
+        buffer = "data";
+
+        while (!writer.trySubmit(buffer, 2)) {
+            QThread::msleep(1);
+        }
+    }
+
+    writer.finish(buffer, 0);
+
+    CHECK(writer.hasError());
+    CHECK(writer.framesWritten() == 0);
+    CHECK(writer.framesLost() == 6);
+    CHECK(QDir(dir.path()).entryList(QDir::Files | QDir::NoDotAndDotDot).isEmpty());
+}
+
+TEST_CASE("Frames are recorded during simulation", "[canrecorder]")
+{
+    QTemporaryDir dir;
+    CanRecorder canRecorder;
+    QJsonObject config{ { "fileName", dir.path() + "/rec" }, { "format", "candump" }, { "interface", "can1" } };
+
+    canRecorder.setConfig(config);
+    CHECK(canRecorder.getConfig()["interface"].toString() == "can1");
+
+    canRecorder.frameReceived(QCanBusFrame(0x100, QByteArray()));
+    CHECK(canRecorder.isRecording() == false);
+
+    canRecorder.startSimulation();
+    CHECK(canRecorder.isRecording());
+    canRecorder.frameReceived(QCanBusFrame(0x123, QByteArray::fromHex("01")));
+    canRecorder.frameSent(false, QCanBusFrame(0x456, QByteArray::fromHex("02")));
+    canRecorder.frameSent(true, QCanBusFrame(0x789, QByteArray::fromHex("03")));
+    canRecorder.stopSimulation();
+
+    // Frames are counted once written
+    CHECK(canRecorder.recordedCount() == 2);
+    CHECK(canRecorder.droppedCount() == 0);
+    CHECK(canRecorder.hasError() == false);
+
+    const QList<QByteArray> lines = readFile(dir.path() + "/rec.log").split('\n');
+    REQUIRE(lines.size() == 3);
+    CHECK(lines[0].endsWith(" can1 123#01"));
+    CHECK(lines[1].endsWith(" can1 789#03"));
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QCoreApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
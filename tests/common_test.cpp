@@ -1,5 +1,6 @@
 
 #include "enumiterator.h"
+#include "hexformat.h"
 
 #define CATCH_CONFIG_RUNNER
 #include <fakeit.hpp>
@@ -274,6 +275,44 @@ TEST_CASE("EnumIterator no-past-the-end", "[common]")
     I2 it2;
 }
 */
+
+TEST_CASE("HexFormat payload", "[common]")
+{
+    const char payload[] = { 0x00, 0x11, static_cast<char>(0xff), 0x0a };
+    char buffer[16];
+
+    CHECK(HexFormat::bytesToString(payload, 3) == "00 11 ff");
+    CHECK(HexFormat::bytesToString(payload, 1) == "00");
+    CHECK(HexFormat::bytesToString(payload, 0).isEmpty());
+
+    CHECK(HexFormat::writeBytes(buffer, payload, 4, 0, true) - buffer == HexFormat::bytesSize(4, false));
+    CHECK(QByteArray(buffer, 8) == "0011FF0A");
+
+    QByteArray fd;
+    for (int i = 0; i < 100; ++i) {
+        fd.append(static_cast<char>(i));
+    }
+
+    const QString text = HexFormat::bytesToString(fd.constData(), fd.size());
+    CHECK(text.size() == HexFormat::bytesSize(fd.size(), true));
+    CHECK(text.endsWith("62 63"));
+}
+
+TEST_CASE("HexFormat ID", "[common]")
+{
+    char buffer[8];
+
+    CHECK(HexFormat::idToString(0) == "0x0");
+    CHECK(HexFormat::idToString(0x1ab) == "0x1ab");
+    CHECK(HexFormat::idToString(0x18fe0001) == "0x18fe0001");
+    CHECK(HexFormat::idToString(0xffffffff) == "0xffffffff");
+
+    CHECK(HexFormat::writeHex(buffer, 0x1ab, 3, true) == buffer + 3);
+    CHECK(QByteArray(buffer, 3) == "1AB");
+    CHECK(HexFormat::writeHex(buffer, 0x12345, 3) == buffer + 3);
+    CHECK(QByteArray(buffer, 3) == "345");
+}
+
 int main(int argc, char* argv[])
 {
     return Catch::Session().run(argc, argv);
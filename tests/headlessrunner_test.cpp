@@ -0,0 +1,119 @@
+#include <QtCore/QTemporaryDir>
+#include <QtSerialBus/QCanBusFrame>
+#include <QtTest/QSignalSpy>
+#include <QtWidgets/QApplication>
+#include <headlessrunner.h>
+#define CATCH_CONFIG_RUNNER
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+namespace {
+void writeFile(const QString& fileName, const QByteArray& content)
+{
+    QFile file(fileName);
+
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(content);
+}
+}
+
+TEST_CASE("candump log lines are parsed", "[headless]")
+{
+    QCanBusFrame frame;
+    double timestamp = 0;
+
+    REQUIRE(HeadlessRunner::parseLogLine("(1436509052.249713) can0 123#DEADBEEF", frame, timestamp));
+    CHECK(timestamp == Approx(1436509052.249713));
+    CHECK(frame.frameId() == 0x123);
+    CHECK(frame.hasExtendedFrameFormat() == false);
+    CHECK(frame.frameType() == QCanBusFrame::DataFrame);
+    CHECK(frame.payload() == QByteArray::fromHex("deadbeef"));
+
+    REQUIRE(HeadlessRunner::parseLogLine("(1.5) can0 18FE0001#0102", frame, timestamp));
+    CHECK(frame.frameId() == 0x18fe0001);
+    CHECK(frame.hasExtendedFrameFormat());
+    CHECK(frame.payload() == QByteArray::fromHex("0102"));
+
+    REQUIRE(HeadlessRunner::parseLogLine("(2.0) can0 7FF#R", frame, timestamp));
+    CHECK(frame.frameId() == 0x7ff);
+    CHECK(frame.frameType() == QCanBusFrame::RemoteRequestFrame);
+    CHECK(frame.payload().isEmpty());
+    CHECK(HeadlessRunner::parseLogLine("(2.0) can0 7FF#R4", frame, timestamp));
+
+    REQUIRE(HeadlessRunner::parseLogLine("(3.0) can0 100##1" + QByteArray(64, 'a').toUpper(), frame, timestamp));
+    CHECK(frame.frameId() == 0x100);
+    CHECK(frame.payload() == QByteArray(32, static_cast<char>(0xaa)));
+
+    REQUIRE(HeadlessRunner::parseLogLine("(4.0) can0 100#", frame, timestamp));
+    CHECK(frame.payload().isEmpty());
+
+    CHECK(HeadlessRunner::parseLogLine("garbage", frame, timestamp) == false);
+    CHECK(HeadlessRunner::parseLogLine("(1.0) can0 123", frame, timestamp) == false);
+    CHECK(HeadlessRunner::parseLogLine("(x) can0 123#00", frame, timestamp) == false);
+    CHECK(HeadlessRunner::parseLogLine("(1.0) can0 XYZ#00", frame, timestamp) == false);
+    CHECK(HeadlessRunner::parseLogLine("(1.0) can0 800#00", frame, timestamp) == false);
+    CHECK(HeadlessRunner::parseLogLine("(1.0) can0 123#0", frame, timestamp) == false);
+    CHECK(HeadlessRunner::parseLogLine("(1.0) can0 123#GG", frame, timestamp) == false);
+    CHECK(HeadlessRunner::parseLogLine("(1.0) can0 123#001122334455667788", frame, timestamp) == false);
+    CHECK(HeadlessRunner::parseLogLine("(1.0) can0 123##", frame, timestamp) == false);
+    CHECK(HeadlessRunner::parseLogLine("(1.0) can0 123#R9", frame, timestamp) == false);
+}
+
+TEST_CASE("Project is run with replayed log", "[headless]")
+{
+    QTemporaryDir dir;
+    const QString projectFile = dir.filePath("project.cds");
+    const QString logFile = dir.filePath("replay.log");
+
+    writeFile(projectFile,
+        "{\"nodes\":[{\"id\":\"{8b1a9953-c461-4c9f-bf7a-6f1a8d7c8a11}\",\"model\":{\"name\":\"CanDeviceModel\"},"
+        "\"position\":{\"x\":0,\"y\":0}}],\"connections\":[]}");
+    writeFile(logFile,
+        "(0.000100) can0 123#DEADBEEF\n"
+        "(0.000200) can0 18FE0001#0102\n"
+        "\n"
+        "(0.000300) can0 7FF#R\n"
+        "not a frame\n"
+        "(0.000400) can0 100##1000102030405060708090A0B0C0D0E0F\n"
+        "(0.000500) can0 123#XYZ\n");
+
+    HeadlessRunner runner;
+    QSignalSpy finishedSpy(&runner, &HeadlessRunner::finished);
+
+    REQUIRE(runner.loadProject(projectFile));
+    REQUIRE(runner.setReplay(logFile, false));
+    runner.start(0);
+
+    REQUIRE((finishedSpy.count() > 0 || finishedSpy.wait(5000)));
+    CHECK(runner.framesReplayed() == 4);
+    CHECK(runner.framesOut() == 4);
+    CHECK(runner.malformedLines() == 2);
+}
+
+TEST_CASE("Missing files are reported", "[headless]")
+{
+    QTemporaryDir dir;
+    HeadlessRunner runner;
+
+    CHECK(runner.loadProject(dir.filePath("missing.cds")) == false);
+    CHECK(runner.setReplay(dir.filePath("missing.log"), false) == false);
+}
+
+int main(int argc, char* argv[])
+{
+    // Project configuration uses QtWidgets. Offscreen platform lets tests run without display.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
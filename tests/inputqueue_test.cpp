@@ -0,0 +1,168 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+#include <nodes/NodeData>
+#include <projectconfig/inputqueue.h>
+#define CATCH_CONFIG_RUNNER
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+namespace {
+struct TestData : public QtNodes::NodeData {
+    TestData(int value)
+        : value(value)
+    {
+    }
+
+    QtNodes::NodeDataType type() const override
+    {
+        return { "test", "test" };
+    }
+
+    int value;
+};
+
+// Consumer exceeding its time budget on first delivery, so following data is queued
+struct SlowConsumer {
+    void operator()(const std::shared_ptr<QtNodes::NodeData>& data)
+    {
+        if (received.empty()) {
+            QThread::msleep(30);
+        }
+
+        received.push_back(std::static_pointer_cast<TestData>(data)->value);
+    }
+
+    std::vector<int>& received;
+};
+
+void pushRange(InputQueue& queue, int from, int to)
+{
+    for (int i = from; i < to; ++i) {
+        queue.push(std::make_shared<TestData>(i));
+    }
+}
+}
+
+TEST_CASE("Data is delivered synchronously while consumer is within budget", "[inputqueue]")
+{
+    std::vector<int> received;
+    InputQueue queue([&received](const std::shared_ptr<QtNodes::NodeData>& data) {
+        received.push_back(std::static_pointer_cast<TestData>(data)->value);
+    });
+
+    pushRange(queue, 0, 10);
+
+    CHECK(received.size() == 10);
+    CHECK(queue.depth() == 0);
+    CHECK(queue.highWaterMark() == 0);
+    CHECK(queue.dropped() == 0);
+}
+
+TEST_CASE("Drop oldest keeps newest data", "[inputqueue]")
+{
+    std::vector<int> received;
+    InputQueue queue(SlowConsumer{ received });
+
+    queue.setCapacity(5);
+    queue.setPolicy(InputQueue::Policy::DropOldest);
+    pushRange(queue, 0, 11);
+
+    CHECK(received.size() == 1);
+    CHECK(queue.depth() == 5);
+    CHECK(queue.highWaterMark() == 5);
+    CHECK(queue.dropped() == 5);
+
+    QTest::qWait(100);
+
+    CHECK(received == std::vector<int>({ 0, 6, 7, 8, 9, 10 }));
+    CHECK(queue.depth() == 0);
+}
+
+TEST_CASE("Drop newest keeps oldest data", "[inputqueue]")
+{
+    std::vector<int> received;
+    InputQueue queue(SlowConsumer{ received });
+
+    queue.setCapacity(5);
+    queue.setPolicy(InputQueue::Policy::DropNewest);
+    pushRange(queue, 0, 11);
+
+    CHECK(queue.dropped() == 5);
+
+    QTest::qWait(100);
+
+    CHECK(received == std::vector<int>({ 0, 1, 2, 3, 4, 5 }));
+}
+
+TEST_CASE("Sample every N admits one of N items when full", "[inputqueue]")
+{
+    std::vector<int> received;
+    InputQueue queue(SlowConsumer{ received });
+
+    queue.setCapacity(2);
+    queue.setPolicy(InputQueue::Policy::SampleEveryN);
+    queue.setSampleN(3);
+    pushRange(queue, 0, 9);
+
+    CHECK(queue.dropped() == 6);
+
+    QTest::qWait(100);
+
+    CHECK(received == std::vector<int>({ 0, 5, 8 }));
+}
+
+TEST_CASE("Lossless queue grows instead of dropping", "[inputqueue]")
+{
+    std::vector<int> received;
+    InputQueue queue(SlowConsumer{ received }, InputQueue::Delivery::Lossless);
+
+    queue.setCapacity(2);
+    pushRange(queue, 0, 20);
+
+    CHECK(queue.depth() == 19);
+    CHECK(queue.dropped() == 0);
+
+    QTest::qWait(100);
+
+    CHECK(received.size() == 20);
+    CHECK(queue.depth() == 0);
+}
+
+TEST_CASE("Immediate delivery ignores time budget", "[inputqueue]")
+{
+    std::vector<int> received;
+    InputQueue queue(SlowConsumer{ received }, InputQueue::Delivery::Immediate);
+
+    queue.setCapacity(2);
+    pushRange(queue, 0, 20);
+
+    CHECK(received.size() == 20);
+    CHECK(queue.depth() == 0);
+    CHECK(queue.dropped() == 0);
+}
+
+TEST_CASE("Policy names", "[inputqueue]")
+{
+    using Policy = InputQueue::Policy;
+
+    for (auto policy : { Policy::DropOldest, Policy::DropNewest, Policy::SampleEveryN }) {
+        CHECK(InputQueue::policyFromString(InputQueue::policyToString(policy)) == policy);
+    }
+
+    CHECK(InputQueue::policyFromString("unknown") == Policy::DropOldest);
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QCoreApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,442 @@
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QTableView>
+#include <algorithm>
+#include <atomic>
+#include <candeviceinterface.h>
+#include <context.h>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <log.h>
+#include <new>
+#include <nodes/FlowScene>
+#include <nodes/Node>
+#include <projectconfig/candevicemodel.h>
+#include <projectconfig/canrawviewmodel.h>
+#include <vector>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+namespace {
+std::atomic<quint64> allocations{ 0 };
+}
+
+// Every heap allocation made by the process is counted
+void* operator new(std::size_t size)
+{
+    ++allocations;
+
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+// Latency histogram resolution and range. Frames slower than the range land in the last bucket.
+constexpr qint64 kLatencyBucketNs = 1000;
+constexpr std::size_t kLatencyBuckets = 100000;
+// Generation times are kept for this many frames in flight
+constexpr quint64 kInFlightMask = (1 << 20) - 1;
+// Max number of frames generated in one event loop iteration
+constexpr qint64 kMaxBurst = 1000;
+// Time given to the pipeline to process queued frames after generation stops
+constexpr int kDrainTimeoutMs = 2000;
+
+/**
+*   @brief Fake CAN backend generating frames at given rate. Sequence number of each frame is stored in its timestamp.
+*/
+struct FakeCanDevice : public CanDeviceInterface {
+    FakeCanDevice(int idCount, int payloadSize)
+        : sentNs(kInFlightMask + 1, 0)
+    {
+        for (int i = 0; i < idCount; ++i) {
+            QByteArray payload(payloadSize, '\0');
+
+            for (int j = 0; j < payloadSize; ++j) {
+                payload[j] = static_cast<char>(i + j);
+            }
+
+            templates.push_back(QCanBusFrame(0x100 + i, payload));
+        }
+
+        clock.start();
+    }
+
+    void setFramesWrittenCbk(const framesWritten_t&) override
+    {
+    }
+
+    void setFramesReceivedCbk(const framesReceived_t& cb) override
+    {
+        framesReceivedCbk = cb;
+    }
+
+    void setErrorOccurredCbk(const errorOccurred_t&) override
+    {
+    }
+
+    bool init(const QString&, const QString&) override
+    {
+        return true;
+    }
+
+    bool writeFrame(const QCanBusFrame&) override
+    {
+        return true;
+    }
+
+    bool connectDevice() override
+    {
+        return true;
+    }
+
+    void disconnectDevice() override
+    {
+    }
+
+    qint64 framesAvailable() override
+    {
+        return pending;
+    }
+
+    QCanBusFrame readFrame() override
+    {
+        QCanBusFrame frame = templates[read % templates.size()];
+
+        frame.setTimeStamp(QCanBusFrame::TimeStamp(static_cast<qint64>(read), 0));
+        ++read;
+        --pending;
+
+        return frame;
+    }
+
+    /**
+    *   @brief  Makes frames available and notifies CanDevice, the same way QCanBusDevice does
+    *   @param  count number of frames
+    */
+    void generate(qint64 count)
+    {
+        const qint64 now = clock.nsecsElapsed();
+
+        for (qint64 i = 0; i < count; ++i) {
+            sentNs[(generated + i) & kInFlightMask] = now;
+        }
+
+        generated += count;
+        pending += count;
+
+        if (framesReceivedCbk) {
+            framesReceivedCbk();
+        }
+    }
+
+    std::vector<QCanBusFrame> templates;
+    std::vector<qint64> sentNs;
+    framesReceived_t framesReceivedCbk;
+    QElapsedTimer clock;
+    quint64 generated{ 0 };
+    quint64 read{ 0 };
+    qint64 pending{ 0 };
+};
+
+struct Settings {
+    int rate;
+    int payloadSize;
+    int idCount;
+    int durationMs;
+    int warmupMs;
+};
+
+/**
+*   @brief Runs CanDevice -> CanDeviceModel -> CanRawViewModel -> CanRawView pipeline and collects statistics.
+*          Statistics are collected after warmup only.
+*
+*   The view is shown, so frames are committed and presented as in the application. Latency of a frame is measured
+*   from its generation until its row is inserted into the table of the view, i.e. until the table is notified.
+*   Painting that follows in the event loop is not included. Rows are expected in order of arrival, so the view must
+*   stay sorted by row ID.
+*/
+class PipelineBenchmark {
+public:
+    PipelineBenchmark(const Settings& settings)
+        : _settings(settings)
+        , _device(new FakeCanDevice(settings.idCount, settings.payloadSize))
+        , _latencyHist(kLatencyBuckets, 0)
+    {
+        auto& deviceNode = _scene.createNode(std::make_unique<CanDeviceModel>(CanDeviceCtx(_device)));
+        auto& viewNode = _scene.createNode(std::make_unique<CanRawViewModel>());
+
+        _scene.createConnection(viewNode, 0, deviceNode, 0);
+
+        auto viewModel = static_cast<CanRawViewModel*>(viewNode.nodeDataModel());
+        QWidget* view = viewModel->getComponent().getMainWidget();
+        auto table = view->findChild<QTableView*>("tv");
+
+        view->show();
+
+        // Connected after component, so frame has been stored by CanRawView when this is called
+        QObject::connect(viewModel, &CanRawViewModel::frameReceived, [this](const QCanBusFrame& frame) {
+            _stored.push_back(static_cast<quint64>(frame.timeStamp().seconds()));
+        });
+        QObject::connect(table->model(), &QAbstractItemModel::rowsInserted,
+            [this](const QModelIndex&, int first, int last) { inserted(last - first + 1); });
+
+        _models = { deviceNode.nodeDataModel(), viewNode.nodeDataModel() };
+
+        _generateTimer.setTimerType(Qt::PreciseTimer);
+        _generateTimer.setInterval(settings.rate > 0 ? 1 : 0);
+        QObject::connect(&_generateTimer, &QTimer::timeout, [this] { generate(); });
+    }
+
+    void start()
+    {
+        for (auto model : _models) {
+            dynamic_cast<ComponentModelInterface*>(model)->getComponent().startSimulation();
+        }
+
+        _runTimer.start();
+        _generateTimer.start();
+
+        QTimer::singleShot(_settings.warmupMs, [this] { startMeasurement(); });
+        QTimer::singleShot(_settings.warmupMs + _settings.durationMs, [this] { stopGeneration(); });
+    }
+
+    QJsonObject results() const
+    {
+        const double seconds = _measureNs / 1e9;
+        const double frames = static_cast<double>(std::max<quint64>(_measuredFrames, 1));
+
+        return { { "rate", _settings.rate }, { "payloadSize", _settings.payloadSize }, { "ids", _settings.idCount },
+            { "durationMs", _settings.durationMs }, { "framesGenerated", static_cast<double>(_generatedInWindow) },
+            { "framesDelivered", static_cast<double>(_measuredFrames) },
+            { "framesLost", static_cast<double>(_generatedInWindow - std::min(_generatedInWindow, _measuredFrames)) },
+            { "framesPerSecond", seconds > 0 ? _measuredFrames / seconds : 0.0 },
+            { "cpuNsPerFrame", _cpuNs / frames }, { "allocationsPerFrame", _allocations / frames },
+            { "latencyNs",
+                QJsonObject{ { "p50", latencyPercentile(0.5) }, { "p90", latencyPercentile(0.9) },
+                    { "p99", latencyPercentile(0.99) }, { "p999", latencyPercentile(0.999) },
+                    { "max", static_cast<double>(_latencyMaxNs) } } } };
+    }
+
+    std::function<void()> finished;
+
+private:
+    void generate()
+    {
+        qint64 count = kMaxBurst;
+
+        if (_settings.rate > 0) {
+            const qint64 due = _runTimer.nsecsElapsed() * _settings.rate / 1000000000;
+            count = std::min(due - static_cast<qint64>(_device->generated), kMaxBurst);
+        }
+
+        if (count > 0) {
+            _device->generate(count);
+        }
+    }
+
+    void inserted(int rows)
+    {
+        const qint64 now = _device->clock.nsecsElapsed();
+
+        for (int i = 0; (i < rows) && !_stored.empty(); ++i) {
+            const quint64 seq = _stored.front();
+
+            _stored.pop_front();
+
+            if (!_measuring || (seq < _firstMeasuredSeq)) {
+                continue;
+            }
+
+            const qint64 latency = now - _device->sentNs[seq & kInFlightMask];
+            const std::size_t bucket = std::min<std::size_t>(latency / kLatencyBucketNs, kLatencyBuckets - 1);
+
+            ++_latencyHist[bucket];
+            _latencyMaxNs = std::max(_latencyMaxNs, latency);
+            ++_measuredFrames;
+        }
+
+        if (_draining && (_measuredFrames >= _generatedInWindow)) {
+            finish();
+        }
+    }
+
+    void startMeasurement()
+    {
+        _measuring = true;
+        _firstMeasuredSeq = _device->generated;
+        _allocationsStart = allocations;
+        _cpuStart = std::clock();
+        _measureTimer.start();
+    }
+
+    void stopGeneration()
+    {
+        _generateTimer.stop();
+        _generatedInWindow = _device->generated - _firstMeasuredSeq;
+        _draining = true;
+
+        if (_measuredFrames >= _generatedInWindow) {
+            finish();
+        } else {
+            // Frames dropped by input queue never get a row
+            QTimer::singleShot(kDrainTimeoutMs, [this] { finish(); });
+        }
+    }
+
+    void finish()
+    {
+        if (!_measuring) {
+            return;
+        }
+
+        _measuring = false;
+        _measureNs = _measureTimer.nsecsElapsed();
+        _cpuNs = static_cast<double>(std::clock() - _cpuStart) * 1e9 / CLOCKS_PER_SEC;
+        _allocations = static_cast<double>(allocations - _allocationsStart);
+
+        for (auto model : _models) {
+            dynamic_cast<ComponentModelInterface*>(model)->getComponent().stopSimulation();
+        }
+
+        if (finished) {
+            finished();
+        }
+    }
+
+    double latencyPercentile(double percentile) const
+    {
+        const quint64 threshold = static_cast<quint64>(_measuredFrames * percentile);
+        quint64 count = 0;
+
+        for (std::size_t i = 0; i < _latencyHist.size(); ++i) {
+            count += _latencyHist[i];
+
+            if (count > threshold) {
+                return static_cast<double>(i * kLatencyBucketNs);
+            }
+        }
+
+        return static_cast<double>(_latencyMaxNs);
+    }
+
+    Settings _settings;
+    QtNodes::FlowScene _scene;
+    FakeCanDevice* _device; // owned by CanDevice context
+    std::vector<QtNodes::NodeDataModel*> _models;
+    QTimer _generateTimer;
+    QElapsedTimer _runTimer;
+    QElapsedTimer _measureTimer;
+    bool _measuring{ false };
+    bool _draining{ false };
+    quint64 _firstMeasuredSeq{ 0 };
+    quint64 _generatedInWindow{ 0 };
+    quint64 _measuredFrames{ 0 };
+    quint64 _allocationsStart{ 0 };
+    std::clock_t _cpuStart{ 0 };
+    qint64 _measureNs{ 0 };
+    double _cpuNs{ 0 };
+    double _allocations{ 0 };
+    qint64 _latencyMaxNs{ 0 };
+    std::vector<quint64> _latencyHist;
+    std::deque<quint64> _stored; // sequence numbers of frames stored by the view and waiting for their rows
+};
+
+void printResults(const QJsonObject& results)
+{
+    const QJsonObject latency = results["latencyNs"].toObject();
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Frames generated:   " << results["framesGenerated"].toDouble() << std::endl;
+    std::cout << "Frames delivered:   " << results["framesDelivered"].toDouble() << std::endl;
+    std::cout << "Frames lost:        " << results["framesLost"].toDouble() << std::endl;
+    std::cout << "Throughput:         " << results["framesPerSecond"].toDouble() << " frames/s" << std::endl;
+    std::cout << "CPU per frame:      " << results["cpuNsPerFrame"].toDouble() << " ns" << std::endl;
+    std::cout << "Allocations/frame:  " << results["allocationsPerFrame"].toDouble() << std::endl;
+    std::cout << "Latency p50/p90/p99/p99.9/max: " << latency["p50"].toDouble() / 1000 << " / "
+              << latency["p90"].toDouble() / 1000 << " / " << latency["p99"].toDouble() / 1000 << " / "
+              << latency["p999"].toDouble() / 1000 << " / " << latency["max"].toDouble() / 1000 << " us" << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    // Components still use QtWidgets internally. Offscreen platform lets us run without display.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication a(argc, argv);
+    QCoreApplication::setApplicationName("pipeline_benchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures CanDevice -> CanRawView pipeline with a fake CAN backend");
+    parser.addHelpOption();
+
+    QCommandLineOption rateOpt(QStringList() << "r" << "rate", "Frames per second, 0 for maximum.", "fps", "10000");
+    QCommandLineOption payloadOpt(QStringList() << "p" << "payload", "Payload size (0-8).", "bytes", "8");
+    QCommandLineOption idsOpt(QStringList() << "i" << "ids", "Number of distinct frame IDs.", "count", "100");
+    QCommandLineOption durationOpt(QStringList() << "d" << "duration", "Measurement duration in ms.", "ms", "5000");
+    QCommandLineOption warmupOpt(QStringList() << "w" << "warmup", "Warmup duration in ms.", "ms", "500");
+    QCommandLineOption jsonOpt(QStringList() << "j" << "json", "Writes results as JSON, '-' for stdout.", "file");
+    parser.addOption(rateOpt);
+    parser.addOption(payloadOpt);
+    parser.addOption(idsOpt);
+    parser.addOption(durationOpt);
+    parser.addOption(warmupOpt);
+    parser.addOption(jsonOpt);
+    parser.process(a);
+
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    kDefaultLogger->set_level(spdlog::level::warn);
+
+    const Settings settings{ std::max(parser.value(rateOpt).toInt(), 0),
+        qBound(0, parser.value(payloadOpt).toInt(), 8), std::max(parser.value(idsOpt).toInt(), 1),
+        std::max(parser.value(durationOpt).toInt(), 1), std::max(parser.value(warmupOpt).toInt(), 0) };
+
+    PipelineBenchmark benchmark(settings);
+    benchmark.finished = [&a] { QMetaObject::invokeMethod(&a, "quit", Qt::QueuedConnection); };
+    benchmark.start();
+    a.exec();
+
+    const QJsonObject results = benchmark.results();
+
+    if (!parser.isSet(jsonOpt)) {
+        printResults(results);
+    } else if (parser.value(jsonOpt) == "-") {
+        std::cout << QJsonDocument(results).toJson().toStdString();
+    } else {
+        QFile file(parser.value(jsonOpt));
+
+        if (!file.open(QIODevice::WriteOnly)) {
+            cds_error("Could not open file '{}'", parser.value(jsonOpt).toStdString());
+            return 1;
+        }
+
+        file.write(QJsonDocument(results).toJson());
+        printResults(results);
+    }
+
+    return 0;
+}
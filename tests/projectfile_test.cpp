@@ -0,0 +1,91 @@
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
+#include <QtCore/QTemporaryDir>
+#include <projectconfig/projectfile.h>
+#define CATCH_CONFIG_RUNNER
+#include <fakeit.hpp>
+#include <log.h>
+
+std::shared_ptr<spdlog::logger> kDefaultLogger;
+
+TEST_CASE("Sections are written and read back", "[projectfile]")
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.path() + "/test.cds";
+    const QByteArray graph = "{\"nodes\":[]}";
+    const QByteArray data(12345, 'x');
+
+    REQUIRE(ProjectFile::write(fileName, { { "graph", graph }, { "data/123", data } }));
+    CHECK(ProjectFile::isProjectFile(fileName));
+
+    ProjectFile projectFile;
+    REQUIRE(projectFile.open(fileName));
+    CHECK(projectFile.hasSection("graph"));
+    CHECK(projectFile.hasSection("data/123"));
+    CHECK(projectFile.hasSection("data/456") == false);
+    CHECK(projectFile.section("graph") == graph);
+    CHECK(projectFile.section("data/123") == data);
+    CHECK(projectFile.section("data/456").isEmpty());
+}
+
+TEST_CASE("Empty container", "[projectfile]")
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.path() + "/empty.cds";
+
+    REQUIRE(ProjectFile::write(fileName, {}));
+
+    ProjectFile projectFile;
+    REQUIRE(projectFile.open(fileName));
+    CHECK(projectFile.hasSection("graph") == false);
+}
+
+TEST_CASE("JSON project is not recognized as container", "[projectfile]")
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.path() + "/legacy.cds";
+    QFile file(fileName);
+
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write("{\"nodes\":[],\"connections\":[]}");
+    file.close();
+
+    CHECK(ProjectFile::isProjectFile(fileName) == false);
+    CHECK(ProjectFile::isProjectFile(dir.path() + "/missing.cds") == false);
+
+    ProjectFile projectFile;
+    CHECK(projectFile.open(fileName) == false);
+}
+
+TEST_CASE("Section outside of file is rejected", "[projectfile]")
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.path() + "/corrupted.cds";
+
+    // Offset + size wraps around to a small value
+    for (const quint64 offset : { Q_UINT64_C(0xffffffffffffffff), Q_UINT64_C(0xfffffffffffffff8) }) {
+        QFile file(fileName);
+        REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+
+        QDataStream out(&file);
+        out << quint32(0x43445350) << quint32(1) << quint32(1) << QString("graph") << offset << quint64(16);
+        out.writeRawData(QByteArray(64, '\0').constData(), 64);
+        file.close();
+
+        ProjectFile projectFile;
+        CHECK(projectFile.open(fileName) == false);
+        CHECK(projectFile.section("graph").isEmpty());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bool haveDebug = std::getenv("CDS_DEBUG") != nullptr;
+    kDefaultLogger = spdlog::stdout_color_mt("cds");
+    if (haveDebug) {
+        kDefaultLogger->set_level(spdlog::level::debug);
+    }
+    cds_debug("Staring unit tests");
+    QCoreApplication a(argc, argv);
+    return Catch::Session().run(argc, argv);
+}